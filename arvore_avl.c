@@ -1,39 +1,95 @@
-#include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
 #include "arvore_avl.h"
+#include "tarefas.h"
+#include "estatisticas.h"
 
 /*
 Criação de nó
-Parâmetro: recebe a chave que estara no nó
-Funcionamento: aloca espaço para o conteudo do nó e os inicializa caso o nó seja de fato criado
+Parâmetro: recebe a árvore dona do nó e a chave que estara no nó
+Funcionamento: reaproveita um nó da lista de livres da árvore; se ela estiver vazia, pega o próximo nó nunca usado do slab atual,
+alocando um slab novo (NOS_POR_SLAB nós em um único malloc) quando o atual estiver cheio. Inicializa o nó caso ele seja de fato obtido
 */
 
-NO *criar_no(int chave)
+static NO *criar_no(ArvoreAVL *arv, int chave)
 {
-    NO *no = (NO *)malloc(sizeof(NO));
-    if (no)
+    NO *no;
+    if (arv->livres)
     {
-        no->direita = no->esquerda = NULL;
-        no->altura = 0;
-        no->chave = chave;
+        no = arv->livres; // a lista de livres é encadeada pelo ponteiro direita
+        arv->livres = no->direita;
+        arv->ocupacao.livres--;
     }
+    else
+    {
+        if (!arv->slabs || arv->slabs->usados == NOS_POR_SLAB)
+        {
+            SLAB *slab = (SLAB *)malloc(sizeof(SLAB));
+            if (!slab)
+                return NULL;
+            slab->usados = 0;
+            slab->proximo = arv->slabs;
+            arv->slabs = slab;
+            arv->ocupacao.slabs++;
+            arv->ocupacao.capacidade += NOS_POR_SLAB;
+        }
+        no = &arv->slabs->nos[arv->slabs->usados++];
+    }
+
+    no->direita = no->esquerda = NULL;
+    no->altura = 0;
+    no->chave = chave;
+    arv->ocupacao.em_uso++;
+    CONTAR(alocacoes, 1);
     return no;
 }
 
+/*
+Liberação de nó
+Parâmetro: árvore dona do nó e o nó a ser liberado
+Funcionamento: o nó não volta ao sistema, e sim para a lista de livres da árvore, de onde será reaproveitado por criar_no
+*/
+
+static void liberar_no(ArvoreAVL *arv, NO *no)
+{
+    no->direita = arv->livres;
+    arv->livres = no;
+    arv->ocupacao.em_uso--;
+    arv->ocupacao.livres++;
+    CONTAR(liberacoes, 1);
+}
+
 /*
 Criação de arvore
 Parametro: //
-Funcionamento: aloca espaço para o conteudo da arvore e os inicializa caso a arvore seja de fato criada
+Funcionamento: aloca espaço para o conteudo da arvore e os inicializa caso a arvore seja de fato criada.
+Nenhum slab é alocado até a primeira inserção
 */
 ArvoreAVL *criar_arvore_avl()
 {
     ArvoreAVL *arv = (ArvoreAVL *)malloc(sizeof(ArvoreAVL));
     if (arv)
+    {
         arv->raiz = NULL;
+        arv->slabs = NULL;
+        arv->livres = NULL;
+        arv->ocupacao.slabs = arv->ocupacao.capacidade = 0;
+        arv->ocupacao.em_uso = arv->ocupacao.livres = 0;
+    }
     return arv;
 }
 
+/*
+Ocupação da árvore
+Parametro: árvore a ser consultada
+Funcionamento: retorna uma cópia dos contadores do alocador de nós (slabs, capacidade, nós em uso e nós livres)
+*/
+OCUPACAO ocupacao_arvore_avl(ArvoreAVL *arv)
+{
+    OCUPACAO vazia = {0, 0, 0, 0};
+    return arv ? arv->ocupacao : vazia;
+}
+
 /*
 Altura de um nó
 Parametro: nó a ser verificado
@@ -78,6 +134,7 @@ static NO *rotacao_direita(NO *y)
     NO *x = y->esquerda;      // O novo no raiz sera o filho á esquerda
     y->esquerda = x->direita; // o filho direito de x se torna o filho esuqerdo de y
     x->direita = y;           // y se torna filho direito de x
+    CONTAR(rotacoes, 1);
 
     atualizar_altura(y);
     atualizar_altura(x);
@@ -95,6 +152,7 @@ static NO *rotacao_esquerda(NO *x)
     NO *y = x->direita;       // O novo no sera o filho a direita
     x->direita = y->esquerda; // o filjo esquerdo de y se torna o filho direito
     y->esquerda = x;          // x se torna o filho esquerdo de y
+    CONTAR(rotacoes, 1);
 
     atualizar_altura(x);
     atualizar_altura(y);
@@ -112,6 +170,7 @@ static NO *balancear(NO *no)
 {
     if (!no) return no;
 
+    atualizar_altura(no); // A altura precisa estar correta antes de calcular o fator
     int fb = fator_balanceamento(no); // Calcula o fator de balanceamento
 
     // Caso de desbalanceamento à esquerda
@@ -137,21 +196,53 @@ static NO *balancear(NO *no)
     return no; // Retorna o nó balanceado
 }
 
+/*
+Construção a partir de vetor (criar_arvore_avl_de_vetor e construir_no)
+Parametro: vetor ordenado e sem repetições e seu tamanho
+Funcionamento: o elemento do meio do intervalo vira a raiz da subárvore e as metades esquerda e direita viram,
+recursivamente, as subárvores esquerda e direita. As metades diferem em no máximo 1 elemento, então a árvore
+já nasce balanceada: não há comparações nem rotações, apenas O(n) criações de nós.
+*/
+static NO *construir_no(ArvoreAVL *arv, const int *vetor, int inicio, int fim)
+{
+    if (inicio > fim)
+        return NULL;
+
+    int meio = inicio + (fim - inicio) / 2;
+    NO *no = criar_no(arv, vetor[meio]);
+    if (no)
+    {
+        no->esquerda = construir_no(arv, vetor, inicio, meio - 1);
+        no->direita = construir_no(arv, vetor, meio + 1, fim);
+        atualizar_altura(no);
+    }
+    return no;
+}
+
+ArvoreAVL *criar_arvore_avl_de_vetor(const int *vetor, int n)
+{
+    ArvoreAVL *arv = criar_arvore_avl();
+    if (arv)
+        arv->raiz = construir_no(arv, vetor, 0, n - 1);
+    return arv;
+}
+
 /*
 Apagar arvore (apagar_arvore_avl e apagar_no)
 Parametro: arvore a ser apagada
-Funcionamento: antes de apagar a arvore, é necessário verificar se tem elemento, os quais precisam ser apagados.
-Caso tenha, a função auxiliar percorre a arvore apagando os elementos de baixo para cima (percurso pós-ordem).
-Após isso, enfim apaga-se a arvore.
+Funcionamento: como todos os nós moram nos slabs da árvore, não é necessário percorrê-la:
+basta liberar cada slab (O(número de slabs)) e, após isso, enfim apaga-se a arvore.
+A função auxiliar apagar_no devolve uma subárvore inteira para a lista de livres (percurso pós-ordem),
+sendo usada quando apenas parte da árvore deve ser descartada.
 */
 
-void apagar_no(NO **raiz)
+static void apagar_no(ArvoreAVL *arv, NO **raiz)
 {
     if (*raiz)
     {
-        apagar_no(&((*raiz)->esquerda)); // apaga os nos a esquerda
-        apagar_no(&((*raiz)->direita));  // apaga os nos a direita
-        free(*raiz);
+        apagar_no(arv, &((*raiz)->esquerda)); // apaga os nos a esquerda
+        apagar_no(arv, &((*raiz)->direita));  // apaga os nos a direita
+        liberar_no(arv, *raiz);
         *raiz = NULL; // Libera o no atual
     }
 }
@@ -160,68 +251,131 @@ void apagar_arvore_avl(ArvoreAVL **arv)
 {
     if (*arv) //se a arvore não tem espaço alocado, então se faz necessário desalocar
     {
-        if ((*arv)->raiz) // se a arvore não tiver nós, o algorimto pula o processo de apagar nós
+        SLAB *slab = (*arv)->slabs;
+        while (slab)
         {
-            apagar_no(&((*arv)->raiz));
+            SLAB *proximo = slab->proximo;
+            free(slab);
+            slab = proximo;
         }
         free(*arv);
         *arv = NULL;
     }
 }
 
-/*Imprimir nó
-Parâmetro: raiz do nó que será impresso
-Funcionamento: percorre a subárvore de maneira in-order (ordem simétrica), ou seja:
-Chama recursivamente a função para o nó filho esquerdo.
-Imprime a chave do nó atual.
-Chama recursivamente a função para o nó filho direito. Dessa forma, os elementos são exibidos em ordem crescente. */
+/*
+Iterador (iterador_avl_iniciar, iterador_avl_proximo e iterador_avl_buscar_a_partir_de)
+Funcionamento: o percurso em ordem simétrica (esquerda, nó, direita), com a pilha da recursão guardada no próprio iterador.
+A pilha contém o caminho da descida pela esquerda: o topo é o menor elemento ainda não visitado.
+Ao visitar um nó, empilha-se o caminho mais à esquerda da sua subárvore direita (empilhar_esquerda).
+Cada nó é empilhado e desempilhado uma vez, então percorrer a árvore toda custa O(n) e cada passo O(1) amortizado;
+a pilha tem no máximo a altura da árvore (ALTURA_MAXIMA_AVL).
+*/
 
-void imprimir_no(NO *raiz)
+static void empilhar_esquerda(ITERADOR_AVL *iterador, NO *no)
 {
-    if (raiz)
+    while (no)
     {
-        imprimir_no(raiz->esquerda);
-        printf("%d ", raiz->chave);
-        imprimir_no(raiz->direita);
+        iterador->pilha[iterador->topo++] = no;
+        no = no->esquerda;
     }
 }
 
-/*imprimir_arvore_avl
-Parâmetros: Recebe a árvore AVL (arv).
-Funcionamento:
-Imprime os elementos da árvore em ordem crescente.
-Utiliza a função auxiliar imprimir_no para percorrer a árvore em ordem simétrica.*/
+void iterador_avl_iniciar(ITERADOR_AVL *iterador, ArvoreAVL *arv)
+{
+    iterador->topo = 0;
+    if (arv)
+        empilhar_esquerda(iterador, arv->raiz);
+}
+
+bool iterador_avl_proximo(ITERADOR_AVL *iterador, int *elemento)
+{
+    if (iterador->topo == 0)
+        return false;
+    NO *no = iterador->pilha[--iterador->topo];
+    *elemento = no->chave;
+    empilhar_esquerda(iterador, no->direita);
+    return true;
+}
+
+/*
+Buscar a partir de: desempilha os nós menores que a chave; das subárvores direitas deles, só a do último desempilhado pode ter
+elementos >= chave (as anteriores são menores que ele). Desce por essa subárvore empilhando os nós >= chave (e seguindo à esquerda),
+como em empilhar_esquerda, e pulando os menores (seguindo à direita). Depois, o topo é o primeiro elemento >= chave.
+Custo: O(log d) amortizado, d sendo a quantidade de elementos pulados, o que permite interseções por saltos (ver conjunto.c)
+*/
+
+bool iterador_avl_buscar_a_partir_de(ITERADOR_AVL *iterador, int chave, int *elemento)
+{
+    NO *restante = NULL;
+    while (iterador->topo > 0 && iterador->pilha[iterador->topo - 1]->chave < chave)
+    {
+        CONTAR(comparacoes, 1);
+        restante = iterador->pilha[--iterador->topo]->direita;
+    }
+    while (restante)
+    {
+        CONTAR(comparacoes, 1);
+        if (restante->chave >= chave)
+        {
+            iterador->pilha[iterador->topo++] = restante;
+            restante = restante->esquerda;
+        }
+        else
+        {
+            restante = restante->direita;
+        }
+    }
+    return iterador_avl_proximo(iterador, elemento);
+}
 
-void imprimir_arvore_avl(ArvoreAVL *arv)
+/*
+Exportar (exportar_arvore_avl)
+Parâmetros: a árvore AVL e um vetor de saída com espaço para todos os seus elementos
+Funcionamento: percorre a árvore com o iterador, escrevendo as chaves (em ordem crescente) no vetor.
+Retorna a quantidade de chaves escritas.
+*/
+
+int exportar_arvore_avl(ArvoreAVL *arv, int *saida)
 {
-    printf("{");
-    imprimir_no(arv->raiz);
-    printf("}");
+    int n = 0;
+    ITERADOR_AVL iterador;
+    iterador_avl_iniciar(&iterador, arv);
+    while (iterador_avl_proximo(&iterador, &saida[n]))
+        n++;
+    return n;
 }
 
 /*
 Inserção de elemento (inserir_arvore_avl e inserir_no)
 Parametro: A arvore que receberá um elemento e o elemento
-Funcionamento: após verificar se a árvore existe, o nó com o elemento é criado e assim busca-se a posição em que será colocado o nó.
+Funcionamento: após verificar se a árvore existe, busca-se a posição em que será colocado o nó.
 Caso o elemento for maior que a chave da raiz atual, compara-se o elemento com o filho direito;
 Caso o elemento for menor que a chave da raiz atual, compara-se o elemento com o filho esquerdo;
-Caso a raiz atual for nula, esta será a posição do nó. Após isso, pela volta da recursão, todos os nós acessados são redefinidos.
+Caso a raiz atual for nula, esta será a posição do nó, que só então é criado (assim, um elemento repetido não consome nó).
+Após isso, pela volta da recursão, todos os nós acessados são redefinidos.
 */
 
-NO *inserir_no(NO *raiz, NO *no)
+static NO *inserir_no(ArvoreAVL *arv, NO *raiz, int elemento, bool *inserido)
 {
-    // Inserção recursiva á esquerda ou a direita
+    // Posição encontrada: cria o nó
     if (!raiz)
-        raiz = no;
+    {
+        NO *no = criar_no(arv, elemento);
+        *inserido = (no != NULL);
+        return no;
+    }
 
-    if (no->chave < raiz->chave)
-        raiz->esquerda = inserir_no(raiz->esquerda, no);
-    else if (no->chave > raiz->chave)
-        raiz->direita = inserir_no(raiz->direita, no);
+    // Inserção recursiva á esquerda ou a direita
+    CONTAR(comparacoes, 1);
+    if (elemento < raiz->chave)
+        raiz->esquerda = inserir_no(arv, raiz->esquerda, elemento, inserido);
+    else if (elemento > raiz->chave)
+        raiz->direita = inserir_no(arv, raiz->direita, elemento, inserido);
     else
         return raiz;
 
-    atualizar_altura(no); // Atualiza a altura do nó atual
+    atualizar_altura(raiz); // Atualiza a altura do nó atual
     return balancear(raiz); // Balanceia a arvore apos a inserção
 }
 
@@ -229,22 +383,17 @@ NO *inserir_no(NO *raiz, NO *no)
 Parâmetros: Recebe um ponteiro para uma árvore AVL (arv) e um inteiro (elemento) que será inserido.
 Funcionamento:
 Verifica se a árvore AVL existe (arv não é nula).
-Cria um nó com o valor fornecido (criar_no).
-Insere o nó na árvore utilizando a função auxiliar inserir_no, que executa a lógica de inserção balanceada.
-Retorna true se o nó foi inserido com sucesso, ou false se houve falha na criação do nó.*/
+Insere o elemento na árvore utilizando a função auxiliar inserir_no, que executa a lógica de inserção balanceada e cria o nó (criar_no).
+Retorna true se o nó foi inserido com sucesso, ou false se o elemento já existia ou houve falha na criação do nó.*/
 
 bool inserir_arvore_avl(ArvoreAVL *arv, int elemento)
 {
+    bool inserido = false;
     if (arv)
     {
-        NO *no = criar_no(elemento);
-        if (no)
-        {
-            arv->raiz = inserir_no(arv->raiz, no);
-            return true;
-        }
-        return false;
+        arv->raiz = inserir_no(arv, arv->raiz, elemento, &inserido);
     }
+    return inserido;
 }
 
 /*remover_no
@@ -255,18 +404,19 @@ Se o elemento não tem filhos ou tem apenas um, remove-o e retorna o filho resta
 Se o nó tem dois filhos, substitui a chave pela do menor elemento da subárvore direita e remove este elemento.
 Após a remoção, balanceia a subárvore.*/
 
-NO *remover_no(NO *raiz, int elemento)
+static NO *remover_no(ArvoreAVL *arv, NO *raiz, int elemento)
 {
     if (!raiz)
         return NULL; /// o elemento não foi encontrado
 
+    CONTAR(comparacoes, 1);
     if (elemento < raiz->chave)
     {
-        raiz->esquerda = remover_no(raiz->esquerda, elemento);
+        raiz->esquerda = remover_no(arv, raiz->esquerda, elemento);
     }
     else if (elemento > raiz->chave)
     {
-        raiz->direita = remover_no(raiz->direita, elemento);
+        raiz->direita = remover_no(arv, raiz->direita, elemento);
     }
     else
     {
@@ -274,7 +424,7 @@ NO *remover_no(NO *raiz, int elemento)
         if (!raiz->esquerda || !raiz->direita)
         {
             NO *temp = raiz->esquerda ? raiz->esquerda : raiz->direita;
-            free(raiz);
+            liberar_no(arv, raiz); // o nó volta para a lista de livres da árvore
             return temp; // Retorna o único filho (ou NULL)
         }
         else
@@ -284,7 +434,7 @@ NO *remover_no(NO *raiz, int elemento)
             while (temp->esquerda)
                 temp = temp->esquerda;
             raiz->chave = temp->chave;
-            raiz->direita = remover_no(raiz->direita, temp->chave);
+            raiz->direita = remover_no(arv, raiz->direita, temp->chave);
         }
     }
 
@@ -301,7 +451,7 @@ bool remover_arvore_avl(ArvoreAVL *arv, int elemento)
 {
     if (pertence_arvore_avl(arv, elemento))
     {
-        arv->raiz = remover_no(arv->raiz, elemento);
+        arv->raiz = remover_no(arv, arv->raiz, elemento);
         return true;
     }
     return false;
@@ -319,6 +469,7 @@ bool pertence_no(NO *raiz, int elemento)
 {
     if (!raiz)
         return 0; // Elemento não encontrado
+    CONTAR(comparacoes, 1);
     if (elemento == raiz->chave)
         return 1; // Elemento encontrado
     if (elemento < raiz->chave)
@@ -337,79 +488,658 @@ bool pertence_arvore_avl(ArvoreAVL *arv, int elemento)
     return pertence_no(arv->raiz, elemento);
 }
 
+/*pertence_lote_arvore_avl
+Parâmetros: a árvore AVL, um vetor de k chaves (em qualquer ordem), o vetor de saída com k posições.
+Funcionamento:
+Uma descida de pertence_no passa quase todo o tempo esperando o próximo nó chegar da memória, e a seguinte só começa quando ela termina.
+Aqui DESCIDAS_SIMULTANEAS descidas andam juntas, um nível por rodada: cada uma compara a chave com o nó atual, escolhe o filho
+e pede o filho à memória com prefetch; quando ela volta a ser atendida, na rodada seguinte, o nó já chegou (ou está a caminho).
+Assim as esperas das descidas se sobrepõem. Uma descida que termina dá lugar à próxima chave do vetor.
+saida[i] diz se chaves[i] pertence à árvore. Retorna quantas chaves pertencem.
+*/
+int pertence_lote_arvore_avl(ArvoreAVL *arv, const int *chaves, int k, bool *saida)
+{
+    NO *no[DESCIDAS_SIMULTANEAS];
+    int indice[DESCIDAS_SIMULTANEAS];
+    int ativas = 0, proxima = 0, encontradas = 0;
+
+    while (ativas < DESCIDAS_SIMULTANEAS && proxima < k)
+    {
+        no[ativas] = arv->raiz;
+        indice[ativas++] = proxima++;
+    }
+    while (ativas > 0)
+    {
+        for (int j = 0; j < ativas; j++)
+        {
+            NO *atual = no[j];
+            int x = chaves[indice[j]];
+            if (atual != NULL)
+            {
+                CONTAR(comparacoes, 1);
+            }
+            if (atual != NULL && atual->chave != x)
+            {
+                atual = x < atual->chave ? atual->esquerda : atual->direita;
+                __builtin_prefetch(atual);
+                no[j] = atual;
+                continue;
+            }
+            // descida terminada: achou (nó com a chave) ou não (chegou a NULL)
+            saida[indice[j]] = atual != NULL;
+            encontradas += atual != NULL;
+            if (proxima < k)
+            {
+                no[j] = arv->raiz;
+                indice[j] = proxima++;
+            }
+            else
+            {
+                ativas--;
+                no[j] = no[ativas];
+                indice[j] = indice[ativas];
+                j--; // a descida trazida do fim ainda não foi atendida nesta rodada
+            }
+        }
+    }
+    return encontradas;
+}
+
+/*
+Copiar nó
+Parâmetro: árvore que receberá os nós e raiz da subárvore a ser copiada
+Funcionamento: percorre a subárvore em pré-ordem criando um nó novo (nos slabs da árvore de destino) para cada nó original.
+A forma da árvore é preservada, então as alturas são copiadas diretamente e nenhum rebalanceamento é necessário (O(n)).
+Se faltar memória, marca *falhou e retorna NULL: os nós já copiados da subárvore voltam para a lista de livres, porque uma cópia
+incompleta não seria balanceada.
+*/
+static NO *copiar_no(ArvoreAVL *arv, NO *raiz, bool *falhou)
+{
+    if (!raiz)
+        return NULL;
+
+    NO *copia = criar_no(arv, raiz->chave);
+    if (!copia)
+    {
+        *falhou = true;
+        return NULL;
+    }
+    copia->altura = raiz->altura;
+    copia->esquerda = copiar_no(arv, raiz->esquerda, falhou);
+    copia->direita = copiar_no(arv, raiz->direita, falhou);
+    if ((raiz->esquerda && !copia->esquerda) || (raiz->direita && !copia->direita))
+        apagar_no(arv, &copia);
+    return copia;
+}
+
+/*
+Junção (juntar_no, juntar_direita e juntar_esquerda)
+Parâmetros: subárvore esquerda, nó do meio e subárvore direita, com todas as chaves da esquerda < chave do meio < todas as chaves da direita
+Funcionamento: se as alturas das duas subárvores diferem em no máximo 1, o nó do meio vira a raiz.
+Caso contrário, desce pela espinha da subárvore mais alta (pela direita da esquerda, ou pela esquerda da direita) até encontrar
+uma subárvore de altura compatível com a mais baixa, pendura ali o nó do meio e rebalanceia na volta da recursão.
+Custo: O(|altura(esq) - altura(dir)| + 1)
+*/
+static NO *juntar_direita(NO *esq, NO *meio, NO *dir)
+{
+    if (altura(esq->direita) <= altura(dir) + 1)
+    {
+        meio->esquerda = esq->direita;
+        meio->direita = dir;
+        atualizar_altura(meio);
+        esq->direita = meio;
+    }
+    else
+    {
+        esq->direita = juntar_direita(esq->direita, meio, dir);
+    }
+    return balancear(esq);
+}
+
+static NO *juntar_esquerda(NO *esq, NO *meio, NO *dir)
+{
+    if (altura(dir->esquerda) <= altura(esq) + 1)
+    {
+        meio->esquerda = esq;
+        meio->direita = dir->esquerda;
+        atualizar_altura(meio);
+        dir->esquerda = meio;
+    }
+    else
+    {
+        dir->esquerda = juntar_esquerda(esq, meio, dir->esquerda);
+    }
+    return balancear(dir);
+}
+
+static NO *juntar_no(NO *esq, NO *meio, NO *dir)
+{
+    if (altura(esq) > altura(dir) + 1)
+        return juntar_direita(esq, meio, dir);
+    if (altura(dir) > altura(esq) + 1)
+        return juntar_esquerda(esq, meio, dir);
+
+    meio->esquerda = esq;
+    meio->direita = dir;
+    atualizar_altura(meio);
+    return meio;
+}
+
+/*
+Remover maior
+Parâmetros: raiz da subárvore e referência onde o nó de maior chave será devolvido
+Funcionamento: desce sempre pela direita, desliga o nó de maior chave (sem liberá-lo) e rebalanceia na volta da recursão
+*/
+static NO *remover_maior(NO *raiz, NO **maior)
+{
+    if (!raiz->direita)
+    {
+        *maior = raiz;
+        return raiz->esquerda;
+    }
+    raiz->direita = remover_maior(raiz->direita, maior);
+    return balancear(raiz);
+}
+
+/*
+Junção sem nó do meio
+Parâmetros: subárvore esquerda e direita, com todas as chaves da esquerda < todas as chaves da direita
+Funcionamento: retira o maior nó da esquerda e o usa como nó do meio para juntar_no
+*/
+static NO *juntar_sem_meio(NO *esq, NO *dir)
+{
+    if (!esq)
+        return dir;
+    if (!dir)
+        return esq;
+
+    NO *meio;
+    esq = remover_maior(esq, &meio);
+    return juntar_no(esq, meio, dir);
+}
+
+/*
+Divisão
+Parâmetros: raiz da subárvore, chave de corte e referências para as duas metades
+Funcionamento: separa a árvore em duas: *esq com as chaves menores que a chave de corte e *dir com as maiores.
+Os nós do caminho da raiz até a chave são reaproveitados como nós do meio nas junções.
+Retorna o nó que possui a chave de corte (desligado das duas metades), ou NULL se a chave não estiver na árvore.
+Custo: O(log n)
+*/
+static NO *dividir_no(NO *raiz, int chave, NO **esq, NO **dir)
+{
+    if (!raiz)
+    {
+        *esq = *dir = NULL;
+        return NULL;
+    }
+
+    NO *encontrado;
+    NO *filho_esq = raiz->esquerda;
+    NO *filho_dir = raiz->direita;
+
+    CONTAR(comparacoes, 1);
+    if (chave < raiz->chave)
+    {
+        NO *resto;
+        encontrado = dividir_no(filho_esq, chave, esq, &resto);
+        *dir = juntar_no(resto, raiz, filho_dir);
+    }
+    else if (chave > raiz->chave)
+    {
+        NO *resto;
+        encontrado = dividir_no(filho_dir, chave, &resto, dir);
+        *esq = juntar_no(filho_esq, raiz, resto);
+    }
+    else
+    {
+        *esq = filho_esq;
+        *dir = filho_dir;
+        raiz->esquerda = raiz->direita = NULL;
+        raiz->altura = 0;
+        encontrado = raiz;
+    }
+    return encontrado;
+}
+
 /*Uniao_no
-Parâmetros: dois nós raiz (raiz1 e raiz2) representando as subárvores a serem unidas.
-Funcionamento: combina os elementos das subárvores enraizadas em raiz1 e raiz2 em uma única árvore.
+Parâmetros: árvore dona dos nós de raiz1 (arv), raiz1, subárvore que recebe os elementos (seus nós são reaproveitados), e raiz2, subárvore apenas lida.
+Funcionamento: divide raiz1 pela chave da raiz de raiz2, une recursivamente as metades menores e as maiores
+e junta os dois resultados usando como nó do meio o próprio nó de raiz1 com a chave (se existir) ou um nó novo.
 
-Se raiz1 for nulo, retorna raiz2, pois não há elementos em raiz1.
-Se raiz2 for nulo, retorna raiz1, pois não há elementos em raiz2.
-Caso contrário, insere o elemento do nó raiz de raiz2 na subárvore de raiz1.
-Recursivamente aplica a união para os filhos esquerdo e direito de raiz2 com raiz1.
-Retorna raiz1, que agora contém os elementos das duas subárvores combinadas.*/
+Se raiz1 for nulo, retorna uma cópia de raiz2.
+Se raiz2 for nulo, retorna raiz1.
+Apenas os elementos de raiz2 que não estavam em raiz1 são alocados. Custo: O(m log(n/m + 1)), m sendo o tamanho da menor árvore.
+Se faltar memória para um nó novo, marca *falhou e junta as metades sem ele: o resultado continua uma AVL, só sem essa chave.*/
 
-NO *uniao_no(NO *raiz1, NO *raiz2)
+static NO *uniao_no(ArvoreAVL *arv, NO *raiz1, NO *raiz2, bool *falhou)
 {
-    if (!raiz1)
-        return raiz2;
     if (!raiz2)
         return raiz1;
+    if (!raiz1)
+        return copiar_no(arv, raiz2, falhou);
 
-    // Adiciona todos os elementos de raiz2 em raiz1
-    raiz1 = inserir_no(raiz1, criar_no(raiz2->chave));
-    raiz1 = uniao_no(raiz1, raiz2->esquerda);
-    raiz1 = uniao_no(raiz1, raiz2->direita);
+    NO *esq, *dir;
+    NO *meio = dividir_no(raiz1, raiz2->chave, &esq, &dir);
+    if (!meio)
+        meio = criar_no(arv, raiz2->chave);
 
-    return raiz1;
+    esq = uniao_no(arv, esq, raiz2->esquerda, falhou);
+    dir = uniao_no(arv, dir, raiz2->direita, falhou);
+    if (!meio)
+    {
+        *falhou = true;
+        return juntar_sem_meio(esq, dir);
+    }
+    return juntar_no(esq, meio, dir);
 }
 
 /*uniao_arvores_avl
 Parâmetros: Duas árvores AVL (arv1 e arv2).
 Funcionamento:
 Combina os elementos de arv2 na árvore arv1.
-Utiliza a função auxiliar uniao_no para percorrer e inserir os elementos de arv2 em arv1.*/
+Utiliza a função auxiliar uniao_no, que reaproveita os nós de arv1 e mantém arv2 intacta.
+Retorna NULL se faltou memória para algum nó: arv1 continua uma AVL válida, mas sem parte dos elementos de arv2.*/
 
 ArvoreAVL *uniao_arvores_avl(ArvoreAVL *arv1, ArvoreAVL *arv2)
 {
     if (!arv1 || !arv2)
         return arv1 ? arv1 : arv2;
-    arv1->raiz = uniao_no(arv1->raiz, arv2->raiz);
-    return arv1;
+    bool falhou = false;
+    arv1->raiz = uniao_no(arv1, arv1->raiz, arv2->raiz, &falhou);
+    return falhou ? NULL : arv1;
 }
 
 /*intersecao_no
-Parâmetros: dois nós raiz (raiz1 e raiz2) das arvores e a raiz do resultado (intersecao).
-Funcionamento: verifica os elementos repetidos presentes nas subárvores enraizadas em raiz1 e raiz2 e os armazena.
-
-Se raiz1 ou raiz2 for nulo, não modifica a intersecao.
-Caso contrário, busca-se o elemento de raiz1 na arvore de raiz2. Caso estiver, insere o elemento na arvore intersecao.
-Recursivamente, o algoritmo acessa outros elementos por meio de raiz1 e verifica se estão na arvore de raiz2. 
-Retorna intersecao quando acessar toda raiz1.*/
-
-// Realiza a interseção de duas árvores AVL
-NO *intersecao_no(NO *intersecao, NO *raiz1, NO *raiz2) {
-    if (!raiz1 || !raiz2) 
-        return intersecao;  // Retorna a árvore atual, não NULL
-    
-    if (pertence_no(raiz2, raiz1->chave)) {
-        intersecao = inserir_no(intersecao, criar_no(raiz1->chave));
-    }
-    
-    intersecao = intersecao_no(intersecao, raiz1->esquerda, raiz2);
-    intersecao = intersecao_no(intersecao, raiz1->direita, raiz2);
-    
-    return intersecao;
+Parâmetros: árvore dona dos nós de raiz1 (arv), raiz1, subárvore consumida pela operação (seus nós são reaproveitados ou liberados), e raiz2, subárvore apenas lida.
+Funcionamento: divide raiz1 pela chave da raiz de raiz2 e calcula recursivamente a interseção das metades menores e das maiores.
+Se a chave existia em raiz1, seu nó é o nó do meio da junção; caso contrário, as duas metades são juntadas sem nó do meio.
+
+Se raiz1 for nulo, não há o que intersectar.
+Se raiz2 for nulo, todos os nós restantes de raiz1 voltam para a lista de livres de arv.
+Custo: O(m log(n/m + 1)).*/
+
+static NO *intersecao_no(ArvoreAVL *arv, NO *raiz1, NO *raiz2)
+{
+    if (!raiz1)
+        return NULL;
+    if (!raiz2)
+    {
+        apagar_no(arv, &raiz1);
+        return NULL;
+    }
+
+    NO *esq, *dir;
+    NO *meio = dividir_no(raiz1, raiz2->chave, &esq, &dir);
+
+    esq = intersecao_no(arv, esq, raiz2->esquerda);
+    dir = intersecao_no(arv, dir, raiz2->direita);
+    if (meio)
+        return juntar_no(esq, meio, dir);
+    return juntar_sem_meio(esq, dir);
 }
 
 /*intersecao_arvores_avl
 Parâmetros: Duas árvores AVL (arv1 e arv2).
 Funcionamento:
 Identifica os elementos que estão presentes em ambas as árvores.
-Utiliza a função intersecao_no para construir uma nova árvore com os elementos comuns.*/
+Copia a árvore arv1 (O(n), sem rebalanceamento) e usa a função intersecao_no para reduzir a cópia aos elementos comuns.
+As árvores originais não são alteradas. Para menor custo, arv1 deve ser a menor das duas árvores.
+Retorna NULL se faltou memória para a cópia.*/
 
 ArvoreAVL *intersecao_arvores_avl(ArvoreAVL *arv1, ArvoreAVL *arv2) {
     ArvoreAVL *intersecao = criar_arvore_avl();
-    if (!arv1 || !arv2) return intersecao;
-    
-    intersecao->raiz = intersecao_no(intersecao->raiz, arv1->raiz, arv2->raiz);
+    if (!intersecao || !arv1 || !arv2) return intersecao;
+
+    bool falhou = false;
+    intersecao->raiz = copiar_no(intersecao, arv1->raiz, &falhou);
+    if (falhou)
+    {
+        apagar_arvore_avl(&intersecao);
+        return NULL;
+    }
+    intersecao->raiz = intersecao_no(intersecao, intersecao->raiz, arv2->raiz);
     return intersecao;
 }
+
+/*intersecao_busca_no
+Parâmetros: raiz da árvore menor, raiz da árvore maior, vetor de saída e a quantidade já escrita nele.
+Funcionamento: percorre a árvore menor em ordem simétrica e faz uma descida (pertence_no) na maior para cada chave.
+As chaves encontradas saem em ordem crescente, prontas para a construção balanceada.*/
+
+static void intersecao_busca_no(NO *menor, NO *maior, int *saida, int *k)
+{
+    if (!menor)
+        return;
+    intersecao_busca_no(menor->esquerda, maior, saida, k);
+    if (pertence_no(maior, menor->chave))
+        saida[(*k)++] = menor->chave;
+    intersecao_busca_no(menor->direita, maior, saida, k);
+}
+
+/*intersecao_busca_arvores_avl
+Parâmetros: a árvore menor, a árvore maior e o número de elementos da menor.
+Funcionamento:
+Quando uma árvore é muitas vezes maior que a outra, m descidas de O(log n) na maior são mais baratas que copiar e dividir.
+As chaves comuns são coletadas em ordem e a árvore resultado é montada já balanceada, alocando apenas os nós necessários.*/
+
+ArvoreAVL *intersecao_busca_arvores_avl(ArvoreAVL *menor, ArvoreAVL *maior, int tam_menor)
+{
+    if (!menor || !maior || tam_menor <= 0)
+        return criar_arvore_avl();
+
+    int *comuns = (int *)malloc(tam_menor * sizeof(int));
+    if (!comuns)
+        return NULL;
+    int k = 0;
+    intersecao_busca_no(menor->raiz, maior->raiz, comuns, &k);
+
+    ArvoreAVL *intersecao = criar_arvore_avl_de_vetor(comuns, k);
+    free(comuns);
+    return intersecao;
+}
+
+/*diferenca_no
+Parâmetros: árvore dona dos nós de raiz1 (arv), raiz1, subárvore da qual os elementos serão retirados, e raiz2, subárvore apenas lida.
+Funcionamento: divide raiz1 pela chave da raiz de raiz2, liberando o nó com a chave caso exista,
+calcula recursivamente a diferença das metades menores e das maiores e as junta sem nó do meio.
+Custo: O(m log(n/m + 1)).*/
+
+static NO *diferenca_no(ArvoreAVL *arv, NO *raiz1, NO *raiz2)
+{
+    if (!raiz1 || !raiz2)
+        return raiz1;
+
+    NO *esq, *dir;
+    NO *meio = dividir_no(raiz1, raiz2->chave, &esq, &dir);
+    if (meio)
+        liberar_no(arv, meio);
+
+    esq = diferenca_no(arv, esq, raiz2->esquerda);
+    dir = diferenca_no(arv, dir, raiz2->direita);
+    return juntar_sem_meio(esq, dir);
+}
+
+/*diferenca_arvores_avl
+Parâmetros: Duas árvores AVL (arv1 e arv2).
+Funcionamento:
+Retira de arv1 todos os elementos que pertencem a arv2 (arv1 = arv1 - arv2), mantendo arv2 intacta.*/
+
+ArvoreAVL *diferenca_arvores_avl(ArvoreAVL *arv1, ArvoreAVL *arv2)
+{
+    if (!arv1 || !arv2)
+        return arv1;
+    arv1->raiz = diferenca_no(arv1, arv1->raiz, arv2->raiz);
+    return arv1;
+}
+
+/*Operações paralelas (uniao_arvores_avl_paralela e intersecao_arvores_avl_paralela)
+As duas chamadas recursivas de uniao_no e intersecao_no não compartilham nós: depois da divisão, cada metade de raiz1 e cada filho
+de raiz2 pertencem a uma só delas. Por isso a chamada das chaves menores vira uma tarefa do pool (tarefas.h), que outra thread pode
+roubar, enquanto a thread atual segue com as maiores; a junção espera as duas. A cópia inicial da interseção se divide da mesma forma.
+Subárvores de raiz2 com menos de "corte" nós (estimados pela altura) seguem pelas funções sequenciais.
+O alocador de nós não é compartilhado: cada tarefa cria e libera nós em um alocador próprio, absorvido depois da junção
+pela tarefa que a bifurcou; no fim, todos os slabs e nós livres pertencem à árvore de destino.
+Falta de memória é tratada como nas versões sequenciais: cada tarefa marca o próprio "falhou", somado ao da tarefa mãe depois da junção.*/
+
+#define OPERACAO_COPIA 0
+#define OPERACAO_UNIAO 1
+#define OPERACAO_INTERSECAO 2
+
+typedef struct TarefaAvl
+{
+    TAREFA tarefa;
+    ArvoreAVL alocador; // nós criados e liberados por esta tarefa
+    ArvoreAVL *arv;     // &alocador, ou a própria árvore de destino na tarefa inicial
+    int operacao;
+    NO *raiz1;
+    NO *raiz2;
+    NO *resultado;
+    int corte;
+    bool falhou; // faltou memória para algum nó desta tarefa ou das que ela bifurcou
+} TAREFA_AVL;
+
+/*Absorver alocador
+Parâmetros: árvore de destino e alocador de uma tarefa já terminada
+Funcionamento: os nós nunca usados do slab atual da origem viram nós livres (só o primeiro slab do destino pode ter nós nunca usados),
+e os slabs da origem entram na lista do destino logo depois do primeiro. As duas listas de livres são percorridas juntas até
+a menor acabar, que é então ligada à outra: o custo é o tamanho da menor lista, não o da soma.*/
+
+static void absorver_alocador(ArvoreAVL *destino, ArvoreAVL *origem)
+{
+    SLAB *primeiro = origem->slabs;
+    if (primeiro)
+    {
+        while (primeiro->usados < NOS_POR_SLAB)
+        {
+            NO *no = &primeiro->nos[primeiro->usados++];
+            no->direita = origem->livres;
+            origem->livres = no;
+            origem->ocupacao.livres++;
+        }
+        SLAB *ultimo = primeiro;
+        while (ultimo->proximo)
+            ultimo = ultimo->proximo;
+        if (destino->slabs)
+        {
+            ultimo->proximo = destino->slabs->proximo;
+            destino->slabs->proximo = primeiro;
+        }
+        else
+        {
+            destino->slabs = primeiro;
+        }
+    }
+
+    NO *a = origem->livres, *b = destino->livres;
+    if (a && b)
+    {
+        while (a->direita && b->direita)
+        {
+            a = a->direita;
+            b = b->direita;
+        }
+        if (!a->direita)
+        {
+            a->direita = destino->livres;
+            destino->livres = origem->livres;
+        }
+        else
+        {
+            b->direita = origem->livres;
+        }
+    }
+    else if (a)
+    {
+        destino->livres = a;
+    }
+
+    destino->ocupacao.slabs += origem->ocupacao.slabs;
+    destino->ocupacao.capacidade += origem->ocupacao.capacidade;
+    destino->ocupacao.em_uso += origem->ocupacao.em_uso;
+    destino->ocupacao.livres += origem->ocupacao.livres;
+    origem->slabs = NULL;
+    origem->livres = NULL;
+}
+
+/*Tamanho estimado
+Parâmetro: raiz de uma subárvore
+Funcionamento: retorna o máximo de nós de uma árvore com a altura da subárvore (2^(altura + 1) - 1), sem percorrê-la*/
+
+static int tamanho_estimado(NO *no)
+{
+    if (!no)
+        return 0;
+    return no->altura >= 30 ? 0x7fffffff : (2 << no->altura) - 1;
+}
+
+static NO *operacao_paralela_no(ArvoreAVL *arv, int operacao, NO *raiz1, NO *raiz2, int corte, bool *falhou);
+
+static void executar_tarefa_avl(void *argumento)
+{
+    TAREFA_AVL *t = (TAREFA_AVL *)argumento;
+    t->resultado = operacao_paralela_no(t->arv, t->operacao, t->raiz1, t->raiz2, t->corte, &t->falhou);
+}
+
+/*operacao_paralela_no
+Parâmetros: alocador da tarefa atual (arv), operação, raiz1 (consumida, como em uniao_no e intersecao_no), raiz2 (apenas lida), o corte
+e onde marcar a falta de memória.
+Funcionamento: igual a copiar_no, uniao_no ou intersecao_no, mas com a recursão das chaves menores bifurcada em uma tarefa.*/
+
+static NO *operacao_paralela_no(ArvoreAVL *arv, int operacao, NO *raiz1, NO *raiz2, int corte, bool *falhou)
+{
+    bool pequena = tamanho_estimado(raiz2) < corte;
+    if (operacao == OPERACAO_COPIA)
+    {
+        if (pequena)
+            return copiar_no(arv, raiz2, falhou);
+    }
+    else if (operacao == OPERACAO_UNIAO)
+    {
+        if (!raiz2)
+            return raiz1;
+        if (!raiz1)
+            return operacao_paralela_no(arv, OPERACAO_COPIA, NULL, raiz2, corte, falhou);
+        if (pequena)
+            return uniao_no(arv, raiz1, raiz2, falhou);
+    }
+    else if (!raiz1 || !raiz2 || pequena)
+    {
+        return intersecao_no(arv, raiz1, raiz2);
+    }
+
+    TAREFA_AVL menores = {0};
+    menores.tarefa.funcao = executar_tarefa_avl;
+    menores.tarefa.argumento = &menores;
+    menores.arv = &menores.alocador;
+    menores.operacao = operacao;
+    menores.raiz2 = raiz2->esquerda;
+    menores.corte = corte;
+
+    NO *meio, *dir = NULL;
+    if (operacao == OPERACAO_COPIA)
+    {
+        meio = criar_no(arv, raiz2->chave);
+        if (!meio)
+        {
+            *falhou = true;
+            return NULL;
+        }
+        meio->altura = raiz2->altura;
+    }
+    else
+    {
+        meio = dividir_no(raiz1, raiz2->chave, &menores.raiz1, &dir);
+        if (!meio && operacao == OPERACAO_UNIAO)
+            meio = criar_no(arv, raiz2->chave);
+    }
+
+    tarefas_bifurcar(&menores.tarefa);
+    dir = operacao_paralela_no(arv, operacao, dir, raiz2->direita, corte, falhou);
+    tarefas_aguardar(&menores.tarefa);
+    absorver_alocador(arv, &menores.alocador);
+    if (menores.falhou)
+        *falhou = true;
+
+    if (operacao == OPERACAO_COPIA)
+    {
+        meio->esquerda = menores.resultado;
+        meio->direita = dir;
+        if ((raiz2->esquerda && !menores.resultado) || (raiz2->direita && !dir))
+            apagar_no(arv, &meio); // cópia incompleta, como em copiar_no
+        return meio;
+    }
+    if (meio)
+        return juntar_no(menores.resultado, meio, dir);
+    if (operacao == OPERACAO_UNIAO)
+        *falhou = true; // o nó novo da chave de raiz2 não pôde ser criado
+    return juntar_sem_meio(menores.resultado, dir);
+}
+
+static NO *operacao_paralela(POOL_TAREFAS *pool, ArvoreAVL *arv, int operacao, NO *raiz1, NO *raiz2, int corte, bool *falhou)
+{
+    TAREFA_AVL inicial = {0};
+    inicial.arv = arv;
+    inicial.operacao = operacao;
+    inicial.raiz1 = raiz1;
+    inicial.raiz2 = raiz2;
+    inicial.corte = corte > 0 ? corte : CORTE_SEQUENCIAL_AVL;
+    tarefas_executar(pool, executar_tarefa_avl, &inicial);
+    if (inicial.falhou)
+        *falhou = true;
+    return inicial.resultado;
+}
+
+/*uniao_arvores_avl_paralela
+Parâmetros: Duas árvores AVL (arv1 e arv2), quantidade de threads e o corte (0 -> CORTE_SEQUENCIAL_AVL).
+Funcionamento: mesmo resultado de uniao_arvores_avl (inclusive NULL se faltou memória), com as recursões divididas entre as threads
+de um pool criado para a operação.*/
+
+ArvoreAVL *uniao_arvores_avl_paralela(ArvoreAVL *arv1, ArvoreAVL *arv2, int threads, int corte)
+{
+    if (!arv1 || !arv2 || threads <= 1)
+        return uniao_arvores_avl(arv1, arv2);
+    bool falhou = false;
+    POOL_TAREFAS *pool = tarefas_criar_pool(threads);
+    arv1->raiz = operacao_paralela(pool, arv1, OPERACAO_UNIAO, arv1->raiz, arv2->raiz, corte, &falhou);
+    tarefas_apagar_pool(&pool);
+    return falhou ? NULL : arv1;
+}
+
+/*intersecao_arvores_avl_paralela
+Parâmetros: Duas árvores AVL (arv1 e arv2), quantidade de threads e o corte (0 -> CORTE_SEQUENCIAL_AVL).
+Funcionamento: mesmo resultado de intersecao_arvores_avl; tanto a cópia de arv1 quanto a interseção são divididas entre as threads.*/
+
+ArvoreAVL *intersecao_arvores_avl_paralela(ArvoreAVL *arv1, ArvoreAVL *arv2, int threads, int corte)
+{
+    if (!arv1 || !arv2 || threads <= 1)
+        return intersecao_arvores_avl(arv1, arv2);
+    ArvoreAVL *intersecao = criar_arvore_avl();
+    if (!intersecao)
+        return NULL;
+    bool falhou = false;
+    POOL_TAREFAS *pool = tarefas_criar_pool(threads);
+    intersecao->raiz = operacao_paralela(pool, intersecao, OPERACAO_COPIA, NULL, arv1->raiz, corte, &falhou);
+    if (!falhou)
+        intersecao->raiz = operacao_paralela(pool, intersecao, OPERACAO_INTERSECAO, intersecao->raiz, arv2->raiz, corte, &falhou);
+    tarefas_apagar_pool(&pool);
+    if (falhou)
+        apagar_arvore_avl(&intersecao);
+    return intersecao;
+}
+
+/*inserir_lote_arvore_avl e remover_lote_arvore_avl
+Parâmetros: árvore AVL (arv), vetor ordenado e sem repetições e seu tamanho k.
+Funcionamento:
+O lote é montado como uma árvore balanceada em O(k) e aplicado de uma só vez com uniao_no ou diferenca_no,
+em vez de k descidas com rebalanceamento. A árvore do lote é descartada logo depois (apenas seus slabs são liberados).
+A quantidade de elementos inseridos ou removidos é a variação do número de nós em uso da árvore; se faltar memória no meio da união,
+só parte do lote entra, e a quantidade retornada continua a certa.*/
+
+int inserir_lote_arvore_avl(ArvoreAVL *arv, const int *ordenado, int k)
+{
+    if (!arv)
+        return -1;
+    ArvoreAVL *lote = criar_arvore_avl_de_vetor(ordenado, k);
+    if (!lote)
+        return -1;
+
+    int antes = arv->ocupacao.em_uso;
+    uniao_arvores_avl(arv, lote);
+    apagar_arvore_avl(&lote);
+    return arv->ocupacao.em_uso - antes;
+}
+
+int remover_lote_arvore_avl(ArvoreAVL *arv, const int *ordenado, int k)
+{
+    if (!arv)
+        return -1;
+    ArvoreAVL *lote = criar_arvore_avl_de_vetor(ordenado, k);
+    if (!lote)
+        return -1;
+
+    int antes = arv->ocupacao.em_uso;
+    diferenca_arvores_avl(arv, lote);
+    apagar_arvore_avl(&lote);
+    return antes - arv->ocupacao.em_uso;
+}
@@ -17,18 +17,75 @@ typedef struct No
     int altura;
 } NO;
 
+// Quantidade de nós alocados de uma só vez em cada slab
+#define NOS_POR_SLAB 1024
+
+// Quantidade de descidas intercaladas na busca em lote (buscas à memória em andamento ao mesmo tempo)
+#define DESCIDAS_SIMULTANEAS 16
+
+// Tamanho de subárvore abaixo do qual as operações paralelas seguem sequencialmente (padrão do parâmetro "corte")
+#define CORTE_SEQUENCIAL_AVL 32768
+
+// Altura máxima de uma AVL com até 2^31 nós (1,44 log2 n < 46), com folga: tamanho da pilha do iterador
+#define ALTURA_MAXIMA_AVL 64
+
+/*
+Struct Slab: bloco contíguo de nós alocado com um único malloc
+Os slabs de uma árvore formam uma lista encadeada; apenas o primeiro ainda pode ter nós nunca utilizados (usados < NOS_POR_SLAB)
+*/
+
+typedef struct Slab
+{
+    struct Slab *proximo;
+    int usados;
+    NO nos[NOS_POR_SLAB];
+} SLAB;
+
+/*
+Struct Ocupação: contadores do alocador de nós de uma árvore
+slabs: quantidade de slabs alocados; capacidade: total de nós que os slabs comportam;
+em_uso: nós que estão na árvore; livres: nós devolvidos que aguardam reaproveitamento
+*/
+
+typedef struct Ocupacao
+{
+    int slabs;
+    int capacidade;
+    int em_uso;
+    int livres;
+} OCUPACAO;
+
 /*
 Struct Arvore AVL: Com o sistema de nós, esquivale a uma arvore binaria de busca com sistema rebalanceamento da AVL
 A principio, é somente uma referênia ao nó raiz, com arestas para outros nós, que levam aos outros nós e assim por diante
+Cada árvore é dona dos slabs de onde saem seus nós e de uma lista de nós livres (encadeada pelo ponteiro direita)
 */
 
 struct ArvoreAVL
 {
     NO *raiz;
+    SLAB *slabs;
+    NO *livres;
+    OCUPACAO ocupacao;
 };
+
+/*
+Struct Iterador AVL: percurso em ordem simétrica sem recursão, que pode ser pausado entre um elemento e outro
+A pilha guarda os nós ainda não visitados do caminho atual (o topo é o próximo elemento); faltam, além deles, as subárvores direitas de cada um
+Qualquer alteração na árvore invalida o iterador
+*/
+
+typedef struct IteradorAVL
+{
+    NO *pilha[ALTURA_MAXIMA_AVL];
+    int topo;
+} ITERADOR_AVL;
 // Cria uma árvore AVL
 ArvoreAVL *criar_arvore_avl();
 
+// Cria uma árvore AVL perfeitamente balanceada a partir de um vetor ordenado e sem repetições
+ArvoreAVL *criar_arvore_avl_de_vetor(const int *vetor, int n);
+
 // Apaga a árvore AVL
 void apagar_arvore_avl(ArvoreAVL **raiz);
 
@@ -39,11 +96,32 @@ bool inserir_arvore_avl(ArvoreAVL *arv, int elemento);
 // Remove um elemento da árvore AVL
 bool remover_arvore_avl(ArvoreAVL *arv, int elemento);
 
+// Insere na árvore AVL os elementos de um vetor ordenado e sem repetições, retornando quantos eram novos
+int inserir_lote_arvore_avl(ArvoreAVL *arv, const int *ordenado, int k);
+
+// Remove da árvore AVL os elementos de um vetor ordenado e sem repetições, retornando quantos foram removidos
+int remover_lote_arvore_avl(ArvoreAVL *arv, const int *ordenado, int k);
+
 // Verifica se um elemento pertence à árvore AVL
 bool pertence_arvore_avl(ArvoreAVL *raiz, int elemento);
 
-// Imprime os elementos da árvore AVL
-void imprimir_arvore_avl(ArvoreAVL *raiz);
+// Verifica quais chaves de um vetor pertencem à árvore AVL, com várias descidas intercaladas; retorna quantas pertencem
+int pertence_lote_arvore_avl(ArvoreAVL *arv, const int *chaves, int k, bool *saida);
+
+// Escreve os elementos da árvore AVL em ordem crescente no vetor de saída, retornando quantos foram escritos
+int exportar_arvore_avl(ArvoreAVL *arv, int *saida);
+
+// Posiciona o iterador antes do menor elemento da árvore AVL
+void iterador_avl_iniciar(ITERADOR_AVL *iterador, ArvoreAVL *arv);
+
+// Escreve em "elemento" o próximo elemento em ordem crescente; retorna false ao fim da árvore
+bool iterador_avl_proximo(ITERADOR_AVL *iterador, int *elemento);
+
+// Avança até o primeiro elemento ainda não visitado que seja >= chave e o escreve em "elemento"; retorna false se não houver
+bool iterador_avl_buscar_a_partir_de(ITERADOR_AVL *iterador, int chave, int *elemento);
+
+// Retorna os contadores de ocupação dos slabs da árvore AVL
+OCUPACAO ocupacao_arvore_avl(ArvoreAVL *arv);
 
 // Realiza a união de duas árvores AVL
 ArvoreAVL *uniao_arvores_avl(ArvoreAVL *raiz1, ArvoreAVL *raiz2);
@@ -51,4 +129,14 @@ ArvoreAVL *uniao_arvores_avl(ArvoreAVL *raiz1, ArvoreAVL *raiz2);
 // Realiza a interseção de duas árvores AVL
 ArvoreAVL *intersecao_arvores_avl(ArvoreAVL *raiz1, ArvoreAVL *raiz2);
 
+// União e interseção com as recursões divididas entre "threads" threads (pool com roubo de tarefas)
+ArvoreAVL *uniao_arvores_avl_paralela(ArvoreAVL *arv1, ArvoreAVL *arv2, int threads, int corte);
+ArvoreAVL *intersecao_arvores_avl_paralela(ArvoreAVL *arv1, ArvoreAVL *arv2, int threads, int corte);
+
+// Interseção por buscas: procura cada elemento da árvore menor na maior (para tamanhos muito diferentes)
+ArvoreAVL *intersecao_busca_arvores_avl(ArvoreAVL *menor, ArvoreAVL *maior, int tam_menor);
+
+// Retira da primeira árvore AVL os elementos da segunda (diferença)
+ArvoreAVL *diferenca_arvores_avl(ArvoreAVL *raiz1, ArvoreAVL *raiz2);
+
 #endif
@@ -0,0 +1,668 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "arvore_avl_compacta.h"
+#include "estatisticas.h"
+
+/*
+Árvore AVL compacta
+Os nós não têm ponteiros: ficam todos em um único vetor da árvore e os filhos são índices de 28 bits nesse vetor.
+A altura (8 bits) é repartida entre os 4 bits altos das duas palavras de filhos, então cada nó ocupa 12 bytes
+(chave + duas palavras), metade dos 24 do NO da AVL com ponteiros, e sem cabeçalho de malloc por nó.
+    - O índice 0 é o "nó nulo": uma sentinela com filhos 0 e altura 0 (as folhas têm altura 1)
+    - Nós removidos vão para uma lista de livres encadeada pelo índice esquerdo e são reaproveitados
+    - Como o vetor pode ser realocado ao crescer, nenhuma função guarda ponteiros para nós entre uma alocação e outra, só índices
+*/
+#define NULO 0u
+#define MASCARA_INDICE ((1u << BITS_INDICE) - 1)
+// Altura máxima de uma AVL com 2^28 nós é menor que 1,44 * 28 + 2; a pilha dos percursos tem folga
+#define ALTURA_MAXIMA 64
+
+typedef struct
+{
+    int chave;
+    uint32_t esquerda; // índice do filho esquerdo + 4 bits baixos da altura
+    uint32_t direita;  // índice do filho direito + 4 bits altos da altura
+} NO_COMPACTO;
+
+struct AvlCompacta
+{
+    NO_COMPACTO *nos;
+    uint32_t raiz;
+    uint32_t usados;     // próximo índice nunca usado (começa em 1, depois da sentinela)
+    uint32_t capacidade; // posições alocadas em "nos"
+    uint32_t livres;     // início da lista de nós removidos
+    int tamanho;
+};
+
+/////// CAMPOS DO NÓ ///////
+static uint32_t esquerda(const AVL_COMPACTA *arvore, uint32_t i)
+{
+    return arvore->nos[i].esquerda & MASCARA_INDICE;
+}
+
+static uint32_t direita(const AVL_COMPACTA *arvore, uint32_t i)
+{
+    return arvore->nos[i].direita & MASCARA_INDICE;
+}
+
+static int altura(const AVL_COMPACTA *arvore, uint32_t i)
+{
+    return (int)((arvore->nos[i].esquerda >> BITS_INDICE) | ((arvore->nos[i].direita >> BITS_INDICE) << 4));
+}
+
+static void definir_esquerda(AVL_COMPACTA *arvore, uint32_t i, uint32_t filho)
+{
+    arvore->nos[i].esquerda = (arvore->nos[i].esquerda & ~MASCARA_INDICE) | filho;
+}
+
+static void definir_direita(AVL_COMPACTA *arvore, uint32_t i, uint32_t filho)
+{
+    arvore->nos[i].direita = (arvore->nos[i].direita & ~MASCARA_INDICE) | filho;
+}
+
+static void definir_altura(AVL_COMPACTA *arvore, uint32_t i, int h)
+{
+    arvore->nos[i].esquerda = (arvore->nos[i].esquerda & MASCARA_INDICE) | ((uint32_t)(h & 0xF) << BITS_INDICE);
+    arvore->nos[i].direita = (arvore->nos[i].direita & MASCARA_INDICE) | ((uint32_t)(h >> 4) << BITS_INDICE);
+}
+
+/////// ALOCAÇÃO ///////
+/*
+    Reservar
+    Ideia: garante espaço para "capacidade" nós no vetor (contando a sentinela), dobrando-o quando precisa crescer
+*/
+static bool reservar(AVL_COMPACTA *arvore, uint32_t capacidade)
+{
+    if (capacidade <= arvore->capacidade)
+    {
+        return true;
+    }
+    if (capacidade > MAX_NOS_COMPACTOS)
+    {
+        return false;
+    }
+    uint32_t nova = arvore->capacidade > 0 ? arvore->capacidade : 16;
+    while (nova < capacidade)
+    {
+        nova = nova > MAX_NOS_COMPACTOS / 2 ? MAX_NOS_COMPACTOS : nova * 2;
+    }
+    NO_COMPACTO *nos = (NO_COMPACTO *)realloc(arvore->nos, (size_t)nova * sizeof(NO_COMPACTO));
+    if (nos == NULL)
+    {
+        return false;
+    }
+    arvore->nos = nos;
+    arvore->capacidade = nova;
+    CONTAR(realocacoes, 1);
+    return true;
+}
+
+/*
+    Criar nó
+    Ideia: reaproveita um nó da lista de livres ou usa o próximo nunca usado do vetor. Retorna o índice do nó ou NULO se faltar memória
+*/
+static uint32_t criar_no(AVL_COMPACTA *arvore, int chave)
+{
+    uint32_t i;
+    if (arvore->livres != NULO)
+    {
+        i = arvore->livres;
+        arvore->livres = esquerda(arvore, i);
+    }
+    else
+    {
+        if (!reservar(arvore, arvore->usados + 1))
+        {
+            return NULO;
+        }
+        i = arvore->usados++;
+    }
+    arvore->nos[i].chave = chave;
+    arvore->nos[i].esquerda = NULO;
+    arvore->nos[i].direita = NULO;
+    definir_altura(arvore, i, 1);
+    CONTAR(alocacoes, 1);
+    return i;
+}
+
+static void liberar_no(AVL_COMPACTA *arvore, uint32_t i)
+{
+    arvore->nos[i].esquerda = arvore->livres;
+    arvore->livres = i;
+    CONTAR(liberacoes, 1);
+}
+
+/////// CRIAR E APAGAR ///////
+AVL_COMPACTA *avl_compacta_criar(void)
+{
+    AVL_COMPACTA *arvore = (AVL_COMPACTA *)malloc(sizeof(AVL_COMPACTA));
+    if (arvore == NULL)
+    {
+        return NULL;
+    }
+    arvore->nos = NULL;
+    arvore->capacidade = 0;
+    if (!reservar(arvore, 1))
+    {
+        free(arvore);
+        return NULL;
+    }
+    memset(&arvore->nos[NULO], 0, sizeof(NO_COMPACTO)); // sentinela: filhos nulos e altura 0
+    arvore->raiz = NULO;
+    arvore->usados = 1;
+    arvore->livres = NULO;
+    arvore->tamanho = 0;
+    return arvore;
+}
+
+bool avl_compacta_apagar(AVL_COMPACTA **arvore)
+{
+    if (arvore == NULL || *arvore == NULL)
+    {
+        return false;
+    }
+    free((*arvore)->nos);
+    free(*arvore);
+    *arvore = NULL;
+    return true;
+}
+
+static void atualizar_altura(AVL_COMPACTA *arvore, uint32_t i)
+{
+    int altura_esq = altura(arvore, esquerda(arvore, i));
+    int altura_dir = altura(arvore, direita(arvore, i));
+    definir_altura(arvore, i, 1 + (altura_esq > altura_dir ? altura_esq : altura_dir));
+}
+
+/*
+    Construção balanceada
+    Ideia: o elemento do meio vira a raiz e as metades viram as subárvores, recursivamente (O(n)).
+    Os índices são dados em pré-ordem, então a raiz e os primeiros níveis ficam no começo do vetor
+*/
+static uint32_t construir(AVL_COMPACTA *arvore, const int *ordenado, int inicio, int fim)
+{
+    if (inicio > fim)
+    {
+        return NULO;
+    }
+    int meio = inicio + (fim - inicio) / 2;
+    uint32_t i = arvore->usados++;
+    arvore->nos[i].chave = ordenado[meio];
+    arvore->nos[i].esquerda = NULO;
+    arvore->nos[i].direita = NULO;
+    uint32_t esq = construir(arvore, ordenado, inicio, meio - 1);
+    uint32_t dir = construir(arvore, ordenado, meio + 1, fim);
+    definir_esquerda(arvore, i, esq);
+    definir_direita(arvore, i, dir);
+    atualizar_altura(arvore, i);
+    return i;
+}
+
+AVL_COMPACTA *avl_compacta_criar_de_vetor(const int *ordenado, int n)
+{
+    AVL_COMPACTA *arvore = avl_compacta_criar();
+    if (arvore == NULL)
+    {
+        return NULL;
+    }
+    if (n > 0)
+    {
+        if (!reservar(arvore, (uint32_t)n + 1))
+        {
+            avl_compacta_apagar(&arvore);
+            return NULL;
+        }
+        arvore->raiz = construir(arvore, ordenado, 0, n - 1);
+        arvore->tamanho = n;
+        CONTAR(alocacoes, n);
+    }
+    return arvore;
+}
+
+/////// BALANCEAMENTO ///////
+static int fator_balanceamento(AVL_COMPACTA *arvore, uint32_t i)
+{
+    return altura(arvore, esquerda(arvore, i)) - altura(arvore, direita(arvore, i));
+}
+
+static uint32_t rotacao_direita(AVL_COMPACTA *arvore, uint32_t y)
+{
+    uint32_t x = esquerda(arvore, y);
+    definir_esquerda(arvore, y, direita(arvore, x));
+    definir_direita(arvore, x, y);
+    CONTAR(rotacoes, 1);
+    atualizar_altura(arvore, y);
+    atualizar_altura(arvore, x);
+    return x;
+}
+
+static uint32_t rotacao_esquerda(AVL_COMPACTA *arvore, uint32_t x)
+{
+    uint32_t y = direita(arvore, x);
+    definir_direita(arvore, x, esquerda(arvore, y));
+    definir_esquerda(arvore, y, x);
+    CONTAR(rotacoes, 1);
+    atualizar_altura(arvore, x);
+    atualizar_altura(arvore, y);
+    return y;
+}
+
+/*
+    Balancear
+    Ideia: atualiza a altura do nó e, se a diferença entre as subárvores passou de 1, aplica a rotação simples ou dupla adequada.
+    Retorna o índice da nova raiz da subárvore
+*/
+static uint32_t balancear(AVL_COMPACTA *arvore, uint32_t i)
+{
+    atualizar_altura(arvore, i);
+    int fator = fator_balanceamento(arvore, i);
+    if (fator > 1)
+    {
+        if (fator_balanceamento(arvore, esquerda(arvore, i)) < 0)
+        {
+            definir_esquerda(arvore, i, rotacao_esquerda(arvore, esquerda(arvore, i)));
+        }
+        return rotacao_direita(arvore, i);
+    }
+    if (fator < -1)
+    {
+        if (fator_balanceamento(arvore, direita(arvore, i)) > 0)
+        {
+            definir_direita(arvore, i, rotacao_direita(arvore, direita(arvore, i)));
+        }
+        return rotacao_esquerda(arvore, i);
+    }
+    return i;
+}
+
+/////// INSERÇÃO E REMOÇÃO ///////
+/*
+    Inserir no nó
+    Ideia: a mesma descida recursiva da AVL com ponteiros. O filho é calculado antes de ser gravado no nó,
+    pois criar_no pode realocar o vetor durante a chamada recursiva
+*/
+static uint32_t inserir_no(AVL_COMPACTA *arvore, uint32_t i, int chave, bool *inserido)
+{
+    if (i == NULO)
+    {
+        uint32_t novo = criar_no(arvore, chave);
+        *inserido = novo != NULO;
+        return novo;
+    }
+    int atual = arvore->nos[i].chave;
+    CONTAR(comparacoes, 1);
+    if (chave < atual)
+    {
+        uint32_t filho = inserir_no(arvore, esquerda(arvore, i), chave, inserido);
+        definir_esquerda(arvore, i, filho);
+    }
+    else if (chave > atual)
+    {
+        uint32_t filho = inserir_no(arvore, direita(arvore, i), chave, inserido);
+        definir_direita(arvore, i, filho);
+    }
+    else
+    {
+        return i;
+    }
+    return *inserido ? balancear(arvore, i) : i;
+}
+
+bool avl_compacta_inserir(AVL_COMPACTA *arvore, int chave)
+{
+    if (arvore == NULL)
+    {
+        return false;
+    }
+    bool inserido = false;
+    arvore->raiz = inserir_no(arvore, arvore->raiz, chave, &inserido);
+    arvore->tamanho += inserido;
+    return inserido;
+}
+
+/*
+    Remover no nó
+    Ideia: um nó com no máximo um filho é trocado por esse filho; com dois filhos, recebe a chave do sucessor
+    (o menor da subárvore direita), que é removido da subárvore direita. Na volta, cada nó do caminho é rebalanceado
+*/
+static uint32_t remover_no(AVL_COMPACTA *arvore, uint32_t i, int chave, bool *removido)
+{
+    if (i == NULO)
+    {
+        return NULO;
+    }
+    int atual = arvore->nos[i].chave;
+    CONTAR(comparacoes, 1);
+    if (chave < atual)
+    {
+        definir_esquerda(arvore, i, remover_no(arvore, esquerda(arvore, i), chave, removido));
+    }
+    else if (chave > atual)
+    {
+        definir_direita(arvore, i, remover_no(arvore, direita(arvore, i), chave, removido));
+    }
+    else
+    {
+        *removido = true;
+        uint32_t esq = esquerda(arvore, i), dir = direita(arvore, i);
+        if (esq == NULO || dir == NULO)
+        {
+            liberar_no(arvore, i);
+            return esq != NULO ? esq : dir;
+        }
+        uint32_t sucessor = dir;
+        while (esquerda(arvore, sucessor) != NULO)
+        {
+            sucessor = esquerda(arvore, sucessor);
+        }
+        int chave_sucessor = arvore->nos[sucessor].chave;
+        arvore->nos[i].chave = chave_sucessor;
+        bool ignorado;
+        definir_direita(arvore, i, remover_no(arvore, dir, chave_sucessor, &ignorado));
+    }
+    return *removido ? balancear(arvore, i) : i;
+}
+
+bool avl_compacta_remover(AVL_COMPACTA *arvore, int chave)
+{
+    if (arvore == NULL)
+    {
+        return false;
+    }
+    bool removido = false;
+    arvore->raiz = remover_no(arvore, arvore->raiz, chave, &removido);
+    arvore->tamanho -= removido;
+    return removido;
+}
+
+/////// BUSCA ///////
+/*
+    Escolher filho, função auxiliar do Pertence
+    Ideia: a direção de cada passo da descida é aleatória, então um "if" é errado pelo processador metade das vezes.
+    O filho é escolhido por movimentação condicional (cmov em x86; o gcc não a gera sozinho por causa da máscara do índice)
+    ou, nas outras arquiteturas, por uma máscara de bits
+*/
+static uint32_t escolher_filho(const NO_COMPACTO *no, int chave)
+{
+    uint32_t filho = no->esquerda;
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    __asm__("cmpl %[chave_no], %[chave]\n\tcmovg %[direita], %[filho]"
+            : [filho] "+r"(filho)
+            : [direita] "r"(no->direita), [chave] "r"(chave), [chave_no] "rm"(no->chave)
+            : "cc");
+#else
+    uint32_t mascara = -(uint32_t)(chave > no->chave);
+    filho = (filho & ~mascara) | (no->direita & mascara);
+#endif
+    return filho & MASCARA_INDICE;
+}
+
+/*
+    Pertence
+    Ideia: descida sem recursão; com 12 bytes por nó, cinco nós cabem em uma linha de cache,
+    e os primeiros níveis (do começo do vetor, após a construção em lote) ficam juntos
+*/
+bool avl_compacta_pertence(AVL_COMPACTA *arvore, int chave)
+{
+    if (arvore == NULL)
+    {
+        return false;
+    }
+    uint32_t i = arvore->raiz;
+    while (i != NULO)
+    {
+        const NO_COMPACTO *no = &arvore->nos[i];
+        CONTAR(comparacoes, 1);
+        if (chave == no->chave)
+        {
+            return true;
+        }
+        i = escolher_filho(no, chave);
+    }
+    return false;
+}
+
+/////// PERCURSO EM ORDEM ///////
+// Percurso em ordem simétrica com pilha explícita: a pilha guarda o caminho de nós cujo elemento ainda não foi visitado
+typedef struct
+{
+    uint32_t pilha[ALTURA_MAXIMA];
+    int topo;
+} CURSOR_AVL;
+
+static void descer_esquerda(AVL_COMPACTA *arvore, CURSOR_AVL *cursor, uint32_t i)
+{
+    while (i != NULO)
+    {
+        cursor->pilha[cursor->topo++] = i;
+        i = esquerda(arvore, i);
+    }
+}
+
+static void cursor_iniciar(AVL_COMPACTA *arvore, CURSOR_AVL *cursor)
+{
+    cursor->topo = 0;
+    descer_esquerda(arvore, cursor, arvore->raiz);
+}
+
+// Coloca em "chave" o próximo elemento em ordem crescente; retorna false quando o percurso acabou
+static bool cursor_proximo(AVL_COMPACTA *arvore, CURSOR_AVL *cursor, int *chave)
+{
+    if (cursor->topo == 0)
+    {
+        return false;
+    }
+    uint32_t i = cursor->pilha[--cursor->topo];
+    *chave = arvore->nos[i].chave;
+    descer_esquerda(arvore, cursor, direita(arvore, i));
+    return true;
+}
+
+/*
+    Exportar
+    Parâmetros: árvore e vetor de saída (com espaço para avl_compacta_tamanho elementos)
+    Ideia: percurso em ordem com o cursor, escrevendo as chaves no vetor. Retorna a quantidade de chaves
+*/
+int avl_compacta_exportar(AVL_COMPACTA *arvore, int *saida)
+{
+    int n = 0;
+    if (arvore != NULL)
+    {
+        CURSOR_AVL cursor;
+        cursor_iniciar(arvore, &cursor);
+        while (cursor_proximo(arvore, &cursor, &saida[n]))
+        {
+            n++;
+        }
+    }
+    return n;
+}
+
+int avl_compacta_tamanho(AVL_COMPACTA *arvore)
+{
+    return arvore != NULL ? arvore->tamanho : 0;
+}
+
+// Bytes ocupados pela árvore: a estrutura mais o vetor de nós inteiro (incluindo posições livres e ainda não usadas)
+size_t avl_compacta_memoria(AVL_COMPACTA *arvore)
+{
+    if (arvore == NULL)
+    {
+        return 0;
+    }
+    return sizeof(AVL_COMPACTA) + (size_t)arvore->capacidade * sizeof(NO_COMPACTO);
+}
+
+/////// LOTE ///////
+/*
+    Substituir
+    Ideia: a árvore passa a usar o vetor de nós de "nova" (e a estrutura de "nova" é liberada), para as reconstruções em lote
+*/
+static void substituir(AVL_COMPACTA *arvore, AVL_COMPACTA *nova)
+{
+    free(arvore->nos);
+    *arvore = *nova;
+    free(nova);
+}
+
+/*
+    Inserção em lote
+    Parâmetros: árvore, vetor ordenado sem repetições e seu tamanho
+    Ideia: um lote do tamanho da árvore ou maior é intercalado com o percurso em ordem e a árvore é reconstruída balanceada em O(n + k),
+    o que ainda compacta o vetor (sem nós livres); um lote menor é inserido elemento a elemento
+*/
+int avl_compacta_inserir_lote(AVL_COMPACTA *arvore, const int *ordenado, int k)
+{
+    if (arvore == NULL)
+    {
+        return -1;
+    }
+    if (k > 0 && k >= arvore->tamanho)
+    {
+        int *todas = (int *)malloc(((size_t)arvore->tamanho + k) * sizeof(int));
+        if (todas != NULL)
+        {
+            CURSOR_AVL cursor;
+            int chave, n = 0, j = 0;
+            bool ha_chave;
+            cursor_iniciar(arvore, &cursor);
+            ha_chave = cursor_proximo(arvore, &cursor, &chave);
+            while (ha_chave || j < k)
+            {
+                if (ha_chave && (j == k || chave < ordenado[j]))
+                {
+                    todas[n++] = chave;
+                    ha_chave = cursor_proximo(arvore, &cursor, &chave);
+                }
+                else
+                {
+                    if (ha_chave && chave == ordenado[j])
+                        ha_chave = cursor_proximo(arvore, &cursor, &chave);
+                    todas[n++] = ordenado[j++];
+                }
+            }
+            AVL_COMPACTA *nova = avl_compacta_criar_de_vetor(todas, n);
+            free(todas);
+            if (nova != NULL)
+            {
+                int inseridos = n - arvore->tamanho;
+                substituir(arvore, nova);
+                return inseridos;
+            }
+        }
+    }
+    int inseridos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        inseridos += avl_compacta_inserir(arvore, ordenado[i]);
+    }
+    return inseridos;
+}
+
+int avl_compacta_remover_lote(AVL_COMPACTA *arvore, const int *ordenado, int k)
+{
+    if (arvore == NULL)
+    {
+        return -1;
+    }
+    int removidos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        removidos += avl_compacta_remover(arvore, ordenado[i]);
+    }
+    return removidos;
+}
+
+/////// UNIÃO E INTERSECÇÃO ///////
+/*
+    União
+    Ideia: os dois percursos em ordem são intercalados em um vetor (O(n + m)) e o resultado é construído balanceado dele
+*/
+AVL_COMPACTA *avl_compacta_uniao(AVL_COMPACTA *arvore1, AVL_COMPACTA *arvore2)
+{
+    if (arvore1 == NULL || arvore2 == NULL)
+    {
+        return NULL;
+    }
+    int *saida = (int *)malloc(((size_t)arvore1->tamanho + arvore2->tamanho + 1) * sizeof(int));
+    if (saida == NULL)
+    {
+        return NULL;
+    }
+    CURSOR_AVL a, b;
+    int x, y, n = 0;
+    cursor_iniciar(arvore1, &a);
+    cursor_iniciar(arvore2, &b);
+    bool ha_x = cursor_proximo(arvore1, &a, &x);
+    bool ha_y = cursor_proximo(arvore2, &b, &y);
+    while (ha_x && ha_y)
+    {
+        if (x <= y)
+        {
+            if (x == y)
+                ha_y = cursor_proximo(arvore2, &b, &y);
+            saida[n++] = x;
+            ha_x = cursor_proximo(arvore1, &a, &x);
+        }
+        else
+        {
+            saida[n++] = y;
+            ha_y = cursor_proximo(arvore2, &b, &y);
+        }
+    }
+    for (; ha_x; ha_x = cursor_proximo(arvore1, &a, &x))
+        saida[n++] = x;
+    for (; ha_y; ha_y = cursor_proximo(arvore2, &b, &y))
+        saida[n++] = y;
+
+    AVL_COMPACTA *resultado = avl_compacta_criar_de_vetor(saida, n);
+    free(saida);
+    return resultado;
+}
+
+/*
+    Intersecção
+    Ideia: intercalação dos dois percursos em ordem guardando só os elementos comuns, seguida da construção balanceada
+*/
+AVL_COMPACTA *avl_compacta_intersecao(AVL_COMPACTA *arvore1, AVL_COMPACTA *arvore2)
+{
+    if (arvore1 == NULL || arvore2 == NULL)
+    {
+        return NULL;
+    }
+    int menor = arvore1->tamanho < arvore2->tamanho ? arvore1->tamanho : arvore2->tamanho;
+    int *saida = (int *)malloc(((size_t)menor + 1) * sizeof(int));
+    if (saida == NULL)
+    {
+        return NULL;
+    }
+    CURSOR_AVL a, b;
+    int x, y, n = 0;
+    cursor_iniciar(arvore1, &a);
+    cursor_iniciar(arvore2, &b);
+    bool ha_x = cursor_proximo(arvore1, &a, &x);
+    bool ha_y = cursor_proximo(arvore2, &b, &y);
+    while (ha_x && ha_y)
+    {
+        if (x < y)
+        {
+            ha_x = cursor_proximo(arvore1, &a, &x);
+        }
+        else if (y < x)
+        {
+            ha_y = cursor_proximo(arvore2, &b, &y);
+        }
+        else
+        {
+            saida[n++] = x;
+            ha_x = cursor_proximo(arvore1, &a, &x);
+            ha_y = cursor_proximo(arvore2, &b, &y);
+        }
+    }
+
+    AVL_COMPACTA *resultado = avl_compacta_criar_de_vetor(saida, n);
+    free(saida);
+    return resultado;
+}
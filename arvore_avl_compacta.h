@@ -0,0 +1,25 @@
+#ifndef ARVORE_AVL_COMPACTA_H
+#define ARVORE_AVL_COMPACTA_H
+#include <stddef.h>
+
+// Bits de cada índice de filho; os 4 bits restantes de cada palavra guardam metade da altura do nó
+#define BITS_INDICE 28
+// Quantidade máxima de nós (o índice 0 é reservado para "nenhum nó")
+#define MAX_NOS_COMPACTOS ((1u << BITS_INDICE) - 1)
+
+typedef struct AvlCompacta AVL_COMPACTA;
+
+AVL_COMPACTA *avl_compacta_criar(void);
+AVL_COMPACTA *avl_compacta_criar_de_vetor(const int *ordenado, int n);
+bool avl_compacta_apagar(AVL_COMPACTA **arvore);
+bool avl_compacta_inserir(AVL_COMPACTA *arvore, int chave);
+bool avl_compacta_remover(AVL_COMPACTA *arvore, int chave);
+int avl_compacta_inserir_lote(AVL_COMPACTA *arvore, const int *ordenado, int k);
+int avl_compacta_remover_lote(AVL_COMPACTA *arvore, const int *ordenado, int k);
+bool avl_compacta_pertence(AVL_COMPACTA *arvore, int chave);
+int avl_compacta_tamanho(AVL_COMPACTA *arvore);
+size_t avl_compacta_memoria(AVL_COMPACTA *arvore);
+int avl_compacta_exportar(AVL_COMPACTA *arvore, int *saida);
+AVL_COMPACTA *avl_compacta_uniao(AVL_COMPACTA *arvore1, AVL_COMPACTA *arvore2);
+AVL_COMPACTA *avl_compacta_intersecao(AVL_COMPACTA *arvore1, AVL_COMPACTA *arvore2);
+#endif
@@ -0,0 +1,836 @@
+#define _POSIX_C_SOURCE 200809L // posix_memalign com -std=c99
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "arvore_b.h"
+
+/*
+Árvore B+ em memória
+Cada nó ocupa BYTES_NO_B bytes alinhados a 64 (linha de cache), então uma descida lê poucas linhas por nível
+e a árvore fica com altura baixa (com 4KB, uma folha guarda 1020 chaves e um nó interno tem 341 filhos).
+    - As chaves ficam todas nas folhas, que são encadeadas em ordem crescente: percorrer o conjunto é seguir a lista de folhas
+    - Os nós internos só guardam separadores: o filho i+1 tem todas as chaves >= chaves[i] e o filho i, todas < chaves[i]
+    - Todo nó, exceto a raiz, tem pelo menos metade da capacidade ocupada
+O nível de cada nó é conhecido pela descida (a altura está na árvore), então os nós não precisam de marcador de folha.
+*/
+#define MINIMO_FOLHA (CHAVES_FOLHA_B / 2)
+#define MINIMO_INTERNO (CHAVES_INTERNO_B / 2)
+
+typedef struct FolhaB
+{
+    int quantidade;
+    struct FolhaB *proxima;
+    int chaves[CHAVES_FOLHA_B];
+} FOLHA_B;
+
+typedef struct
+{
+    int quantidade; // filhos = quantidade + 1
+    int chaves[CHAVES_INTERNO_B];
+    void *filhos[CHAVES_INTERNO_B + 1];
+} INTERNO_B;
+
+struct ArvoreB
+{
+    void *raiz;
+    FOLHA_B *primeira; // folha mais à esquerda, início do percurso em ordem
+    int tamanho;
+    int altura; // 1 -> a raiz é uma folha
+};
+
+/////// NÓS ///////
+static void *alocar_no(void)
+{
+    void *no = NULL;
+    return posix_memalign(&no, 64, BYTES_NO_B) == 0 ? no : NULL;
+}
+
+static FOLHA_B *criar_folha(void)
+{
+    FOLHA_B *folha = (FOLHA_B *)alocar_no();
+    if (folha != NULL)
+    {
+        folha->quantidade = 0;
+        folha->proxima = NULL;
+    }
+    return folha;
+}
+
+static INTERNO_B *criar_interno(void)
+{
+    INTERNO_B *interno = (INTERNO_B *)alocar_no();
+    if (interno != NULL)
+    {
+        interno->quantidade = 0;
+    }
+    return interno;
+}
+
+// Primeira posição com chave >= x
+static int limite_inferior(const int *chaves, int n, int x)
+{
+    int inicio = 0, fim = n;
+    while (inicio < fim)
+    {
+        int meio = (inicio + fim) / 2;
+        if (chaves[meio] < x)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+// Primeira posição com chave > x, que é o índice do filho onde x deve estar
+static int limite_superior(const int *chaves, int n, int x)
+{
+    int inicio = 0, fim = n;
+    while (inicio < fim)
+    {
+        int meio = (inicio + fim) / 2;
+        if (chaves[meio] <= x)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+/*
+    Apagar nó
+    Ideia: os nós internos são percorridos recursivamente (a recursão tem a profundidade da altura, que é pequena)
+    e as folhas são liberadas no último nível
+*/
+static void apagar_no(void *no, int nivel)
+{
+    if (nivel > 1)
+    {
+        INTERNO_B *interno = (INTERNO_B *)no;
+        for (int i = 0; i <= interno->quantidade; i++)
+        {
+            apagar_no(interno->filhos[i], nivel - 1);
+        }
+    }
+    free(no);
+}
+
+/////// CRIAR E APAGAR ///////
+ARVORE_B *arvore_b_criar(void)
+{
+    ARVORE_B *arvore = (ARVORE_B *)malloc(sizeof(ARVORE_B));
+    if (arvore == NULL)
+    {
+        return NULL;
+    }
+    arvore->primeira = criar_folha();
+    if (arvore->primeira == NULL)
+    {
+        free(arvore);
+        return NULL;
+    }
+    arvore->raiz = arvore->primeira;
+    arvore->tamanho = 0;
+    arvore->altura = 1;
+    return arvore;
+}
+
+bool arvore_b_apagar(ARVORE_B **arvore)
+{
+    if (arvore == NULL || *arvore == NULL)
+    {
+        return false;
+    }
+    apagar_no((*arvore)->raiz, (*arvore)->altura);
+    free(*arvore);
+    *arvore = NULL;
+    return true;
+}
+
+/*
+    Construção a partir de vetor ordenado
+    Parâmetros: árvore (vazia, sem raiz), vetor ordenado sem repetições e seu tamanho
+    Ideia: monta as folhas da esquerda para a direita e depois cada nível interno sobre o anterior, em O(n).
+    As chaves (e depois os filhos) são divididas igualmente entre os nós do nível, então nenhum nó fica abaixo da metade.
+    O vetor "minimos" guarda a menor chave de cada nó do nível atual, que vira o separador no nível de cima
+*/
+static bool construir(ARVORE_B *arvore, const int *ordenado, int n)
+{
+    int folhas = n > 0 ? (n + CHAVES_FOLHA_B - 1) / CHAVES_FOLHA_B : 1;
+    void **nos = (void **)malloc(folhas * sizeof(void *));
+    int *minimos = (int *)malloc(folhas * sizeof(int));
+    if (nos == NULL || minimos == NULL)
+    {
+        free(nos);
+        free(minimos);
+        return false;
+    }
+
+    int usados = 0, quantidade = 0;
+    FOLHA_B *anterior = NULL;
+    for (int i = 0; i < folhas; i++)
+    {
+        FOLHA_B *folha = criar_folha();
+        if (folha == NULL)
+        {
+            while (quantidade > 0)
+                free(nos[--quantidade]);
+            free(nos);
+            free(minimos);
+            return false;
+        }
+        int k = n / folhas + (i < n % folhas);
+        memcpy(folha->chaves, ordenado + usados, k * sizeof(int));
+        folha->quantidade = k;
+        minimos[i] = k > 0 ? ordenado[usados] : 0;
+        usados += k;
+        if (anterior != NULL)
+            anterior->proxima = folha;
+        anterior = folha;
+        nos[quantidade++] = folha;
+    }
+    arvore->primeira = (FOLHA_B *)nos[0];
+    arvore->altura = 1;
+
+    // Cada nível interno é escrito sobre o começo dos próprios vetores: o pai j só lê filhos de posições >= j
+    while (quantidade > 1)
+    {
+        int pais = (quantidade + CHAVES_INTERNO_B) / (CHAVES_INTERNO_B + 1);
+        int lido = 0;
+        for (int j = 0; j < pais; j++)
+        {
+            INTERNO_B *interno = criar_interno();
+            if (interno == NULL)
+            {
+                // Os nós já montados deste nível e os ainda não lidos do anterior são liberados
+                for (int p = 0; p < j; p++)
+                    apagar_no(nos[p], arvore->altura + 1);
+                for (int p = lido; p < quantidade; p++)
+                    apagar_no(nos[p], arvore->altura);
+                free(nos);
+                free(minimos);
+                return false;
+            }
+            int k = quantidade / pais + (j < quantidade % pais);
+            int minimo = minimos[lido];
+            for (int c = 0; c < k; c++)
+            {
+                interno->filhos[c] = nos[lido + c];
+                if (c > 0)
+                    interno->chaves[c - 1] = minimos[lido + c];
+            }
+            interno->quantidade = k - 1;
+            lido += k;
+            nos[j] = interno;
+            minimos[j] = minimo;
+        }
+        quantidade = pais;
+        arvore->altura++;
+    }
+
+    arvore->raiz = nos[0];
+    arvore->tamanho = n;
+    free(nos);
+    free(minimos);
+    return true;
+}
+
+ARVORE_B *arvore_b_criar_de_vetor(const int *ordenado, int n)
+{
+    ARVORE_B *arvore = (ARVORE_B *)malloc(sizeof(ARVORE_B));
+    if (arvore == NULL)
+    {
+        return NULL;
+    }
+    if (!construir(arvore, ordenado, n))
+    {
+        free(arvore);
+        return NULL;
+    }
+    return arvore;
+}
+
+/////// BUSCA ///////
+/*
+    Pertence
+    Ideia: desce sem recursão escolhendo em cada nó interno o filho por busca binária nos separadores;
+    na folha, uma busca binária decide
+*/
+bool arvore_b_pertence(ARVORE_B *arvore, int chave)
+{
+    if (arvore == NULL)
+    {
+        return false;
+    }
+    void *no = arvore->raiz;
+    for (int nivel = arvore->altura; nivel > 1; nivel--)
+    {
+        INTERNO_B *interno = (INTERNO_B *)no;
+        no = interno->filhos[limite_superior(interno->chaves, interno->quantidade, chave)];
+    }
+    FOLHA_B *folha = (FOLHA_B *)no;
+    int i = limite_inferior(folha->chaves, folha->quantidade, chave);
+    return i < folha->quantidade && folha->chaves[i] == chave;
+}
+
+/////// INSERÇÃO ///////
+/*
+    Inserir na folha
+    Ideia: desloca as chaves maiores e coloca a nova. Se a folha está cheia, ela é dividida ao meio:
+    a metade de cima vai para uma nova folha, encadeada logo após a atual, e a menor chave dela sobe como separador.
+    Retorna 0 se a chave já existia, 1 se foi inserida, 2 se foi inserida e a folha dividida, -1 se faltou memória
+*/
+static int inserir_folha(FOLHA_B *folha, int chave, int *separador, void **novo)
+{
+    int q = folha->quantidade;
+    int i = limite_inferior(folha->chaves, q, chave);
+    if (i < q && folha->chaves[i] == chave)
+    {
+        return 0;
+    }
+    if (q < CHAVES_FOLHA_B)
+    {
+        memmove(&folha->chaves[i + 1], &folha->chaves[i], (q - i) * sizeof(int));
+        folha->chaves[i] = chave;
+        folha->quantidade++;
+        return 1;
+    }
+
+    FOLHA_B *nova = criar_folha();
+    if (nova == NULL)
+    {
+        return -1;
+    }
+    int metade = (CHAVES_FOLHA_B + 1) / 2; // chaves que ficam na folha da esquerda
+    if (i < metade)
+    {
+        nova->quantidade = CHAVES_FOLHA_B - metade + 1;
+        memcpy(nova->chaves, &folha->chaves[metade - 1], nova->quantidade * sizeof(int));
+        memmove(&folha->chaves[i + 1], &folha->chaves[i], (metade - 1 - i) * sizeof(int));
+        folha->chaves[i] = chave;
+    }
+    else
+    {
+        nova->quantidade = CHAVES_FOLHA_B - metade;
+        memcpy(nova->chaves, &folha->chaves[metade], nova->quantidade * sizeof(int));
+        int j = i - metade;
+        memmove(&nova->chaves[j + 1], &nova->chaves[j], (nova->quantidade - j) * sizeof(int));
+        nova->chaves[j] = chave;
+        nova->quantidade++;
+    }
+    folha->quantidade = metade;
+    nova->proxima = folha->proxima;
+    folha->proxima = nova;
+    *separador = nova->chaves[0];
+    *novo = nova;
+    return 2;
+}
+
+/*
+    Inserir no nó
+    Parâmetros: nó, nível do nó (1 = folha), chave e saídas para o separador e o novo irmão em caso de divisão
+    Ideia: desce até a folha; se o filho se dividiu, o separador e o novo filho entram neste nó.
+    Um nó interno cheio é dividido em dois e a chave do meio sobe (diferente da folha, ela não fica em nenhum dos dois).
+    Retorno igual ao de inserir_folha
+*/
+static int inserir_no(void *no, int nivel, int chave, int *separador, void **novo)
+{
+    if (nivel == 1)
+    {
+        return inserir_folha((FOLHA_B *)no, chave, separador, novo);
+    }
+    INTERNO_B *interno = (INTERNO_B *)no;
+    int q = interno->quantidade;
+    int i = limite_superior(interno->chaves, q, chave);
+    // Um nó cheio já reserva o irmão antes de descer, para que a falta de memória não deixe um filho dividido sem pai
+    INTERNO_B *irmao = NULL;
+    if (q == CHAVES_INTERNO_B && (irmao = criar_interno()) == NULL)
+    {
+        return -1;
+    }
+    int separador_filho;
+    void *novo_filho;
+    int resultado = inserir_no(interno->filhos[i], nivel - 1, chave, &separador_filho, &novo_filho);
+    if (resultado != 2)
+    {
+        free(irmao);
+        return resultado;
+    }
+
+    if (q < CHAVES_INTERNO_B)
+    {
+        memmove(&interno->chaves[i + 1], &interno->chaves[i], (q - i) * sizeof(int));
+        memmove(&interno->filhos[i + 2], &interno->filhos[i + 1], (q - i) * sizeof(void *));
+        interno->chaves[i] = separador_filho;
+        interno->filhos[i + 1] = novo_filho;
+        interno->quantidade++;
+        return 1;
+    }
+
+    // Monta a sequência completa (CHAVES_INTERNO_B + 1 chaves) e a reparte
+    int chaves[CHAVES_INTERNO_B + 1];
+    void *filhos[CHAVES_INTERNO_B + 2];
+    memcpy(chaves, interno->chaves, i * sizeof(int));
+    chaves[i] = separador_filho;
+    memcpy(&chaves[i + 1], &interno->chaves[i], (q - i) * sizeof(int));
+    memcpy(filhos, interno->filhos, (i + 1) * sizeof(void *));
+    filhos[i + 1] = novo_filho;
+    memcpy(&filhos[i + 2], &interno->filhos[i + 1], (q - i) * sizeof(void *));
+
+    int meio = (CHAVES_INTERNO_B + 1) / 2;
+    interno->quantidade = meio;
+    memcpy(interno->chaves, chaves, meio * sizeof(int));
+    memcpy(interno->filhos, filhos, (meio + 1) * sizeof(void *));
+    irmao->quantidade = CHAVES_INTERNO_B - meio;
+    memcpy(irmao->chaves, &chaves[meio + 1], irmao->quantidade * sizeof(int));
+    memcpy(irmao->filhos, &filhos[meio + 1], (irmao->quantidade + 1) * sizeof(void *));
+    *separador = chaves[meio];
+    *novo = irmao;
+    return 2;
+}
+
+/*
+    Inserir
+    Ideia: se a raiz se divide, uma nova raiz com os dois pedaços é colocada acima e a altura cresce um nível
+*/
+bool arvore_b_inserir(ARVORE_B *arvore, int chave)
+{
+    if (arvore == NULL)
+    {
+        return false;
+    }
+    // Só uma raiz cheia pode se dividir; nesse caso a nova raiz é reservada antes
+    int cheia = arvore->altura == 1 ? CHAVES_FOLHA_B : CHAVES_INTERNO_B;
+    INTERNO_B *raiz = NULL;
+    if (*(int *)arvore->raiz == cheia && (raiz = criar_interno()) == NULL)
+    {
+        return false;
+    }
+    int separador;
+    void *novo;
+    int resultado = inserir_no(arvore->raiz, arvore->altura, chave, &separador, &novo);
+    if (resultado != 2)
+    {
+        free(raiz);
+    }
+    if (resultado <= 0)
+    {
+        return false;
+    }
+    if (resultado == 2)
+    {
+        raiz->quantidade = 1;
+        raiz->chaves[0] = separador;
+        raiz->filhos[0] = arvore->raiz;
+        raiz->filhos[1] = novo;
+        arvore->raiz = raiz;
+        arvore->altura++;
+    }
+    arvore->tamanho++;
+    return true;
+}
+
+/////// REMOÇÃO ///////
+/*
+    Juntar filhos
+    Parâmetros: pai, posição k e nível dos filhos
+    Ideia: o filho k+1 é despejado no filho k e liberado; o separador entre eles sai do pai.
+    Entre folhas o separador some; entre nós internos ele desce para ligar o último filho da esquerda ao primeiro da direita
+*/
+static void juntar_filhos(INTERNO_B *pai, int k, int nivel)
+{
+    if (nivel == 1)
+    {
+        FOLHA_B *esquerda = (FOLHA_B *)pai->filhos[k];
+        FOLHA_B *direita = (FOLHA_B *)pai->filhos[k + 1];
+        memcpy(&esquerda->chaves[esquerda->quantidade], direita->chaves, direita->quantidade * sizeof(int));
+        esquerda->quantidade += direita->quantidade;
+        esquerda->proxima = direita->proxima;
+        free(direita);
+    }
+    else
+    {
+        INTERNO_B *esquerda = (INTERNO_B *)pai->filhos[k];
+        INTERNO_B *direita = (INTERNO_B *)pai->filhos[k + 1];
+        int q = esquerda->quantidade;
+        esquerda->chaves[q] = pai->chaves[k];
+        memcpy(&esquerda->chaves[q + 1], direita->chaves, direita->quantidade * sizeof(int));
+        memcpy(&esquerda->filhos[q + 1], direita->filhos, (direita->quantidade + 1) * sizeof(void *));
+        esquerda->quantidade += 1 + direita->quantidade;
+        free(direita);
+    }
+    memmove(&pai->chaves[k], &pai->chaves[k + 1], (pai->quantidade - k - 1) * sizeof(int));
+    memmove(&pai->filhos[k + 1], &pai->filhos[k + 2], (pai->quantidade - k - 1) * sizeof(void *));
+    pai->quantidade--;
+}
+
+/*
+    Corrigir filho
+    Parâmetros: pai, posição i do filho que ficou abaixo da metade e nível do filho
+    Ideia: se um irmão vizinho tem chaves de sobra, uma passa para o filho (nas folhas direto, nos internos girando pelo separador do pai);
+    senão, o filho é juntado a um irmão (a soma cabe em um nó, pois os dois estão na metade ou abaixo)
+*/
+static void corrigir_filho(INTERNO_B *pai, int i, int nivel)
+{
+    int minimo = nivel == 1 ? MINIMO_FOLHA : MINIMO_INTERNO;
+    int irmao_esquerdo = i > 0 ? *(int *)pai->filhos[i - 1] : 0;      // quantidade é o primeiro campo dos dois tipos de nó
+    int irmao_direito = i < pai->quantidade ? *(int *)pai->filhos[i + 1] : 0;
+
+    if (nivel == 1)
+    {
+        FOLHA_B *filho = (FOLHA_B *)pai->filhos[i];
+        if (irmao_esquerdo > minimo)
+        {
+            FOLHA_B *esquerda = (FOLHA_B *)pai->filhos[i - 1];
+            memmove(&filho->chaves[1], filho->chaves, filho->quantidade * sizeof(int));
+            filho->chaves[0] = esquerda->chaves[--esquerda->quantidade];
+            filho->quantidade++;
+            pai->chaves[i - 1] = filho->chaves[0];
+            return;
+        }
+        if (irmao_direito > minimo)
+        {
+            FOLHA_B *direita = (FOLHA_B *)pai->filhos[i + 1];
+            filho->chaves[filho->quantidade++] = direita->chaves[0];
+            memmove(direita->chaves, &direita->chaves[1], --direita->quantidade * sizeof(int));
+            pai->chaves[i] = direita->chaves[0];
+            return;
+        }
+    }
+    else
+    {
+        INTERNO_B *filho = (INTERNO_B *)pai->filhos[i];
+        if (irmao_esquerdo > minimo)
+        {
+            INTERNO_B *esquerda = (INTERNO_B *)pai->filhos[i - 1];
+            memmove(&filho->chaves[1], filho->chaves, filho->quantidade * sizeof(int));
+            memmove(&filho->filhos[1], filho->filhos, (filho->quantidade + 1) * sizeof(void *));
+            filho->chaves[0] = pai->chaves[i - 1];
+            filho->filhos[0] = esquerda->filhos[esquerda->quantidade];
+            filho->quantidade++;
+            pai->chaves[i - 1] = esquerda->chaves[--esquerda->quantidade];
+            return;
+        }
+        if (irmao_direito > minimo)
+        {
+            INTERNO_B *direita = (INTERNO_B *)pai->filhos[i + 1];
+            filho->chaves[filho->quantidade] = pai->chaves[i];
+            filho->filhos[filho->quantidade + 1] = direita->filhos[0];
+            filho->quantidade++;
+            pai->chaves[i] = direita->chaves[0];
+            memmove(direita->chaves, &direita->chaves[1], (direita->quantidade - 1) * sizeof(int));
+            memmove(direita->filhos, &direita->filhos[1], direita->quantidade * sizeof(void *));
+            direita->quantidade--;
+            return;
+        }
+    }
+    juntar_filhos(pai, i > 0 ? i - 1 : i, nivel);
+}
+
+/*
+    Remover no nó
+    Ideia: desce até a folha e retira a chave; na volta, cada filho que ficou abaixo da metade é corrigido pelo pai.
+    Os separadores não precisam ser atualizados na remoção: continuam separando corretamente as subárvores
+*/
+static bool remover_no(void *no, int nivel, int chave)
+{
+    if (nivel == 1)
+    {
+        FOLHA_B *folha = (FOLHA_B *)no;
+        int i = limite_inferior(folha->chaves, folha->quantidade, chave);
+        if (i >= folha->quantidade || folha->chaves[i] != chave)
+        {
+            return false;
+        }
+        memmove(&folha->chaves[i], &folha->chaves[i + 1], (folha->quantidade - i - 1) * sizeof(int));
+        folha->quantidade--;
+        return true;
+    }
+    INTERNO_B *interno = (INTERNO_B *)no;
+    int i = limite_superior(interno->chaves, interno->quantidade, chave);
+    if (!remover_no(interno->filhos[i], nivel - 1, chave))
+    {
+        return false;
+    }
+    int minimo = nivel - 1 == 1 ? MINIMO_FOLHA : MINIMO_INTERNO;
+    if (*(int *)interno->filhos[i] < minimo)
+    {
+        corrigir_filho(interno, i, nivel - 1);
+    }
+    return true;
+}
+
+/*
+    Remover
+    Ideia: se a raiz interna fica com um só filho, esse filho vira a raiz e a altura diminui um nível
+*/
+bool arvore_b_remover(ARVORE_B *arvore, int chave)
+{
+    if (arvore == NULL || !remover_no(arvore->raiz, arvore->altura, chave))
+    {
+        return false;
+    }
+    arvore->tamanho--;
+    if (arvore->altura > 1 && ((INTERNO_B *)arvore->raiz)->quantidade == 0)
+    {
+        INTERNO_B *raiz = (INTERNO_B *)arvore->raiz;
+        arvore->raiz = raiz->filhos[0];
+        arvore->altura--;
+        free(raiz);
+    }
+    return true;
+}
+
+/////// PERCURSO EM ORDEM ///////
+// Posição corrente no encadeamento de folhas
+typedef struct
+{
+    FOLHA_B *folha;
+    int posicao;
+} CURSOR_B;
+
+// Avança para a próxima folha quando a atual acabou (só a raiz-folha de uma árvore vazia tem 0 chaves)
+static void cursor_ajustar(CURSOR_B *cursor)
+{
+    while (cursor->folha != NULL && cursor->posicao >= cursor->folha->quantidade)
+    {
+        cursor->folha = cursor->folha->proxima;
+        cursor->posicao = 0;
+    }
+}
+
+static void cursor_iniciar(CURSOR_B *cursor, ARVORE_B *arvore)
+{
+    cursor->folha = arvore->primeira;
+    cursor->posicao = 0;
+    cursor_ajustar(cursor);
+}
+
+static int cursor_valor(CURSOR_B *cursor)
+{
+    return cursor->folha->chaves[cursor->posicao];
+}
+
+static void cursor_avancar(CURSOR_B *cursor)
+{
+    cursor->posicao++;
+    cursor_ajustar(cursor);
+}
+
+/*
+    Intercalar com lote
+    Ideia: une a sequência das folhas com um vetor ordenado em "saida", como na união de duas listas ordenadas.
+    Retorna o tamanho da saída
+*/
+static int intercalar(ARVORE_B *arvore, const int *ordenado, int k, int *saida)
+{
+    CURSOR_B cursor;
+    cursor_iniciar(&cursor, arvore);
+    int n = 0, j = 0;
+    while (cursor.folha != NULL && j < k)
+    {
+        int x = cursor_valor(&cursor);
+        if (x < ordenado[j])
+        {
+            saida[n++] = x;
+            cursor_avancar(&cursor);
+        }
+        else
+        {
+            if (x == ordenado[j])
+                cursor_avancar(&cursor);
+            saida[n++] = ordenado[j++];
+        }
+    }
+    for (; cursor.folha != NULL; cursor_avancar(&cursor))
+        saida[n++] = cursor_valor(&cursor);
+    while (j < k)
+        saida[n++] = ordenado[j++];
+    return n;
+}
+
+/*
+    Impressão
+    Ideia: sem recursão nem pilha; basta seguir o encadeamento das folhas a partir da primeira
+*/
+/*
+    Exportar
+    Parâmetros: árvore e vetor de saída (com espaço para arvore_b_tamanho elementos)
+    Ideia: copia as chaves de cada folha, seguindo o encadeamento das folhas. Retorna a quantidade de chaves
+*/
+int arvore_b_exportar(ARVORE_B *arvore, int *saida)
+{
+    int n = 0;
+    for (FOLHA_B *folha = arvore != NULL ? arvore->primeira : NULL; folha != NULL; folha = folha->proxima)
+    {
+        memcpy(saida + n, folha->chaves, folha->quantidade * sizeof(int));
+        n += folha->quantidade;
+    }
+    return n;
+}
+
+int arvore_b_tamanho(ARVORE_B *arvore)
+{
+    return arvore != NULL ? arvore->tamanho : 0;
+}
+
+int arvore_b_altura(ARVORE_B *arvore)
+{
+    return arvore != NULL ? arvore->altura : 0;
+}
+
+/////// LOTE ///////
+/*
+    Inserção em lote
+    Parâmetros: árvore, vetor ordenado sem repetições e seu tamanho
+    Ideia: um lote pequeno é inserido chave a chave (por estar ordenado, as descidas seguidas reaproveitam os mesmos nós na cache);
+    um lote do tamanho da árvore ou maior é intercalado com as folhas e a árvore é reconstruída em O(n + k)
+*/
+int arvore_b_inserir_lote(ARVORE_B *arvore, const int *ordenado, int k)
+{
+    if (arvore == NULL)
+    {
+        return -1;
+    }
+    if (k >= arvore->tamanho && k > 0)
+    {
+        int *todas = (int *)malloc((arvore->tamanho + k) * sizeof(int));
+        if (todas != NULL)
+        {
+            int antes = arvore->tamanho;
+            int n = intercalar(arvore, ordenado, k, todas);
+            ARVORE_B nova;
+            if (construir(&nova, todas, n))
+            {
+                apagar_no(arvore->raiz, arvore->altura);
+                *arvore = nova;
+                free(todas);
+                return n - antes;
+            }
+            free(todas);
+        }
+    }
+    int inseridos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        inseridos += arvore_b_inserir(arvore, ordenado[i]);
+    }
+    return inseridos;
+}
+
+int arvore_b_remover_lote(ARVORE_B *arvore, const int *ordenado, int k)
+{
+    if (arvore == NULL)
+    {
+        return -1;
+    }
+    int removidos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        removidos += arvore_b_remover(arvore, ordenado[i]);
+    }
+    return removidos;
+}
+
+/////// UNIÃO E INTERSECÇÃO ///////
+/*
+    União
+    Ideia: as duas sequências de folhas são intercaladas em um vetor (O(n + m), lendo a memória em ordem)
+    e a árvore resultado é construída dele já com os nós cheios
+*/
+ARVORE_B *arvore_b_uniao(ARVORE_B *arvore1, ARVORE_B *arvore2)
+{
+    if (arvore1 == NULL || arvore2 == NULL)
+    {
+        return NULL;
+    }
+    int *saida = (int *)malloc((arvore1->tamanho + arvore2->tamanho + 1) * sizeof(int));
+    if (saida == NULL)
+    {
+        return NULL;
+    }
+    CURSOR_B a, b;
+    cursor_iniciar(&a, arvore1);
+    cursor_iniciar(&b, arvore2);
+    int n = 0;
+    while (a.folha != NULL && b.folha != NULL)
+    {
+        int x = cursor_valor(&a), y = cursor_valor(&b);
+        if (x <= y)
+        {
+            saida[n++] = x;
+            cursor_avancar(&a);
+            if (x == y)
+                cursor_avancar(&b);
+        }
+        else
+        {
+            saida[n++] = y;
+            cursor_avancar(&b);
+        }
+    }
+    for (; a.folha != NULL; cursor_avancar(&a))
+        saida[n++] = cursor_valor(&a);
+    for (; b.folha != NULL; cursor_avancar(&b))
+        saida[n++] = cursor_valor(&b);
+
+    ARVORE_B *resultado = arvore_b_criar_de_vetor(saida, n);
+    free(saida);
+    return resultado;
+}
+
+/*
+    Intersecção
+    Ideia: intercalação das folhas, mas uma folha inteira é pulada quando sua maior chave é menor que a chave corrente da outra árvore,
+    o que evita comparar elemento a elemento trechos sem nenhuma chave em comum
+*/
+ARVORE_B *arvore_b_intersecao(ARVORE_B *arvore1, ARVORE_B *arvore2)
+{
+    if (arvore1 == NULL || arvore2 == NULL)
+    {
+        return NULL;
+    }
+    int menor = arvore1->tamanho < arvore2->tamanho ? arvore1->tamanho : arvore2->tamanho;
+    int *saida = (int *)malloc((menor + 1) * sizeof(int));
+    if (saida == NULL)
+    {
+        return NULL;
+    }
+    CURSOR_B a, b;
+    cursor_iniciar(&a, arvore1);
+    cursor_iniciar(&b, arvore2);
+    int n = 0;
+    while (a.folha != NULL && b.folha != NULL)
+    {
+        int x = cursor_valor(&a), y = cursor_valor(&b);
+        if (a.folha->chaves[a.folha->quantidade - 1] < y)
+        {
+            a.folha = a.folha->proxima;
+            a.posicao = 0;
+            cursor_ajustar(&a);
+        }
+        else if (b.folha->chaves[b.folha->quantidade - 1] < x)
+        {
+            b.folha = b.folha->proxima;
+            b.posicao = 0;
+            cursor_ajustar(&b);
+        }
+        else if (x < y)
+        {
+            cursor_avancar(&a);
+        }
+        else if (y < x)
+        {
+            cursor_avancar(&b);
+        }
+        else
+        {
+            saida[n++] = x;
+            cursor_avancar(&a);
+            cursor_avancar(&b);
+        }
+    }
+
+    ARVORE_B *resultado = arvore_b_criar_de_vetor(saida, n);
+    free(saida);
+    return resultado;
+}
@@ -0,0 +1,29 @@
+#ifndef ARVORE_B_H
+#define ARVORE_B_H
+
+// Tamanho de cada nó em bytes: múltiplo de 64 (linha de cache); o padrão é uma página de 4KB
+#ifndef BYTES_NO_B
+#define BYTES_NO_B 4096
+#endif
+
+// Quantas chaves cabem em uma folha (cabeçalho + ponteiro para a próxima folha + chaves)
+#define CHAVES_FOLHA_B ((BYTES_NO_B - 2 * (int)sizeof(int) - (int)sizeof(void *)) / (int)sizeof(int))
+// Quantas chaves cabem em um nó interno (cabeçalho + chaves + um filho a mais que as chaves)
+#define CHAVES_INTERNO_B ((BYTES_NO_B - 2 * (int)sizeof(int) - (int)sizeof(void *)) / ((int)sizeof(int) + (int)sizeof(void *)))
+
+typedef struct ArvoreB ARVORE_B;
+
+ARVORE_B *arvore_b_criar(void);
+ARVORE_B *arvore_b_criar_de_vetor(const int *ordenado, int n);
+bool arvore_b_apagar(ARVORE_B **arvore);
+bool arvore_b_inserir(ARVORE_B *arvore, int chave);
+bool arvore_b_remover(ARVORE_B *arvore, int chave);
+int arvore_b_inserir_lote(ARVORE_B *arvore, const int *ordenado, int k);
+int arvore_b_remover_lote(ARVORE_B *arvore, const int *ordenado, int k);
+bool arvore_b_pertence(ARVORE_B *arvore, int chave);
+int arvore_b_tamanho(ARVORE_B *arvore);
+int arvore_b_altura(ARVORE_B *arvore);
+int arvore_b_exportar(ARVORE_B *arvore, int *saida);
+ARVORE_B *arvore_b_uniao(ARVORE_B *arvore1, ARVORE_B *arvore2);
+ARVORE_B *arvore_b_intersecao(ARVORE_B *arvore1, ARVORE_B *arvore2);
+#endif
@@ -0,0 +1,431 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime e getopt com -std=c99
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <stdint.h>
+#include <time.h>
+#include <unistd.h>
+#include "conjunto.h"
+
+/*
+    Benchmark dos tipos de Conjunto
+    Uso: ./benchmark [-f csv|json] [-e expoente_min] [-E expoente_max] [-t tipos] [-d distribuicoes] [-r razoes] [-o orcamento_ms] [-s semente]
+        -f: formato da saída (padrão csv), sempre no stdout; o progresso vai para o stderr
+        -e, -E: tamanhos de 10^e a 10^E (padrão 2 a 6; até 8, se houver memória)
+        -t: tipos separados por vírgula (padrão 0,1,2,3,4,5,6,7)
+        -d: distribuições separadas por vírgula (padrão sequencial,uniforme,agrupada)
+        -r: razões de tamanho |A|/|B| da união e da interseção, separadas por vírgula (padrão 1,100)
+        -o: orçamento de tempo de cada medição, em milissegundos (padrão 200)
+        -s: semente do gerador (padrão 1), para repetir as mesmas chaves entre execuções
+
+    Cada linha da saída é uma medição (tipo, distribuição, tamanho, razão, operação) com:
+        - operacoes: quantas operações foram medidas (limitadas pelo orçamento de tempo)
+        - ns_op e ops_s: média e vazão no total
+        - p50, p90 e p99: percentis do ns/op das amostras. Em inserir, remover e pertence cada amostra é um lote de
+          TAMANHO_LOTE operações (uma chamada custa menos que a resolução do relógio); na união e na interseção é uma
+          repetição inteira, e o ns/op é por elemento de entrada (|A| + |B|)
+*/
+
+#define TAMANHO_LOTE 64
+#define MAXIMO_OPERACOES 1000000
+#define MAXIMO_REPETICOES 31
+#define TAMANHO_GRUPO 1024       // elementos consecutivos em cada grupo da distribuição agrupada
+#define LIMITE_CHAVES (1 << 29) // as chaves geradas ficam em [0, 2^29); a chave gravada é 2 * chave (+ 1)
+
+static const char *nomes_tipos[] = {"avl", "lista", "mapa_bits", "tabela_hash", "arvore_b", "avl_compacta", "automatico", "lista_blocos"};
+static const char *nomes_distribuicoes[] = {"sequencial", "uniforme", "agrupada"};
+#define QUANTIDADE_TIPOS 8
+#define QUANTIDADE_DISTRIBUICOES 3
+
+typedef struct
+{
+    bool json;
+    int expoente_min, expoente_max;
+    bool tipos[QUANTIDADE_TIPOS];
+    bool distribuicoes[QUANTIDADE_DISTRIBUICOES];
+    int razoes[8];
+    int quantidade_razoes;
+    double orcamento;
+    uint64_t semente;
+} OPCOES;
+
+typedef struct
+{
+    long operacoes;
+    double segundos;
+    double *amostras; // ns/op de cada amostra
+    int quantidade_amostras;
+} MEDICAO;
+
+static bool primeira_linha = true;
+
+static double agora(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return t.tv_sec + t.tv_nsec * 1e-9;
+}
+
+// xorshift64*: rápido e reprodutível a partir da semente
+static uint64_t estado_aleatorio;
+static uint64_t aleatorio(void)
+{
+    estado_aleatorio ^= estado_aleatorio >> 12;
+    estado_aleatorio ^= estado_aleatorio << 25;
+    estado_aleatorio ^= estado_aleatorio >> 27;
+    return estado_aleatorio * 2685821657736338717ULL;
+}
+
+static void embaralhar(int *vetor, long n)
+{
+    for (long i = n - 1; i > 0; i--)
+    {
+        long j = (long)(aleatorio() % (uint64_t)(i + 1));
+        int troca = vetor[i];
+        vetor[i] = vetor[j];
+        vetor[j] = troca;
+    }
+}
+
+/*
+    Gerar chaves
+    Parâmetros: distribuição, quantidade, paridade (0 para as chaves do conjunto base, 1 para chaves que não estão nele) e o vetor de saída
+    Ideia: a chave gerada c vira 2c + paridade, então as chaves ímpares nunca estão no conjunto base, e os dois grupos
+    seguem a mesma distribuição
+        - sequencial: 0, 1, 2, ...
+        - uniforme: sorteadas em [0, LIMITE_CHAVES)
+        - agrupada: grupos de TAMANHO_GRUPO chaves consecutivas a partir de inícios sorteados
+    A ordem é embaralhada (menos na sequencial), para que as inserções e buscas não sigam a ordem das chaves
+*/
+static void gerar_chaves(int distribuicao, long n, int paridade, int *saida)
+{
+    long inicio_grupo = 0;
+    for (long i = 0; i < n; i++)
+    {
+        long chave;
+        if (distribuicao == 0)
+        {
+            chave = i % LIMITE_CHAVES;
+        }
+        else if (distribuicao == 1)
+        {
+            chave = (long)(aleatorio() % LIMITE_CHAVES);
+        }
+        else
+        {
+            if (i % TAMANHO_GRUPO == 0)
+            {
+                inicio_grupo = (long)(aleatorio() % (LIMITE_CHAVES - TAMANHO_GRUPO));
+            }
+            chave = inicio_grupo + i % TAMANHO_GRUPO;
+        }
+        saida[i] = (int)(2 * chave + paridade);
+    }
+    if (distribuicao != 0)
+    {
+        embaralhar(saida, n);
+    }
+}
+
+static int comparar_double(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double percentil(MEDICAO *medicao, double p)
+{
+    if (medicao->quantidade_amostras == 0)
+    {
+        return 0;
+    }
+    long i = (long)(p * (medicao->quantidade_amostras - 1) + 0.5);
+    return medicao->amostras[i];
+}
+
+static void reportar(OPCOES *opcoes, int tipo, int distribuicao, long tamanho, int razao, const char *operacao, MEDICAO *medicao)
+{
+    qsort(medicao->amostras, medicao->quantidade_amostras, sizeof(double), comparar_double);
+    double ns_op = medicao->operacoes ? medicao->segundos * 1e9 / medicao->operacoes : 0;
+    double ops_s = medicao->segundos > 0 ? medicao->operacoes / medicao->segundos : 0;
+    if (opcoes->json)
+    {
+        printf("%s\n  {\"tipo\": %d, \"estrutura\": \"%s\", \"distribuicao\": \"%s\", \"tamanho\": %ld, \"razao\": %d, "
+               "\"operacao\": \"%s\", \"operacoes\": %ld, \"ns_op\": %.2f, \"ops_s\": %.0f, \"p50\": %.2f, \"p90\": %.2f, \"p99\": %.2f}",
+               primeira_linha ? "[" : ",", tipo, nomes_tipos[tipo], nomes_distribuicoes[distribuicao], tamanho, razao, operacao,
+               medicao->operacoes, ns_op, ops_s, percentil(medicao, 0.5), percentil(medicao, 0.9), percentil(medicao, 0.99));
+    }
+    else
+    {
+        if (primeira_linha)
+        {
+            printf("tipo,estrutura,distribuicao,tamanho,razao,operacao,operacoes,ns_op,ops_s,p50,p90,p99\n");
+        }
+        printf("%d,%s,%s,%ld,%d,%s,%ld,%.2f,%.0f,%.2f,%.2f,%.2f\n", tipo, nomes_tipos[tipo], nomes_distribuicoes[distribuicao],
+               tamanho, razao, operacao, medicao->operacoes, ns_op, ops_s,
+               percentil(medicao, 0.5), percentil(medicao, 0.9), percentil(medicao, 0.99));
+    }
+    primeira_linha = false;
+    fflush(stdout);
+}
+
+/*
+    Medir operações individuais (inserir, remover, pertence)
+    Parâmetros: conjunto, operação (0: inserir, 1: remover, 2: pertence), chaves, quantidade máxima e a medição
+    Ideia: as chaves são processadas em lotes de TAMANHO_LOTE, cada lote é uma amostra; para quando as chaves acabam
+    ou o orçamento de tempo se esgota (orçamento 0: sem limite)
+*/
+static void medir_operacoes(Conjunto *conjunto, int operacao, const int *chaves, long n, double orcamento, MEDICAO *medicao)
+{
+    medicao->operacoes = 0;
+    medicao->segundos = 0;
+    medicao->quantidade_amostras = 0;
+    volatile int encontrados = 0;
+    for (long i = 0; i < n && (orcamento <= 0 || medicao->segundos < orcamento); i += TAMANHO_LOTE)
+    {
+        long fim = i + TAMANHO_LOTE < n ? i + TAMANHO_LOTE : n;
+        double inicio = agora();
+        for (long j = i; j < fim; j++)
+        {
+            if (operacao == 0)
+            {
+                inserir_elemento(conjunto, chaves[j]);
+            }
+            else if (operacao == 1)
+            {
+                remover_elemento(conjunto, chaves[j]);
+            }
+            else
+            {
+                encontrados += pertence_conjunto(conjunto, chaves[j]);
+            }
+        }
+        double tempo = agora() - inicio;
+        medicao->segundos += tempo;
+        medicao->operacoes += fim - i;
+        medicao->amostras[medicao->quantidade_amostras++] = tempo * 1e9 / (fim - i);
+    }
+}
+
+/*
+    Medir união ou interseção
+    Ideia: repete a operação até MAXIMO_REPETICOES vezes ou até esgotar o orçamento (pelo menos uma vez);
+    o resultado é apagado fora do tempo medido
+*/
+static void medir_operacao_conjuntos(Conjunto *a, Conjunto *b, bool uniao, long elementos, double orcamento, MEDICAO *medicao)
+{
+    medicao->operacoes = 0;
+    medicao->segundos = 0;
+    medicao->quantidade_amostras = 0;
+    while (medicao->quantidade_amostras < MAXIMO_REPETICOES && (medicao->quantidade_amostras == 0 || medicao->segundos < orcamento))
+    {
+        double inicio = agora();
+        Conjunto *resultado = uniao ? uniao_conjuntos(a, b) : intersecao_conjuntos(a, b);
+        double tempo = agora() - inicio;
+        apagar_conjunto(resultado);
+        medicao->segundos += tempo;
+        medicao->operacoes += elementos;
+        medicao->amostras[medicao->quantidade_amostras++] = tempo * 1e9 / elementos;
+    }
+}
+
+/*
+    Rodar as medições de um tipo, distribuição e tamanho
+    Ideia:
+        - O conjunto base A tem n chaves pares e é montado em lote (a montagem não é medida)
+        - k = min(n, MAXIMO_OPERACOES) chaves ímpares são inseridas e depois removidas, o que devolve A ao estado inicial
+        - pertence alterna chaves de A (acertos) e chaves ímpares (erros)
+        - Para cada razão r, B tem n / r chaves, metade de A e metade ímpares, e mede-se A ∪ B e A ∩ B
+*/
+static void medir(OPCOES *opcoes, int tipo, int distribuicao, long n, MEDICAO *medicao)
+{
+    long k = n < MAXIMO_OPERACOES ? n : MAXIMO_OPERACOES;
+    int *base = (int *)malloc(n * sizeof(int));
+    int *novas = (int *)malloc(k * sizeof(int));
+    int *buscas = (int *)malloc(k * sizeof(int));
+    if (!base || !novas || !buscas)
+    {
+        printf("Erro: falha ao alocar memória para as chaves.\n");
+        exit(EXIT_FAILURE);
+    }
+    gerar_chaves(distribuicao, n, 0, base);
+    gerar_chaves(distribuicao, k, 1, novas);
+    for (long i = 0; i < k; i++)
+    {
+        buscas[i] = i % 2 ? novas[i] : base[i];
+    }
+
+    Conjunto *a = criar_conjunto_de_vetor(tipo, base, (int)n);
+    fprintf(stderr, "%s %s n=%ld\n", nomes_tipos[tipo], nomes_distribuicoes[distribuicao], n);
+
+    medir_operacoes(a, 0, novas, k, opcoes->orcamento, medicao);
+    reportar(opcoes, tipo, distribuicao, n, 0, "inserir", medicao);
+    // remove as mesmas chaves que foram inseridas, para A voltar ao tamanho n
+    long inseridas = medicao->operacoes;
+    medir_operacoes(a, 1, novas, inseridas, 0, medicao);
+    reportar(opcoes, tipo, distribuicao, n, 0, "remover", medicao);
+    medir_operacoes(a, 2, buscas, k, opcoes->orcamento, medicao);
+    reportar(opcoes, tipo, distribuicao, n, 0, "pertence", medicao);
+
+    for (int r = 0; r < opcoes->quantidade_razoes; r++)
+    {
+        int razao = opcoes->razoes[r];
+        long m = n / razao;
+        if (m < 1)
+        {
+            continue;
+        }
+        int *chaves_b = (int *)malloc(m * sizeof(int));
+        if (!chaves_b)
+        {
+            printf("Erro: falha ao alocar memória para as chaves.\n");
+            exit(EXIT_FAILURE);
+        }
+        gerar_chaves(distribuicao, m, 1, chaves_b);
+        for (long i = 0; i < m; i += 2)
+        {
+            chaves_b[i] = base[aleatorio() % n];
+        }
+        Conjunto *b = criar_conjunto_de_vetor(tipo, chaves_b, (int)m);
+        free(chaves_b);
+
+        medir_operacao_conjuntos(a, b, true, n + m, opcoes->orcamento, medicao);
+        reportar(opcoes, tipo, distribuicao, n, razao, "uniao", medicao);
+        medir_operacao_conjuntos(a, b, false, n + m, opcoes->orcamento, medicao);
+        reportar(opcoes, tipo, distribuicao, n, razao, "intersecao", medicao);
+        apagar_conjunto(b);
+    }
+
+    apagar_conjunto(a);
+    free(base);
+    free(novas);
+    free(buscas);
+}
+
+// Lê uma lista "a,b,c" e marca cada item encontrado em "nomes" (ou, sem nomes, cada número de 0 a quantidade - 1)
+static bool ler_lista(const char *texto, const char **nomes, int quantidade, bool *marcados)
+{
+    memset(marcados, 0, quantidade * sizeof(bool));
+    char copia[256];
+    snprintf(copia, sizeof(copia), "%s", texto);
+    for (char *item = strtok(copia, ","); item; item = strtok(NULL, ","))
+    {
+        bool achou = false;
+        for (int i = 0; i < quantidade; i++)
+        {
+            if ((nomes && strcmp(item, nomes[i]) == 0) || (!nomes && atoi(item) == i && item[0] >= '0' && item[0] <= '9'))
+            {
+                marcados[i] = achou = true;
+            }
+        }
+        if (!achou)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+static void uso(void)
+{
+    fprintf(stderr, "Uso: ./benchmark [-f csv|json] [-e expoente_min] [-E expoente_max] [-t 0,1,...] "
+                    "[-d sequencial,uniforme,agrupada] [-r 1,100] [-o orcamento_ms] [-s semente]\n");
+    exit(EXIT_FAILURE);
+}
+
+int main(int argc, char *argv[])
+{
+    OPCOES opcoes = {false, 2, 6, {true, true, true, true, true, true, true}, {true, true, true}, {1, 100}, 2, 0.2, 1};
+    int opcao;
+    while ((opcao = getopt(argc, argv, "f:e:E:t:d:r:o:s:")) != -1)
+    {
+        switch (opcao)
+        {
+        case 'f':
+            if (strcmp(optarg, "json") == 0)
+                opcoes.json = true;
+            else if (strcmp(optarg, "csv") == 0)
+                opcoes.json = false;
+            else
+                uso();
+            break;
+        case 'e':
+            opcoes.expoente_min = atoi(optarg);
+            break;
+        case 'E':
+            opcoes.expoente_max = atoi(optarg);
+            break;
+        case 't':
+            if (!ler_lista(optarg, NULL, QUANTIDADE_TIPOS, opcoes.tipos))
+                uso();
+            break;
+        case 'd':
+            if (!ler_lista(optarg, nomes_distribuicoes, QUANTIDADE_DISTRIBUICOES, opcoes.distribuicoes))
+                uso();
+            break;
+        case 'r':
+        {
+            opcoes.quantidade_razoes = 0;
+            char copia[256];
+            snprintf(copia, sizeof(copia), "%s", optarg);
+            for (char *item = strtok(copia, ","); item && opcoes.quantidade_razoes < 8; item = strtok(NULL, ","))
+            {
+                if (atoi(item) < 1)
+                    uso();
+                opcoes.razoes[opcoes.quantidade_razoes++] = atoi(item);
+            }
+            break;
+        }
+        case 'o':
+            opcoes.orcamento = atof(optarg) / 1e3;
+            break;
+        case 's':
+            opcoes.semente = strtoull(optarg, NULL, 10);
+            break;
+        default:
+            uso();
+        }
+    }
+    if (opcoes.expoente_min < 0 || opcoes.expoente_max > 8 || opcoes.expoente_min > opcoes.expoente_max || opcoes.orcamento <= 0)
+    {
+        uso();
+    }
+
+    // cabe uma amostra por lote de todas as operações, ou uma por repetição
+    long maximo_amostras = MAXIMO_OPERACOES / TAMANHO_LOTE + MAXIMO_REPETICOES + 1;
+    MEDICAO medicao;
+    medicao.amostras = (double *)malloc(maximo_amostras * sizeof(double));
+    if (!medicao.amostras)
+    {
+        printf("Erro: falha ao alocar memória para as amostras.\n");
+        return EXIT_FAILURE;
+    }
+
+    for (int e = opcoes.expoente_min; e <= opcoes.expoente_max; e++)
+    {
+        long n = 1;
+        for (int i = 0; i < e; i++)
+        {
+            n *= 10;
+        }
+        for (int d = 0; d < QUANTIDADE_DISTRIBUICOES; d++)
+        {
+            for (int tipo = 0; tipo < QUANTIDADE_TIPOS; tipo++)
+            {
+                if (opcoes.distribuicoes[d] && opcoes.tipos[tipo])
+                {
+                    // mesma semente para cada (distribuição, tamanho): todos os tipos recebem as mesmas chaves
+                    estado_aleatorio = (opcoes.semente ^ ((uint64_t)e << 32 | (uint64_t)d)) * 0x9E3779B97F4A7C15ULL | 1;
+                    medir(&opcoes, tipo, d, n, &medicao);
+                }
+            }
+        }
+    }
+    if (opcoes.json)
+    {
+        printf(primeira_linha ? "[]\n" : "\n]\n");
+    }
+    free(medicao.amostras);
+    return 0;
+}
@@ -1,17 +1,58 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
 #include "arvore_avl.h"
 #include "lista.h"
+#include "mapa_bits.h"
+#include "tabela_hash.h"
+#include "arvore_b.h"
+#include "arvore_avl_compacta.h"
+#include "lista_blocos.h"
+#include "ordenacao.h"
+#include "saida.h"
+#include "persistencia.h"
+#include "estatisticas.h"
+#include "latencia.h"
+#include "intersecao_vetores.h"
+
+// Razão entre os tamanhos a partir da qual a interseção procura os elementos do menor conjunto no maior
+#ifndef RAZAO_GALOPE
+#define RAZAO_GALOPE 32
+#endif
+// Tipo automático: quantas vezes a vantagem acumulada da outra estrutura precisa pagar o custo de migrar para ela
+#ifndef FATOR_MIGRACAO
+#define FATOR_MIGRACAO 2
+#endif
 #include "conjunto.h"
 
 struct Conjunto
 {
-    int tipo;        // 0 -> AVL, 1 -> Lista Linear Sequencial
+    int tipo;        // 0 -> AVL, 1 -> Lista Linear Sequencial, 2 -> Mapa de Bits Comprimido, 3 -> Tabela Hash, 4 -> Árvore B+, 5 -> AVL Compacta, 7 -> Lista em Blocos
     int tam;         // Tamanho do conjunto
     void *estrutura; // A partir desse ponteiro void, é possível escolher qual estrutura de dados será utilizada
+    ESTATISTICAS estatisticas; // Contadores das operações feitas neste conjunto (ver estatisticas.h)
+    bool automatico;           // TIPO_AUTOMATICO: "tipo" é a estrutura atual (0 ou 1), trocada conforme o uso
+    double saldo_migracao;     // TIPO_AUTOMATICO: vantagem acumulada da outra estrutura (ver registrar_uso)
 };
 
+/*
+    Contagem de operações: enquanto uma operação do conjunto roda, as estruturas contam (CONTAR) nos contadores dele.
+    Na união e na interseção, a contagem vai para o conjunto resultado. O ponteiro anterior é guardado e devolvido,
+    então uma operação chamada dentro de outra não desvia a contagem de quem a chamou
+    Latência (ver latencia.c): inserir, remover, pertence, união e interseção marcam o início com latencia_iniciar e registram
+    a duração, pela faixa de tamanho do conjunto (na união e na interseção, a soma dos dois), se a operação foi sorteada
+*/
+#if CONTAR_ESTATISTICAS
+#define INICIAR_CONTAGEM(conjunto)                       \
+    ESTATISTICAS *contagem_anterior = estatisticas_atuais; \
+    estatisticas_atuais = &(conjunto)->estatisticas
+#define ENCERRAR_CONTAGEM() (estatisticas_atuais = contagem_anterior)
+#else
+#define INICIAR_CONTAGEM(conjunto) ((void)0)
+#define ENCERRAR_CONTAGEM() ((void)0)
+#endif
+
 /*
     As funções desse arquivo possuem um padrão comum:
         - Dada a definição do tipo, de estrutura a ser utilizada, por meio de um "if",
@@ -21,6 +62,12 @@ struct Conjunto
 
 Conjunto *criar_conjunto(int tipo, int tam)
 {
+    if (tipo == TIPO_AUTOMATICO)
+    {
+        Conjunto *automatico = criar_conjunto(1, tam); // começa como lista: barata enquanto é pequena
+        automatico->automatico = true;
+        return automatico;
+    }
     Conjunto *conjunto = (Conjunto *)malloc(sizeof(Conjunto));
     if (!conjunto)
     {
@@ -29,7 +76,10 @@ Conjunto *criar_conjunto(int tipo, int tam)
     }
 
     conjunto->tipo = tipo;
-    conjunto->tam = tam;
+    conjunto->tam = 0; // o conjunto nasce vazio; "tam" é só a capacidade inicial da lista
+    memset(&conjunto->estatisticas, 0, sizeof(ESTATISTICAS));
+    conjunto->automatico = false;
+    conjunto->saldo_migracao = 0;
 
     if (tipo == 0)
     {
@@ -51,6 +101,147 @@ Conjunto *criar_conjunto(int tipo, int tam)
             exit(EXIT_FAILURE);
         }
     }
+    else if (tipo == 2)
+    {
+        conjunto->estrutura = mapa_bits_criar();
+        if (!conjunto->estrutura)
+        {
+            printf("Erro: falha ao criar o mapa de bits.\n");
+            free(conjunto);
+            exit(EXIT_FAILURE);
+        }
+    }
+    else if (tipo == 3)
+    {
+        conjunto->estrutura = tabela_hash_criar(tam);
+        if (!conjunto->estrutura)
+        {
+            printf("Erro: falha ao criar a tabela hash.\n");
+            free(conjunto);
+            exit(EXIT_FAILURE);
+        }
+    }
+    else if (tipo == 4)
+    {
+        conjunto->estrutura = arvore_b_criar();
+        if (!conjunto->estrutura)
+        {
+            printf("Erro: falha ao criar a árvore B+.\n");
+            free(conjunto);
+            exit(EXIT_FAILURE);
+        }
+    }
+    else if (tipo == 5)
+    {
+        conjunto->estrutura = avl_compacta_criar();
+        if (!conjunto->estrutura)
+        {
+            printf("Erro: falha ao criar a árvore AVL compacta.\n");
+            free(conjunto);
+            exit(EXIT_FAILURE);
+        }
+    }
+    else if (tipo == 7)
+    {
+        conjunto->estrutura = lista_blocos_criar();
+        if (!conjunto->estrutura)
+        {
+            printf("Erro: falha ao criar a lista em blocos.\n");
+            free(conjunto);
+            exit(EXIT_FAILURE);
+        }
+    }
+    else
+    {
+        printf("Erro: tipo de estrutura inválido.\n");
+        free(conjunto);
+        exit(EXIT_FAILURE);
+    }
+
+    return conjunto;
+}
+
+/*
+    Criação em lote:
+        - Em vez de n inserções (O(n log n) na AVL, O(n²) de deslocamentos na lista), copia-se o vetor,
+          ordena-se com radix sort e removem-se os repetidos, tudo em O(n)
+        - Com o vetor ordenado, a AVL é montada já balanceada e a lista é preenchida de uma só vez (criar_conjunto_de_ordenado)
+*/
+Conjunto *criar_conjunto_de_vetor(int tipo, const int *vetor, int n)
+{
+    int *ordenado = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (!ordenado)
+    {
+        printf("Erro: falha ao alocar memória para o vetor auxiliar.\n");
+        exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < n; i++)
+    {
+        ordenado[i] = vetor[i];
+    }
+    n = ordenar_sem_repeticao(ordenado, n);
+    if (n < 0)
+    {
+        printf("Erro: falha ao ordenar o vetor.\n");
+        free(ordenado);
+        exit(EXIT_FAILURE);
+    }
+
+    Conjunto *conjunto = criar_conjunto_de_ordenado(tipo, ordenado, n);
+    free(ordenado);
+    return conjunto;
+}
+
+Conjunto *criar_conjunto_de_ordenado(int tipo, const int *ordenado, int n)
+{
+    if (tipo == TIPO_AUTOMATICO)
+    {
+        Conjunto *automatico = criar_conjunto_de_ordenado(1, ordenado, n);
+        automatico->automatico = true;
+        return automatico;
+    }
+    Conjunto *conjunto = (Conjunto *)malloc(sizeof(Conjunto));
+    if (!conjunto)
+    {
+        printf("Erro: falha ao alocar memória para o conjunto.\n");
+        exit(EXIT_FAILURE);
+    }
+
+    conjunto->tipo = tipo;
+    conjunto->tam = n;
+    memset(&conjunto->estatisticas, 0, sizeof(ESTATISTICAS));
+    conjunto->automatico = false;
+    conjunto->saldo_migracao = 0;
+    INICIAR_CONTAGEM(conjunto);
+
+    if (tipo == 0)
+    {
+        conjunto->estrutura = criar_arvore_avl_de_vetor(ordenado, n);
+    }
+    else if (tipo == 1)
+    {
+        conjunto->estrutura = lista_criar_de_vetor(ordenado, n);
+    }
+    else if (tipo == 2)
+    {
+        conjunto->estrutura = mapa_bits_criar_de_vetor(ordenado, n);
+    }
+    else if (tipo == 3)
+    {
+        conjunto->estrutura = tabela_hash_criar_de_vetor(ordenado, n);
+    }
+    else if (tipo == 4)
+    {
+        conjunto->estrutura = arvore_b_criar_de_vetor(ordenado, n);
+    }
+    else if (tipo == 5)
+    {
+        conjunto->estrutura = avl_compacta_criar_de_vetor(ordenado, n);
+    }
+    else if (tipo == 7)
+    {
+        conjunto->estrutura = lista_blocos_criar_de_vetor(ordenado, n);
+    }
     else
     {
         printf("Erro: tipo de estrutura inválido.\n");
@@ -58,132 +249,1117 @@ Conjunto *criar_conjunto(int tipo, int tam)
         exit(EXIT_FAILURE);
     }
 
+    if (!conjunto->estrutura)
+    {
+        printf("Erro: falha ao criar a estrutura do conjunto.\n");
+        free(conjunto);
+        exit(EXIT_FAILURE);
+    }
+    ENCERRAR_CONTAGEM();
     return conjunto;
 }
 
+// Libera só a estrutura de dados do conjunto (usado ao apagar e ao migrar)
+static void apagar_estrutura(Conjunto *conjunto)
+{
+    if (conjunto->tipo == 0)
+    {
+        apagar_arvore_avl((ArvoreAVL **)(&(conjunto->estrutura)));
+    }
+    else if (conjunto->tipo == 1)
+    {
+        lista_apagar((LISTA **)&(conjunto->estrutura));
+    }
+    else if (conjunto->tipo == 2)
+    {
+        mapa_bits_apagar((MAPA_BITS **)&(conjunto->estrutura));
+    }
+    else if (conjunto->tipo == 3)
+    {
+        tabela_hash_apagar((TABELA_HASH **)&(conjunto->estrutura));
+    }
+    else if (conjunto->tipo == 4)
+    {
+        arvore_b_apagar((ARVORE_B **)&(conjunto->estrutura));
+    }
+    else if (conjunto->tipo == 5)
+    {
+        avl_compacta_apagar((AVL_COMPACTA **)&(conjunto->estrutura));
+    }
+    else if (conjunto->tipo == 7)
+    {
+        lista_blocos_apagar((LISTA_BLOCOS **)&(conjunto->estrutura));
+    }
+}
+
 void apagar_conjunto(Conjunto *conjunto)
 {
     if (!conjunto || !conjunto->estrutura)
         return;
 
-    if (conjunto->estrutura)
+    apagar_estrutura(conjunto);
+    free(conjunto);
+}
+
+/*
+    Tipo automático (TIPO_AUTOMATICO): o conjunto alterna entre a lista (1) e a AVL (0) conforme o uso
+        - Modelo de custo, em ns aproximados (medidos com o benchmark), para um conjunto de n elementos e h = log2(n) níveis:
+            lista: inserir/remover = CUSTO_DESLOCAMENTO * n / 2 + CUSTO_NIVEL_LISTA * h; pertence = CUSTO_NIVEL_LISTA * h
+            AVL:   inserir/remover = CUSTO_NIVEL_AVL_ESCRITA * h;                       pertence = CUSTO_NIVEL_AVL * h
+            um lote de k alterações custa k descidas, mas a lista desloca o vetor uma vez só (intercalação)
+            união e interseção: CUSTO_ELEMENTO_LISTA ou CUSTO_ELEMENTO_AVL por elemento de entrada
+        - Cada operação soma ao saldo a diferença entre o custo na estrutura atual e o custo na outra, e o saldo nunca fica
+          negativo (soma acumulada com reinício em 0): rajadas curtas não se acumulam, mas uma tendência sim
+        - Quando o saldo passa de FATOR_MIGRACAO vezes o custo de migrar (CUSTO_MIGRACAO por elemento), o conjunto é exportado
+          em ordem e remontado em lote na outra estrutura, em O(n)
+        - Assim, uma fase de carga com muitas inserções leva o conjunto para a AVL, e uma fase só de leitura o traz de volta à lista
+    Como até pertence_conjunto pode trocar a estrutura, leituras simultâneas de um conjunto automático precisam de sincronização externa
+*/
+#define CUSTO_DESLOCAMENTO 1.4
+#define CUSTO_NIVEL_LISTA 11.0
+#define CUSTO_NIVEL_AVL 17.0
+#define CUSTO_NIVEL_AVL_ESCRITA 48.0
+#define CUSTO_ELEMENTO_LISTA 30.0
+#define CUSTO_ELEMENTO_AVL 75.0
+#define CUSTO_MIGRACAO 25.0
+
+// Usos registrados pelo tipo automático
+#define USO_ESCRITA 0
+#define USO_LEITURA 1
+#define USO_OPERACAO_CONJUNTOS 2
+
+static double custo_uso(int tipo, int uso, double n, long quantidade)
+{
+    int niveis = 32 - __builtin_clz((unsigned int)n + 1);
+    if (uso == USO_ESCRITA)
     {
-        if (conjunto->tipo == 0)
-        {
-            apagar_arvore_avl((ArvoreAVL **)(&(conjunto->estrutura)));
-        }
-        else if (conjunto->tipo == 1)
-        {
-            lista_apagar((LISTA **)&(conjunto->estrutura));
-        }
+        return tipo == 1 ? CUSTO_DESLOCAMENTO * n / 2 + quantidade * CUSTO_NIVEL_LISTA * niveis : quantidade * CUSTO_NIVEL_AVL_ESCRITA * niveis;
+    }
+    if (uso == USO_LEITURA)
+    {
+        return quantidade * (tipo == 1 ? CUSTO_NIVEL_LISTA : CUSTO_NIVEL_AVL) * niveis;
     }
+    return quantidade * (tipo == 1 ? CUSTO_ELEMENTO_LISTA : CUSTO_ELEMENTO_AVL);
+}
 
-    free(conjunto);
+// Troca a estrutura do conjunto por "tipo", com os mesmos elementos; sem memória, o conjunto continua como está
+static void migrar_conjunto(Conjunto *conjunto, int tipo)
+{
+    int *elementos = (int *)malloc((conjunto->tam > 0 ? conjunto->tam : 1) * sizeof(int));
+    if (!elementos)
+    {
+        return;
+    }
+    int n = exportar_conjunto(conjunto, elementos);
+    void *nova = tipo == 0 ? (void *)criar_arvore_avl_de_vetor(elementos, n) : (void *)lista_criar_de_vetor(elementos, n);
+    free(elementos);
+    if (!nova)
+    {
+        return;
+    }
+    apagar_estrutura(conjunto);
+    conjunto->estrutura = nova;
+    conjunto->tipo = tipo;
+}
+
+static void registrar_uso(Conjunto *conjunto, int uso, long quantidade)
+{
+    if (!conjunto->automatico || quantidade <= 0)
+    {
+        return;
+    }
+    double n = conjunto->tam;
+    int outro = conjunto->tipo == 0 ? 1 : 0;
+    double saldo = conjunto->saldo_migracao + custo_uso(conjunto->tipo, uso, n, quantidade) - custo_uso(outro, uso, n, quantidade);
+    conjunto->saldo_migracao = saldo > 0 ? saldo : 0;
+    // "+ 64": um conjunto quase vazio não fica trocando de estrutura a cada poucas operações
+    if (conjunto->saldo_migracao > FATOR_MIGRACAO * CUSTO_MIGRACAO * (n + 64))
+    {
+        migrar_conjunto(conjunto, outro);
+        conjunto->saldo_migracao = 0;
+    }
+}
+
+int estrutura_conjunto(Conjunto *conjunto)
+{
+    return conjunto->tipo;
 }
 
 bool inserir_elemento(Conjunto *conjunto, int elemento)
 {
+    bool inserido = false;
+    unsigned long long inicio_latencia = latencia_iniciar();
+    INICIAR_CONTAGEM(conjunto);
     if (conjunto->tipo == 0)
     {
-        return inserir_arvore_avl((ArvoreAVL *)conjunto->estrutura, elemento);
+        inserido = inserir_arvore_avl((ArvoreAVL *)conjunto->estrutura, elemento);
     }
     else if (conjunto->tipo == 1)
     {
-        return lista_inserir((LISTA *)conjunto->estrutura, elemento);
+        inserido = lista_inserir((LISTA *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        inserido = mapa_bits_inserir((MAPA_BITS *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        inserido = tabela_hash_inserir((TABELA_HASH *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 4)
+    {
+        inserido = arvore_b_inserir((ARVORE_B *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        inserido = avl_compacta_inserir((AVL_COMPACTA *)conjunto->estrutura, elemento);
     }
+    else if (conjunto->tipo == 7)
+    {
+        inserido = lista_blocos_inserir((LISTA_BLOCOS *)conjunto->estrutura, elemento);
+    }
+    if (inserido)
+        conjunto->tam++;
+    registrar_uso(conjunto, inserido ? USO_ESCRITA : USO_LEITURA, 1);
+    ENCERRAR_CONTAGEM();
+    latencia_registrar(LATENCIA_INSERIR, inicio_latencia, conjunto->tam);
+    return inserido;
 }
 
 bool remover_elemento(Conjunto *conjunto, int elemento)
 {
+    bool removido = false;
+    unsigned long long inicio_latencia = latencia_iniciar();
+    INICIAR_CONTAGEM(conjunto);
+    if (conjunto->tipo == 0)
+    {
+        removido = remover_arvore_avl((ArvoreAVL *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 1)
+    {
+        removido = lista_remover((LISTA *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        removido = mapa_bits_remover((MAPA_BITS *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        removido = tabela_hash_remover((TABELA_HASH *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 4)
+    {
+        removido = arvore_b_remover((ARVORE_B *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        removido = avl_compacta_remover((AVL_COMPACTA *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 7)
+    {
+        removido = lista_blocos_remover((LISTA_BLOCOS *)conjunto->estrutura, elemento);
+    }
+    if (removido)
+        conjunto->tam--;
+    registrar_uso(conjunto, removido ? USO_ESCRITA : USO_LEITURA, 1);
+    ENCERRAR_CONTAGEM();
+    latencia_registrar(LATENCIA_REMOVER, inicio_latencia, conjunto->tam);
+    return removido;
+}
+
+/*
+    Operações em lote:
+        - O lote é copiado, ordenado e tem os repetidos removidos (radix sort, O(k))
+        - Na lista, o lote ordenado é intercalado com o vetor em uma única passada O(n + k)
+        - Na AVL, o lote vira uma árvore balanceada e é aplicado como uma única união (ou diferença) por divisão e junção
+*/
+static int *ordenar_lote(const int *elementos, size_t k, int *quantidade)
+{
+    int *lote = (int *)malloc((k > 0 ? k : 1) * sizeof(int));
+    if (!lote)
+        return NULL;
+    for (size_t i = 0; i < k; i++)
+    {
+        lote[i] = elementos[i];
+    }
+    *quantidade = ordenar_sem_repeticao(lote, (int)k);
+    if (*quantidade < 0)
+    {
+        free(lote);
+        return NULL;
+    }
+    return lote;
+}
+
+size_t inserir_elementos(Conjunto *conjunto, const int *elementos, size_t k)
+{
+    int quantidade, inseridos = 0;
+    int *lote = ordenar_lote(elementos, k, &quantidade);
+    if (!lote)
+        return 0;
+
+    INICIAR_CONTAGEM(conjunto);
+    if (conjunto->tipo == 0)
+    {
+        inseridos = inserir_lote_arvore_avl((ArvoreAVL *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 1)
+    {
+        inseridos = lista_inserir_lote((LISTA *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        inseridos = mapa_bits_inserir_lote((MAPA_BITS *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        inseridos = tabela_hash_inserir_lote((TABELA_HASH *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 4)
+    {
+        inseridos = arvore_b_inserir_lote((ARVORE_B *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        inseridos = avl_compacta_inserir_lote((AVL_COMPACTA *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 7)
+    {
+        inseridos = lista_blocos_inserir_lote((LISTA_BLOCOS *)conjunto->estrutura, lote, quantidade);
+    }
+    free(lote);
+    ENCERRAR_CONTAGEM();
+
+    if (inseridos < 0)
+        return 0;
+    conjunto->tam += inseridos;
+    registrar_uso(conjunto, USO_ESCRITA, (long)inseridos);
+    registrar_uso(conjunto, USO_LEITURA, (long)quantidade - inseridos); // os já presentes só foram procurados
+    return (size_t)inseridos;
+}
+
+size_t remover_elementos(Conjunto *conjunto, const int *elementos, size_t k)
+{
+    int quantidade, removidos = 0;
+    int *lote = ordenar_lote(elementos, k, &quantidade);
+    if (!lote)
+        return 0;
+
+    INICIAR_CONTAGEM(conjunto);
     if (conjunto->tipo == 0)
     {
-        return remover_arvore_avl((ArvoreAVL *)conjunto->estrutura, elemento);
+        removidos = remover_lote_arvore_avl((ArvoreAVL *)conjunto->estrutura, lote, quantidade);
     }
     else if (conjunto->tipo == 1)
     {
-        return lista_remover((LISTA *)conjunto->estrutura, elemento);
+        removidos = lista_remover_lote((LISTA *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        removidos = mapa_bits_remover_lote((MAPA_BITS *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        removidos = tabela_hash_remover_lote((TABELA_HASH *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 4)
+    {
+        removidos = arvore_b_remover_lote((ARVORE_B *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        removidos = avl_compacta_remover_lote((AVL_COMPACTA *)conjunto->estrutura, lote, quantidade);
+    }
+    else if (conjunto->tipo == 7)
+    {
+        removidos = lista_blocos_remover_lote((LISTA_BLOCOS *)conjunto->estrutura, lote, quantidade);
+    }
+    free(lote);
+    ENCERRAR_CONTAGEM();
+
+    if (removidos < 0)
+        return 0;
+    conjunto->tam -= removidos;
+    registrar_uso(conjunto, USO_ESCRITA, (long)removidos);
+    registrar_uso(conjunto, USO_LEITURA, (long)quantidade - removidos); // ausentes só foram procurados
+    return (size_t)removidos;
+}
+
+/*
+    Estatísticas: cópia dos contadores do conjunto (todos 0 se a contagem foi tirada na compilação) e volta deles a 0
+*/
+ESTATISTICAS obter_estatisticas(Conjunto *conjunto)
+{
+    ESTATISTICAS vazias;
+    memset(&vazias, 0, sizeof(ESTATISTICAS));
+    return conjunto ? conjunto->estatisticas : vazias;
+}
+
+void zerar_estatisticas(Conjunto *conjunto)
+{
+    if (conjunto)
+    {
+        memset(&conjunto->estatisticas, 0, sizeof(ESTATISTICAS));
+    }
+}
+
+OCUPACAO ocupacao_conjunto(Conjunto *conjunto)
+{
+    if (conjunto && conjunto->tipo == 0)
+    {
+        return ocupacao_arvore_avl((ArvoreAVL *)conjunto->estrutura);
     }
+    OCUPACAO vazia = {0, 0, 0, 0};
+    return vazia;
+}
+
+int tamanho_conjunto(Conjunto *conjunto)
+{
+    return conjunto ? conjunto->tam : 0;
+}
+
+/*
+    Tamanho da estrutura: conta os elementos direto na estrutura, usado para acertar "tam" após união e interseção
+*/
+static int tamanho_estrutura(Conjunto *conjunto)
+{
+    if (conjunto->tipo == 0)
+    {
+        return ocupacao_arvore_avl((ArvoreAVL *)conjunto->estrutura).em_uso;
+    }
+    else if (conjunto->tipo == 1)
+    {
+        return lista_tamanho((LISTA *)conjunto->estrutura);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        return mapa_bits_tamanho((MAPA_BITS *)conjunto->estrutura);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        return tabela_hash_tamanho((TABELA_HASH *)conjunto->estrutura);
+    }
+    else if (conjunto->tipo == 4)
+    {
+        return arvore_b_tamanho((ARVORE_B *)conjunto->estrutura);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        return avl_compacta_tamanho((AVL_COMPACTA *)conjunto->estrutura);
+    }
+    else if (conjunto->tipo == 7)
+    {
+        return lista_blocos_tamanho((LISTA_BLOCOS *)conjunto->estrutura);
+    }
+    return 0;
 }
 
 bool pertence_conjunto(Conjunto *conjunto, int elemento)
+{
+    bool pertence = false;
+    unsigned long long inicio_latencia = latencia_iniciar();
+    INICIAR_CONTAGEM(conjunto);
+    if (conjunto->tipo == 0)
+    {
+        pertence = pertence_arvore_avl((ArvoreAVL *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 1)
+    {
+        pertence = lista_pertence((LISTA *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        pertence = mapa_bits_pertence((MAPA_BITS *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        pertence = tabela_hash_pertence((TABELA_HASH *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 4)
+    {
+        pertence = arvore_b_pertence((ARVORE_B *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        pertence = avl_compacta_pertence((AVL_COMPACTA *)conjunto->estrutura, elemento);
+    }
+    else if (conjunto->tipo == 7)
+    {
+        pertence = lista_blocos_pertence((LISTA_BLOCOS *)conjunto->estrutura, elemento);
+    }
+    registrar_uso(conjunto, USO_LEITURA, 1);
+    ENCERRAR_CONTAGEM();
+    latencia_registrar(LATENCIA_PERTENCE, inicio_latencia, conjunto->tam);
+    return pertence;
+}
+
+/*
+    Pertencimento em lote:
+        - Na AVL, várias descidas andam juntas, um nível por vez, com prefetch do próximo nó de cada uma
+        - Na lista, as chaves são ordenadas e procuradas por galope em uma única varredura do vetor
+        - Nas demais estruturas, uma busca por chave
+    out[i] diz se keys[i] pertence ao conjunto; retorna quantas pertencem
+*/
+size_t pertence_lote(Conjunto *conjunto, const int *keys, size_t k, bool *out)
+{
+    int encontradas = 0;
+    INICIAR_CONTAGEM(conjunto);
+    if (conjunto->tipo == 0)
+    {
+        encontradas = pertence_lote_arvore_avl((ArvoreAVL *)conjunto->estrutura, keys, (int)k, out);
+    }
+    else if (conjunto->tipo == 1)
+    {
+        encontradas = lista_pertence_lote((LISTA *)conjunto->estrutura, keys, (int)k, out);
+    }
+    else
+    {
+        for (size_t i = 0; i < k; i++)
+        {
+            out[i] = pertence_conjunto(conjunto, keys[i]);
+            encontradas += out[i];
+        }
+    }
+    registrar_uso(conjunto, USO_LEITURA, (long)k);
+    ENCERRAR_CONTAGEM();
+    return (size_t)encontradas;
+}
+
+/*
+    Otimizar busca: só a lista tem layout de leitura; nas árvores e na tabela a busca já não depende disso
+*/
+bool otimizar_busca_conjunto(Conjunto *conjunto, bool ativar)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_otimizar_busca((LISTA *)conjunto->estrutura, ativar);
+    }
+    return false;
+}
+
+/*
+    Remoção preguiçosa: só a lista desloca elementos ao remover; as outras estruturas já removem sem mover o resto
+*/
+bool remocao_preguicosa_conjunto(Conjunto *conjunto, bool ativar)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_remocao_preguicosa((LISTA *)conjunto->estrutura, ativar);
+    }
+    return false;
+}
+
+bool compactar_conjunto(Conjunto *conjunto)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_compactar((LISTA *)conjunto->estrutura);
+    }
+    return false;
+}
+
+bool reservar_conjunto(Conjunto *conjunto, int capacidade)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_reservar((LISTA *)conjunto->estrutura, capacidade);
+    }
+    return false;
+}
+
+bool fator_crescimento_conjunto(Conjunto *conjunto, float fator)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_definir_fator_crescimento((LISTA *)conjunto->estrutura, fator);
+    }
+    return false;
+}
+
+bool fator_carga_conjunto(Conjunto *conjunto, float fator)
+{
+    if (conjunto->tipo == 3)
+    {
+        return tabela_hash_definir_fator_carga((TABELA_HASH *)conjunto->estrutura, fator);
+    }
+    return false;
+}
+
+int capacidade_conjunto(Conjunto *conjunto)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_capacidade((LISTA *)conjunto->estrutura);
+    }
+    if (conjunto->tipo == 3)
+    {
+        return tabela_hash_capacidade((TABELA_HASH *)conjunto->estrutura);
+    }
+    return -1;
+}
+
+bool ajustar_capacidade_conjunto(Conjunto *conjunto)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_realocar((LISTA *)conjunto->estrutura);
+    }
+    return false;
+}
+
+const int *elementos_conjunto(Conjunto *conjunto)
+{
+    if (conjunto->tipo == 1)
+    {
+        return lista_elementos((LISTA *)conjunto->estrutura);
+    }
+    return NULL;
+}
+
+int exportar_conjunto(Conjunto *conjunto, int *saida)
 {
     if (conjunto->tipo == 0)
     {
-        return pertence_arvore_avl((ArvoreAVL *)conjunto->estrutura, elemento);
+        return exportar_arvore_avl((ArvoreAVL *)conjunto->estrutura, saida);
     }
     else if (conjunto->tipo == 1)
     {
-        return lista_pertence((LISTA *)conjunto->estrutura, elemento);
+        return lista_exportar((LISTA *)conjunto->estrutura, saida);
+    }
+    else if (conjunto->tipo == 2)
+    {
+        return mapa_bits_exportar((MAPA_BITS *)conjunto->estrutura, saida);
+    }
+    else if (conjunto->tipo == 3)
+    {
+        return tabela_hash_exportar((TABELA_HASH *)conjunto->estrutura, saida);
     }
+    else if (conjunto->tipo == 4)
+    {
+        return arvore_b_exportar((ARVORE_B *)conjunto->estrutura, saida);
+    }
+    else if (conjunto->tipo == 5)
+    {
+        return avl_compacta_exportar((AVL_COMPACTA *)conjunto->estrutura, saida);
+    }
+    else if (conjunto->tipo == 7)
+    {
+        return lista_blocos_exportar((LISTA_BLOCOS *)conjunto->estrutura, saida);
+    }
+    return 0;
+}
+
+/*
+    Persistência (ver persistencia.c):
+        - Salvar: os elementos são lidos em ordem (direto do vetor da lista, ou exportados) e gravados com o tipo do conjunto
+        - Carregar: na lista com FORMATO_VETOR, o vetor mapeado do arquivo passa a ser o próprio vetor da lista, sem cópia
+          (a lista só copia para a memória quando precisar crescer); nos demais casos o arquivo é decodificado em um vetor
+          ordenado e a estrutura é montada de uma vez por criar_conjunto_de_ordenado, em O(n)
+        - tipo < 0 em carregar_conjunto usa o tipo gravado no arquivo
+*/
+bool salvar_conjunto(Conjunto *conjunto, const char *caminho, int formato)
+{
+    const int *elementos = elementos_conjunto(conjunto);
+    int n = tamanho_estrutura(conjunto);
+    int *exportado = NULL;
+    if (!elementos)
+    {
+        exportado = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+        if (!exportado)
+        {
+            return false;
+        }
+        n = exportar_conjunto(conjunto, exportado);
+        elementos = exportado;
+    }
+    bool salvo = persistencia_salvar(caminho, elementos, n, conjunto->automatico ? TIPO_AUTOMATICO : conjunto->tipo, formato);
+    free(exportado);
+    return salvo;
+}
+
+Conjunto *carregar_conjunto(const char *caminho, int tipo)
+{
+    ARQUIVO_CONJUNTO *arquivo = persistencia_abrir(caminho);
+    if (!arquivo)
+    {
+        return NULL;
+    }
+    if (tipo < 0)
+    {
+        tipo = persistencia_tipo(arquivo);
+    }
+    if (tipo < 0 || tipo > TIPO_LISTA_BLOCOS)
+    {
+        persistencia_fechar(&arquivo);
+        return NULL;
+    }
+
+    int n = persistencia_quantidade(arquivo);
+    Conjunto *conjunto = NULL;
+    void *mapa;
+    size_t tamanho_mapa;
+    int *vetor;
+    if ((tipo == 1 || tipo == TIPO_AUTOMATICO) && persistencia_soltar_vetor(arquivo, &mapa, &tamanho_mapa, &vetor))
+    {
+        persistencia_fechar(&arquivo);
+        LISTA *lista = lista_criar_de_mapa(mapa, tamanho_mapa, vetor, n);
+        conjunto = (Conjunto *)malloc(sizeof(Conjunto));
+        if (!lista || !conjunto)
+        {
+            if (lista)
+            {
+                lista_apagar(&lista);
+            }
+            free(conjunto);
+            return NULL;
+        }
+        conjunto->tipo = 1;
+        conjunto->tam = n;
+        conjunto->estrutura = lista;
+        memset(&conjunto->estatisticas, 0, sizeof(ESTATISTICAS));
+        conjunto->automatico = tipo == TIPO_AUTOMATICO;
+        conjunto->saldo_migracao = 0;
+        return conjunto;
+    }
+
+    int *ordenado = (int *)malloc((n > 0 ? n : 1) * sizeof(int));
+    if (ordenado && persistencia_decodificar(arquivo, ordenado) == n)
+    {
+        conjunto = criar_conjunto_de_ordenado(tipo, ordenado, n);
+    }
+    free(ordenado);
+    persistencia_fechar(&arquivo);
+    return conjunto;
+}
+
+/*
+    Impressão em lote:
+        - Em vez de um printf("%d ") por elemento, os elementos são lidos em ordem (direto do vetor da lista,
+          ou exportados das demais estruturas) e formatados com formatar_inteiro em um buffer de TAMANHO_BUFFER_SAIDA bytes
+        - O texto é o mesmo da impressão de cada estrutura: "{" e cada elemento seguido de espaço, "}" e a quebra de linha
+        - imprimir_conjunto escreve no stdout pelo próprio FILE*, então continua na ordem certa com os printf do programa;
+          escrever_conjunto escreve em um descritor e formatar_conjunto em um vetor do chamador
+*/
+static void escrever_conjunto_saida(Conjunto *conjunto, SAIDA *saida)
+{
+    saida_texto(saida, "{", 1);
+    const int *elementos = elementos_conjunto(conjunto);
+    int n = tamanho_estrutura(conjunto);
+    if (elementos)
+    {
+        saida_inteiros(saida, elementos, n, ' ');
+    }
+    else if (n > 0)
+    {
+        int *exportado = (int *)malloc(n * sizeof(int));
+        if (!exportado)
+        {
+            printf("Erro: falha ao alocar memória para a impressão.\n");
+            exit(EXIT_FAILURE);
+        }
+        n = exportar_conjunto(conjunto, exportado);
+        saida_inteiros(saida, exportado, n, ' ');
+        free(exportado);
+    }
+    saida_texto(saida, "}\n", 2);
+    saida_descarregar(saida);
 }
 
 void imprimir_conjunto(Conjunto *conjunto)
 {
+    SAIDA *saida = (SAIDA *)malloc(sizeof(SAIDA));
+    if (!saida)
+    {
+        printf("Erro: falha ao alocar memória para a impressão.\n");
+        exit(EXIT_FAILURE);
+    }
+    saida_iniciar_arquivo(saida, stdout);
+    escrever_conjunto_saida(conjunto, saida);
+    free(saida);
+}
+
+bool escrever_conjunto(Conjunto *conjunto, int fd)
+{
+    SAIDA *saida = (SAIDA *)malloc(sizeof(SAIDA));
+    if (!saida)
+        return false;
+    saida_iniciar_fd(saida, fd);
+    escrever_conjunto_saida(conjunto, saida);
+    bool ok = !saida->erro;
+    free(saida);
+    return ok;
+}
+
+size_t formatar_conjunto(Conjunto *conjunto, char *buffer, size_t capacidade)
+{
+    SAIDA *saida = (SAIDA *)malloc(sizeof(SAIDA));
+    if (!saida)
+    {
+        printf("Erro: falha ao alocar memória para a impressão.\n");
+        exit(EXIT_FAILURE);
+    }
+    saida_iniciar_memoria(saida, buffer, capacidade);
+    escrever_conjunto_saida(conjunto, saida);
+    size_t total = saida->total;
+    free(saida);
+    return total;
+}
+
+/*
+    Iterador: percorre os elementos em ordem crescente sem recursão, podendo parar e continuar entre um elemento e outro
+        - Na AVL, usa a pilha do iterador da árvore (iterador_avl_proximo); na lista, uma posição no vetor
+        - Nas demais estruturas, os elementos são exportados uma vez para um vetor, percorrido como o da lista
+        - buscar_a_partir_de pula direto para o primeiro elemento >= chave: descida na AVL, galope na lista
+    Qualquer alteração no conjunto invalida seus iteradores
+*/
+struct IteradorConjunto
+{
+    int tipo;             // estrutura percorrida: 0 usa "avl"; as demais, "lista"
+    ITERADOR_AVL avl;
+    ITERADOR_LISTA lista;
+    int *exportado;       // tipos 2 a 5 e 7: vetor com os elementos exportados, percorrido por "lista" (NULL nos demais)
+};
+
+static void iniciar_iterador(ITERADOR *iterador, Conjunto *conjunto)
+{
+    iterador->tipo = conjunto->tipo;
+    iterador->exportado = NULL;
     if (conjunto->tipo == 0)
     {
-        imprimir_arvore_avl((ArvoreAVL *)conjunto->estrutura);
+        iterador_avl_iniciar(&iterador->avl, (ArvoreAVL *)conjunto->estrutura);
     }
     else if (conjunto->tipo == 1)
     {
-        lista_imprimir((LISTA *)conjunto->estrutura);
+        lista_iterador_iniciar(&iterador->lista, (LISTA *)conjunto->estrutura);
+    }
+    else
+    {
+        iterador->exportado = (int *)malloc((conjunto->tam > 0 ? conjunto->tam : 1) * sizeof(int));
+        if (!iterador->exportado)
+        {
+            printf("Erro: falha ao alocar memória para o iterador.\n");
+            exit(EXIT_FAILURE);
+        }
+        iterador->lista.vetor = iterador->exportado;
+        iterador->lista.lapides = NULL;
+        iterador->lista.n = exportar_conjunto(conjunto, iterador->exportado);
+        iterador->lista.posicao = 0;
+    }
+}
+
+static void encerrar_iterador(ITERADOR *iterador)
+{
+    free(iterador->exportado);
+    iterador->exportado = NULL;
+}
+
+ITERADOR *iterador_criar(Conjunto *conjunto)
+{
+    ITERADOR *iterador = (ITERADOR *)malloc(sizeof(ITERADOR));
+    if (!iterador)
+    {
+        printf("Erro: falha ao alocar memória para o iterador.\n");
+        exit(EXIT_FAILURE);
+    }
+    iniciar_iterador(iterador, conjunto);
+    return iterador;
+}
+
+bool iterador_proximo(ITERADOR *iterador, int *elemento)
+{
+    if (iterador->tipo == 0)
+    {
+        return iterador_avl_proximo(&iterador->avl, elemento);
+    }
+    return lista_iterador_proximo(&iterador->lista, elemento);
+}
+
+bool iterador_buscar_a_partir_de(ITERADOR *iterador, int chave, int *elemento)
+{
+    if (iterador->tipo == 0)
+    {
+        return iterador_avl_buscar_a_partir_de(&iterador->avl, chave, elemento);
+    }
+    return lista_iterador_buscar_a_partir_de(&iterador->lista, chave, elemento);
+}
+
+void iterador_apagar(ITERADOR **iterador)
+{
+    if (iterador && *iterador)
+    {
+        encerrar_iterador(*iterador);
+        free(*iterador);
+        *iterador = NULL;
     }
-    printf("\n");
+}
+
+/*
+    União e interseção por iteradores: os dois conjuntos são percorridos juntos, em ordem, e os elementos do resultado são
+    escritos em um vetor ordenado, do qual a estrutura de conjunto1 é montada em lote (criar_conjunto_de_ordenado). Custo O(n + m)
+        - União: intercalação simples
+        - Interseção: o iterador que está atrás salta até o elemento do outro (buscar_a_partir_de), então trechos sem elementos
+          comuns custam O(log) em vez de um passo por elemento
+    Funciona com quaisquer duas estruturas, então é usada quando os tipos são diferentes (por exemplo, dois conjuntos automáticos
+    em fases diferentes). Entre duas AVL de tamanhos parecidos e sem threads, também substitui a divisão e junção: percorrer as
+    árvores e montar o resultado de uma vez evita as descidas e rotações de cada junção. Com um conjunto muito menor que o outro,
+    a divisão e junção fica com as descidas do menor, e a intercalação pagaria um passo por elemento do maior
+*/
+static Conjunto *operacao_iteradores(Conjunto *conjunto1, Conjunto *conjunto2, bool uniao)
+{
+    long capacidade = uniao ? (long)conjunto1->tam + conjunto2->tam
+                            : (conjunto1->tam < conjunto2->tam ? conjunto1->tam : conjunto2->tam);
+    int *saida = (int *)malloc((capacidade > 0 ? capacidade : 1) * sizeof(int));
+    if (!saida)
+    {
+        printf("Erro: falha ao alocar memória para a operação entre conjuntos.\n");
+        exit(EXIT_FAILURE);
+    }
+    ITERADOR iterador1, iterador2;
+    iniciar_iterador(&iterador1, conjunto1);
+    iniciar_iterador(&iterador2, conjunto2);
+
+    int a, b, n = 0;
+    bool tem_a = iterador_proximo(&iterador1, &a);
+    bool tem_b = iterador_proximo(&iterador2, &b);
+    if (uniao)
+    {
+        while (tem_a && tem_b)
+        {
+            if (a < b)
+            {
+                saida[n++] = a;
+                tem_a = iterador_proximo(&iterador1, &a);
+            }
+            else if (a > b)
+            {
+                saida[n++] = b;
+                tem_b = iterador_proximo(&iterador2, &b);
+            }
+            else
+            {
+                saida[n++] = a;
+                tem_a = iterador_proximo(&iterador1, &a);
+                tem_b = iterador_proximo(&iterador2, &b);
+            }
+        }
+        for (; tem_a; tem_a = iterador_proximo(&iterador1, &a))
+            saida[n++] = a;
+        for (; tem_b; tem_b = iterador_proximo(&iterador2, &b))
+            saida[n++] = b;
+    }
+    else
+    {
+        while (tem_a && tem_b)
+        {
+            if (a < b)
+            {
+                tem_a = iterador_buscar_a_partir_de(&iterador1, b, &a);
+            }
+            else if (a > b)
+            {
+                tem_b = iterador_buscar_a_partir_de(&iterador2, a, &b);
+            }
+            else
+            {
+                saida[n++] = a;
+                tem_a = iterador_proximo(&iterador1, &a);
+                tem_b = iterador_proximo(&iterador2, &b);
+            }
+        }
+    }
+    encerrar_iterador(&iterador1);
+    encerrar_iterador(&iterador2);
+
+    Conjunto *resultado = criar_conjunto_de_ordenado(conjunto1->tipo, saida, n);
+    resultado->automatico = conjunto1->automatico;
+    free(saida);
+    registrar_uso(conjunto1, USO_OPERACAO_CONJUNTOS, (long)conjunto1->tam + conjunto2->tam);
+    registrar_uso(conjunto2, USO_OPERACAO_CONJUNTOS, (long)conjunto1->tam + conjunto2->tam);
+    return resultado;
 }
 
 /*
     Ideia de Alocação de Memória para Lista:
         - Para união de conjuntos, o pior caso de uso de memória é quando todos os elementos de A são diferentes dos elementos de B
         - Nota-se isso pela relação: A união B = A + B - A intersecção B, o que fica A união B = A + B, Dado A intesecção B = 0
-        - Portanto, aloca-se espaço para o número de elementos de A + os de B
+        - Portanto, aloca-se espaço para o número de elementos de A + os de B (feito dentro de lista_uniao)
+    Na AVL, sem threads e com tamanhos parecidos, as duas árvores são intercaladas por iteradores e o resultado é montado em lote
+    (operacao_iteradores). Com opcoes->threads > 1, ou com o maior conjunto mais de RAZAO_GALOPE vezes maior que o menor, o resultado
+    começa como cópia do maior, montada em O(n) pelo construtor em lote, e recebe o menor por divisão e junção (uniao_arvores_avl),
+    que só desce pelos caminhos das m chaves do menor em vez de percorrer as duas árvores; com threads, a recursão é dividida
+    entre as threads de um único pool (ver uniao_arvores_avl_paralela). A intercalação da lista é dividida como em lista_uniao_paralela
+    Conjuntos com estruturas diferentes também são unidos por operacao_iteradores
 */
-Conjunto *uniao_conjuntos(Conjunto *conjunto1, Conjunto *conjunto2)
+Conjunto *uniao_conjuntos_opcoes(Conjunto *conjunto1, Conjunto *conjunto2, const OpcoesConjunto *opcoes)
 {
-    Conjunto *resultado;
+    int threads = opcoes != NULL ? opcoes->threads : 1;
+    int corte = opcoes != NULL ? opcoes->corte_sequencial : 0;
+    unsigned long long inicio_latencia = latencia_iniciar();
+    Conjunto *maior = conjunto1->tam >= conjunto2->tam ? conjunto1 : conjunto2;
+    Conjunto *menor = maior == conjunto1 ? conjunto2 : conjunto1;
+    bool desbalanceado = (long long)maior->tam > (long long)RAZAO_GALOPE * menor->tam;
+    if (conjunto1->tipo != conjunto2->tipo || (conjunto1->tipo == 0 && threads <= 1 && !desbalanceado))
+    {
+        Conjunto *intercalado = operacao_iteradores(conjunto1, conjunto2, true);
+        latencia_registrar(LATENCIA_UNIAO, inicio_latencia, (long)conjunto1->tam + conjunto2->tam);
+        return intercalado;
+    }
+    Conjunto *resultado = criar_conjunto(conjunto1->tipo, 0);
+    INICIAR_CONTAGEM(resultado);
 
     if (conjunto1->tipo == 0)
     {
-        resultado = criar_conjunto(conjunto1->tipo, 0);
-        resultado->estrutura = uniao_arvores_avl((ArvoreAVL *)conjunto1->estrutura, (ArvoreAVL *)conjunto2->estrutura);
+        int *ordenado = (int *)malloc((maior->tam > 0 ? maior->tam : 1) * sizeof(int));
+        if (!ordenado)
+        {
+            printf("Erro: falha ao alocar memória para a união.\n");
+            exit(EXIT_FAILURE);
+        }
+        int n = exportar_arvore_avl((ArvoreAVL *)maior->estrutura, ordenado);
+        apagar_arvore_avl((ArvoreAVL **)&(resultado->estrutura));
+        resultado->estrutura = criar_arvore_avl_de_vetor(ordenado, n);
+        free(ordenado);
+        if (!uniao_arvores_avl_paralela((ArvoreAVL *)resultado->estrutura, (ArvoreAVL *)menor->estrutura, threads, corte))
+        {
+            printf("Erro: falha ao alocar memória para a união.\n");
+            exit(EXIT_FAILURE);
+        }
     }
     else if (conjunto1->tipo == 1)
     {
-        resultado = criar_conjunto(conjunto1->tipo, conjunto1->tam + conjunto2->tam);
-        resultado->estrutura = lista_uniao((LISTA *)conjunto1->estrutura, (LISTA *)conjunto2->estrutura);
+        lista_apagar((LISTA **)&(resultado->estrutura));
+        resultado->estrutura = lista_uniao_paralela((LISTA *)conjunto1->estrutura, (LISTA *)conjunto2->estrutura, threads);
+    }
+    else if (conjunto1->tipo == 2)
+    {
+        mapa_bits_apagar((MAPA_BITS **)&(resultado->estrutura));
+        resultado->estrutura = mapa_bits_uniao((MAPA_BITS *)conjunto1->estrutura, (MAPA_BITS *)conjunto2->estrutura);
     }
+    else if (conjunto1->tipo == 3)
+    {
+        tabela_hash_apagar((TABELA_HASH **)&(resultado->estrutura));
+        resultado->estrutura = tabela_hash_uniao((TABELA_HASH *)conjunto1->estrutura, (TABELA_HASH *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 4)
+    {
+        arvore_b_apagar((ARVORE_B **)&(resultado->estrutura));
+        resultado->estrutura = arvore_b_uniao((ARVORE_B *)conjunto1->estrutura, (ARVORE_B *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 5)
+    {
+        avl_compacta_apagar((AVL_COMPACTA **)&(resultado->estrutura));
+        resultado->estrutura = avl_compacta_uniao((AVL_COMPACTA *)conjunto1->estrutura, (AVL_COMPACTA *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 7)
+    {
+        lista_blocos_apagar((LISTA_BLOCOS **)&(resultado->estrutura));
+        resultado->estrutura = lista_blocos_uniao((LISTA_BLOCOS *)conjunto1->estrutura, (LISTA_BLOCOS *)conjunto2->estrutura);
+    }
+    resultado->tam = tamanho_estrutura(resultado);
+    resultado->automatico = conjunto1->automatico;
+    registrar_uso(conjunto1, USO_OPERACAO_CONJUNTOS, (long)conjunto1->tam + conjunto2->tam);
+    registrar_uso(conjunto2, USO_OPERACAO_CONJUNTOS, (long)conjunto1->tam + conjunto2->tam);
+    ENCERRAR_CONTAGEM();
+    latencia_registrar(LATENCIA_UNIAO, inicio_latencia, (long)conjunto1->tam + conjunto2->tam);
     return resultado;
 }
 /*
     Ideia de Alocação de Memória:
         - Para interseção de conjuntos, no que tange pior caso de memória, o pior caso é quando todos os elementos de um conjunto pertencem ao outro
-        - Portanto, aloca-se espaço para o número de elementos do menor conjunto
+        - Portanto, aloca-se espaço para o número de elementos do menor conjunto (feito dentro de lista_intersecao)
+    Escolha do algoritmo (pelos tamanhos guardados em "tam"):
+        - Se o maior conjunto tem mais de RAZAO_GALOPE vezes os elementos do menor, compensa procurar cada elemento do menor no maior:
+          galope (busca exponencial) na lista, ou uma descida por elemento na AVL
+        - Caso contrário, usa-se a intercalação linear na lista e, na AVL, a interseção por iteradores (operacao_iteradores) ou,
+          com opcoes->threads > 1, a divisão e junção; ambas as intercalações são divididas entre opcoes->threads threads
+    Conjuntos com estruturas diferentes passam sempre por operacao_iteradores
 */
-Conjunto *intersecao_conjuntos(Conjunto *conjunto1, Conjunto *conjunto2)
+Conjunto *intersecao_conjuntos_opcoes(Conjunto *conjunto1, Conjunto *conjunto2, const OpcoesConjunto *opcoes)
 {
-    Conjunto *resultado;
+    int threads = opcoes != NULL ? opcoes->threads : 1;
+    int corte = opcoes != NULL ? opcoes->corte_sequencial : 0;
+    unsigned long long inicio_latencia = latencia_iniciar();
+    Conjunto *menor = conjunto1->tam <= conjunto2->tam ? conjunto1 : conjunto2;
+    Conjunto *maior = menor == conjunto1 ? conjunto2 : conjunto1;
+    bool desbalanceado = (long long)maior->tam > (long long)RAZAO_GALOPE * menor->tam;
+    if (conjunto1->tipo != conjunto2->tipo || (conjunto1->tipo == 0 && threads <= 1 && !desbalanceado))
+    {
+        Conjunto *intercalado = operacao_iteradores(conjunto1, conjunto2, false);
+        latencia_registrar(LATENCIA_INTERSECAO, inicio_latencia, (long)conjunto1->tam + conjunto2->tam);
+        return intercalado;
+    }
+    Conjunto *resultado = criar_conjunto(conjunto1->tipo, 0);
+    INICIAR_CONTAGEM(resultado);
 
     if (conjunto1->tipo == 0)
     {
-        resultado = criar_conjunto(conjunto1->tipo, 0);
-        if (conjunto1->tam >= conjunto2->tam)
+        apagar_arvore_avl((ArvoreAVL **)&(resultado->estrutura)); // substituída pela árvore da interseção
+        if (desbalanceado)
         {
-            resultado->estrutura = intersecao_arvores_avl((ArvoreAVL *)conjunto2->estrutura, (ArvoreAVL *)conjunto1->estrutura);
+            resultado->estrutura = intersecao_busca_arvores_avl((ArvoreAVL *)menor->estrutura, (ArvoreAVL *)maior->estrutura, menor->tam);
         }
         else
         {
-            resultado->estrutura = intersecao_arvores_avl((ArvoreAVL *)conjunto1->estrutura, (ArvoreAVL *)conjunto2->estrutura);
+            resultado->estrutura = intersecao_arvores_avl_paralela((ArvoreAVL *)menor->estrutura, (ArvoreAVL *)maior->estrutura, threads, corte);
+        }
+        if (!resultado->estrutura)
+        {
+            printf("Erro: falha ao alocar memória para a interseção.\n");
+            exit(EXIT_FAILURE);
         }
     }
     else if (conjunto1->tipo == 1)
     {
-        if (conjunto1->tam >= conjunto2->tam)
+        lista_apagar((LISTA **)&(resultado->estrutura)); // substituída pela lista da interseção
+        if (desbalanceado)
         {
-            resultado = criar_conjunto(conjunto1->tipo, conjunto2->tam);
+            resultado->estrutura = lista_intersecao_galope((LISTA *)menor->estrutura, (LISTA *)maior->estrutura);
         }
         else
         {
-            resultado = criar_conjunto(conjunto1->tipo, conjunto1->tam);
+            resultado->estrutura = lista_intersecao_paralela((LISTA *)conjunto1->estrutura, (LISTA *)conjunto2->estrutura, threads);
         }
-        resultado->estrutura = lista_intersecao((LISTA *)conjunto1->estrutura, (LISTA *)conjunto2->estrutura);
     }
+    else if (conjunto1->tipo == 2)
+    {
+        mapa_bits_apagar((MAPA_BITS **)&(resultado->estrutura)); // substituído pelo mapa da interseção
+        resultado->estrutura = mapa_bits_intersecao((MAPA_BITS *)conjunto1->estrutura, (MAPA_BITS *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 3)
+    {
+        tabela_hash_apagar((TABELA_HASH **)&(resultado->estrutura)); // substituída pela tabela da interseção
+        resultado->estrutura = tabela_hash_intersecao((TABELA_HASH *)conjunto1->estrutura, (TABELA_HASH *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 4)
+    {
+        arvore_b_apagar((ARVORE_B **)&(resultado->estrutura)); // substituída pela árvore da interseção
+        resultado->estrutura = arvore_b_intersecao((ARVORE_B *)conjunto1->estrutura, (ARVORE_B *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 5)
+    {
+        avl_compacta_apagar((AVL_COMPACTA **)&(resultado->estrutura)); // substituída pela árvore da interseção
+        resultado->estrutura = avl_compacta_intersecao((AVL_COMPACTA *)conjunto1->estrutura, (AVL_COMPACTA *)conjunto2->estrutura);
+    }
+    else if (conjunto1->tipo == 7)
+    {
+        lista_blocos_apagar((LISTA_BLOCOS **)&(resultado->estrutura)); // substituída pela lista da interseção
+        resultado->estrutura = lista_blocos_intersecao((LISTA_BLOCOS *)conjunto1->estrutura, (LISTA_BLOCOS *)conjunto2->estrutura);
+    }
+    resultado->tam = tamanho_estrutura(resultado);
+    resultado->automatico = conjunto1->automatico;
+    registrar_uso(conjunto1, USO_OPERACAO_CONJUNTOS, (long)conjunto1->tam + conjunto2->tam);
+    registrar_uso(conjunto2, USO_OPERACAO_CONJUNTOS, (long)conjunto1->tam + conjunto2->tam);
+    ENCERRAR_CONTAGEM();
+    latencia_registrar(LATENCIA_INTERSECAO, inicio_latencia, (long)conjunto1->tam + conjunto2->tam);
     return resultado;
+}
+
+Conjunto *uniao_conjuntos(Conjunto *conjunto1, Conjunto *conjunto2)
+{
+    return uniao_conjuntos_opcoes(conjunto1, conjunto2, NULL);
+}
+
+Conjunto *intersecao_conjuntos(Conjunto *conjunto1, Conjunto *conjunto2)
+{
+    return intersecao_conjuntos_opcoes(conjunto1, conjunto2, NULL);
 }
\ No newline at end of file
@@ -1,10 +1,31 @@
 #ifndef CONJUNTO_H
 #define CONJUNTO_H
+#include <stddef.h>
+#include "estatisticas.h"
+#include "arvore_avl.h"
 
 typedef struct Conjunto Conjunto;
+typedef struct IteradorConjunto ITERADOR;
 
-// Cria um conjunto com a estrutura que for escolhida ( 1: avl, 2: (a q vcs decidirem :
+// Opções das operações entre conjuntos (NULL -> padrão)
+typedef struct OpcoesConjunto
+{
+    int threads;           // threads da união/intersecção da lista e da AVL (padrão: 1, sequencial)
+    int corte_sequencial;  // AVL: subárvores menores que isso não são divididas entre threads (0 -> CORTE_SEQUENCIAL_AVL)
+} OpcoesConjunto;
+
+// Tipo automático: o conjunto começa como lista e passa para a AVL (e volta) conforme a mistura de operações e o tamanho
+#define TIPO_AUTOMATICO 6
+
+// Lista em blocos: lista sequencial ordenada dividida em blocos de CHAVES_BLOCO chaves, com inserção e remoção em O(raiz de n)
+#define TIPO_LISTA_BLOCOS 7
+
+// Cria um conjunto com a estrutura que for escolhida (0: AVL, 1: lista sequencial ordenada, 2: mapa de bits comprimido, 3: tabela hash, 4: árvore B+, 5: AVL compacta, 6: automático, 7: lista em blocos)
 Conjunto *criar_conjunto(int tipo, int tam); // int tam caso a lista seja dinamica
+// Cria um conjunto a partir de um vetor de elementos (em qualquer ordem, podendo ter repetidos)
+Conjunto *criar_conjunto_de_vetor(int tipo, const int *vetor, int n);
+// Cria um conjunto a partir de um vetor já ordenado e sem repetidos (sem ordenar de novo)
+Conjunto *criar_conjunto_de_ordenado(int tipo, const int *ordenado, int n);
 // Apaga o conjunto
 void apagar_conjunto(Conjunto *conjunto);
 
@@ -14,16 +35,101 @@ bool inserir_elemento(Conjunto *conjunto, int elemento);
 // Remove um elemento
 bool remover_elemento(Conjunto *conjunto, int elemento);
 
+// Insere um lote de elementos (em qualquer ordem), retornando quantos eram novos
+size_t inserir_elementos(Conjunto *conjunto, const int *elementos, size_t k);
+
+// Remove um lote de elementos (em qualquer ordem), retornando quantos foram removidos
+size_t remover_elementos(Conjunto *conjunto, const int *elementos, size_t k);
+
+// Contadores de operações do conjunto (comparações, rotações, nós alocados e liberados, deslocamentos e realocações)
+ESTATISTICAS obter_estatisticas(Conjunto *conjunto);
+
+// Volta os contadores de operações do conjunto a 0
+void zerar_estatisticas(Conjunto *conjunto);
+
+// Contadores do alocador de nós da AVL (slabs, capacidade, nós em uso e livres); zerados nas outras estruturas
+OCUPACAO ocupacao_conjunto(Conjunto *conjunto);
+
+// Estrutura em uso pelo conjunto (0 a 5 ou 7); no tipo automático, a atual
+int estrutura_conjunto(Conjunto *conjunto);
+
+// Quantidade de elementos do conjunto
+int tamanho_conjunto(Conjunto *conjunto);
+
 // Verifica se o elemento pertence ao conjunto
 bool pertence_conjunto(Conjunto *conjunto, int elemento);
 
+// Verifica k elementos de uma vez: out[i] diz se keys[i] pertence ao conjunto; retorna quantos pertencem
+size_t pertence_lote(Conjunto *conjunto, const int *keys, size_t k, bool *out);
+
+// Prepara a lista para muitas buscas (layout de Eytzinger); retorna false se o tipo não tem layout de leitura
+bool otimizar_busca_conjunto(Conjunto *conjunto, bool ativar);
+
+// Remoções na lista só marcam a posição (lápide) e a compactação é feita de uma vez; retorna false se o tipo não é lista
+bool remocao_preguicosa_conjunto(Conjunto *conjunto, bool ativar);
+
+// Compacta agora as lápides da lista (por exemplo, antes de uma fase só de leitura); retorna false se o tipo não é lista
+bool compactar_conjunto(Conjunto *conjunto);
+
+// Garante espaço na lista para "capacidade" elementos com uma única realocação; retorna false se o tipo não é lista ou faltou memória
+bool reservar_conjunto(Conjunto *conjunto, int capacidade);
+
+// Fator pelo qual a capacidade da lista é multiplicada quando ela enche (> 1, padrão FATOR_CRESCIMENTO); retorna false se o tipo
+// não é lista ou o fator é inválido
+bool fator_crescimento_conjunto(Conjunto *conjunto, float fator);
+
+// Fração máxima de posições usadas da tabela hash antes de ela dobrar (entre 0.1 e 0.97, padrão FATOR_CARGA); a tabela cresce na
+// hora se o novo fator já foi passado. Retorna false se o tipo não é tabela hash, o fator está fora dos limites ou faltou memória
+bool fator_carga_conjunto(Conjunto *conjunto, float fator);
+
+// Quantos elementos cabem na lista sem realocação, ou quantas posições tem a tabela hash; -1 nas outras estruturas
+int capacidade_conjunto(Conjunto *conjunto);
+
+// Reduz a capacidade da lista ao seu tamanho (compactando as lápides antes); retorna false se o tipo não é lista ou faltou memória
+bool ajustar_capacidade_conjunto(Conjunto *conjunto);
+
+// Escreve os elementos em ordem crescente em "saida" (com espaço para tamanho_conjunto elementos), retornando quantos foram escritos
+int exportar_conjunto(Conjunto *conjunto, int *saida);
+
+// Vetor ordenado dos elementos, quando a estrutura guarda um (lista); NULL nas demais e na lista com lápides (remoção preguiçosa),
+// que não é compactada aqui: use exportar_conjunto ou compactar_conjunto antes. Só leitura, invalidado por alterações
+const int *elementos_conjunto(Conjunto *conjunto);
+
+// Cria um iterador que percorre os elementos em ordem crescente (alterar o conjunto invalida seus iteradores)
+ITERADOR *iterador_criar(Conjunto *conjunto);
+
+// Escreve em "elemento" o próximo elemento; retorna false quando os elementos acabam
+bool iterador_proximo(ITERADOR *iterador, int *elemento);
+
+// Pula para o primeiro elemento ainda não visitado >= chave e o escreve em "elemento"; retorna false se não houver
+bool iterador_buscar_a_partir_de(ITERADOR *iterador, int chave, int *elemento);
+
+// Apaga o iterador (o conjunto não é alterado)
+void iterador_apagar(ITERADOR **iterador);
+
+// Grava o conjunto em "caminho" (FORMATO_COMPRIMIDO ou FORMATO_VETOR, de persistencia.h); retorna false se a gravação falhou
+bool salvar_conjunto(Conjunto *conjunto, const char *caminho, int formato);
+
+// Carrega um conjunto gravado por salvar_conjunto na estrutura "tipo" (tipo < 0: a do arquivo); NULL se o arquivo for inválido
+Conjunto *carregar_conjunto(const char *caminho, int tipo);
+
 // Imprime o conjunto
 void imprimir_conjunto(Conjunto *conjunto);
 
+// Escreve o mesmo texto de imprimir_conjunto no descritor fd; retorna false se a escrita falhou
+bool escrever_conjunto(Conjunto *conjunto, int fd);
+
+// Escreve o mesmo texto de imprimir_conjunto em "buffer" (sem '\0'), até "capacidade" bytes; retorna o tamanho total do texto
+size_t formatar_conjunto(Conjunto *conjunto, char *buffer, size_t capacidade);
+
 // uni dois conjuntos
 Conjunto *uniao_conjuntos(Conjunto *conjunto1, Conjunto *conjunto2);
 
 // intersecção de conjuntos
 Conjunto *intersecao_conjuntos(Conjunto *conjunto1, Conjunto *conjunto2);
 
+// União e intersecção com opções (ver OpcoesConjunto)
+Conjunto *uniao_conjuntos_opcoes(Conjunto *conjunto1, Conjunto *conjunto2, const OpcoesConjunto *opcoes);
+Conjunto *intersecao_conjuntos_opcoes(Conjunto *conjunto1, Conjunto *conjunto2, const OpcoesConjunto *opcoes);
+
 #endif
\ No newline at end of file
@@ -0,0 +1,143 @@
+#define _POSIX_C_SOURCE 200809L // mmap, posix_madvise e lseek com -std=c99
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <errno.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "entrada.h"
+
+/*
+Entrada: todo o conteúdo do descritor em memória, lido da posição "posicao" em diante
+"mapeado" diz se os dados vêm de mmap (liberados com munmap) ou de um buffer alocado (liberado com free)
+*/
+struct Entrada
+{
+    char *dados;
+    size_t tamanho;
+    size_t posicao;
+    bool mapeado;
+};
+
+/*
+    Ler tudo
+    Ideia: para o que não pode ser mapeado, lê com read(2) em um buffer que dobra de tamanho quando enche
+*/
+static bool ler_tudo(ENTRADA *entrada, int fd)
+{
+    size_t capacidade = TAMANHO_INICIAL_ENTRADA;
+    entrada->dados = (char *)malloc(capacidade);
+    if (!entrada->dados)
+        return false;
+    entrada->tamanho = 0;
+    while (true)
+    {
+        if (entrada->tamanho == capacidade)
+        {
+            char *novo = (char *)realloc(entrada->dados, capacidade * 2);
+            if (!novo)
+                return false;
+            entrada->dados = novo;
+            capacidade *= 2;
+        }
+        ssize_t r = read(fd, entrada->dados + entrada->tamanho, capacidade - entrada->tamanho);
+        if (r < 0 && errno == EINTR)
+            continue;
+        if (r < 0)
+            return false;
+        if (r == 0)
+            return true;
+        entrada->tamanho += (size_t)r;
+    }
+}
+
+ENTRADA *entrada_abrir(int fd)
+{
+    ENTRADA *entrada = (ENTRADA *)malloc(sizeof(ENTRADA));
+    if (!entrada)
+        return NULL;
+    entrada->dados = NULL;
+    entrada->tamanho = 0;
+    entrada->posicao = 0;
+    entrada->mapeado = false;
+
+    struct stat info;
+    if (fstat(fd, &info) == 0 && S_ISREG(info.st_mode) && info.st_size > 0)
+    {
+        off_t inicio = lseek(fd, 0, SEEK_CUR); // o que já foi consumido do descritor fica de fora
+        if (inicio >= 0 && inicio < info.st_size)
+        {
+            void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapa != MAP_FAILED)
+            {
+                posix_madvise(mapa, (size_t)info.st_size, POSIX_MADV_SEQUENTIAL);
+                entrada->dados = (char *)mapa;
+                entrada->tamanho = (size_t)info.st_size;
+                entrada->posicao = (size_t)inicio;
+                entrada->mapeado = true;
+                return entrada;
+            }
+        }
+    }
+    if (!ler_tudo(entrada, fd))
+    {
+        free(entrada->dados);
+        free(entrada);
+        return NULL;
+    }
+    return entrada;
+}
+
+/*
+    Ler inteiro
+    Ideia: pula os espaços em branco (como o " %d" do scanf), aceita um sinal e acumula os dígitos sem sinal,
+    convertendo no fim (assim -2147483648 é lido sem transbordar)
+*/
+bool entrada_inteiro(ENTRADA *entrada, int *valor)
+{
+    const char *p = entrada->dados + entrada->posicao;
+    const char *fim = entrada->dados + entrada->tamanho;
+    while (p < fim && (*p == ' ' || (*p >= '\t' && *p <= '\r')))
+        p++;
+    bool negativo = false;
+    if (p < fim && (*p == '-' || *p == '+'))
+    {
+        negativo = *p == '-';
+        p++;
+    }
+    if (p == fim || *p < '0' || *p > '9')
+    {
+        entrada->posicao = (size_t)(p - entrada->dados);
+        return false;
+    }
+    unsigned modulo = 0;
+    while (p < fim && *p >= '0' && *p <= '9')
+    {
+        modulo = modulo * 10 + (unsigned)(*p - '0');
+        p++;
+    }
+    entrada->posicao = (size_t)(p - entrada->dados);
+    *valor = negativo ? (int)(0u - modulo) : (int)modulo;
+    return true;
+}
+
+int entrada_inteiros(ENTRADA *entrada, int *valores, int n)
+{
+    int lidos = 0;
+    while (lidos < n && entrada_inteiro(entrada, &valores[lidos]))
+        lidos++;
+    return lidos;
+}
+
+void entrada_fechar(ENTRADA **entrada)
+{
+    if (!entrada || !*entrada)
+        return;
+    if ((*entrada)->mapeado)
+        munmap((*entrada)->dados, (*entrada)->tamanho);
+    else
+        free((*entrada)->dados);
+    free(*entrada);
+    *entrada = NULL;
+}
@@ -0,0 +1,21 @@
+#ifndef ENTRADA_H
+#define ENTRADA_H
+#include <stddef.h>
+#include <stdbool.h>
+
+// Tamanho inicial do buffer quando a entrada não pode ser mapeada (pipe, terminal); dobra conforme necessário
+#define TAMANHO_INICIAL_ENTRADA 65536
+
+typedef struct Entrada ENTRADA;
+
+// Abre a entrada inteira de um descritor: mmap se for um arquivo comum, read(2) nos demais casos
+ENTRADA *entrada_abrir(int fd);
+
+// Lê o próximo inteiro (ignorando espaços em branco antes dele); retorna false no fim da entrada ou se não houver um número
+bool entrada_inteiro(ENTRADA *entrada, int *valor);
+
+// Lê até n inteiros para o vetor, retornando quantos foram lidos
+int entrada_inteiros(ENTRADA *entrada, int *valores, int n);
+
+void entrada_fechar(ENTRADA **entrada);
+#endif
@@ -0,0 +1,9 @@
+#include <stddef.h>
+#include "estatisticas.h"
+
+#if CONTAR_ESTATISTICAS
+/*
+Cada thread tem seu ponteiro: as threads auxiliares das operações paralelas ficam com NULL e não disputam os contadores
+*/
+__thread ESTATISTICAS *estatisticas_atuais = NULL;
+#endif
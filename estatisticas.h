@@ -0,0 +1,38 @@
+#ifndef ESTATISTICAS_H
+#define ESTATISTICAS_H
+
+// Contagem de operações das estruturas; compilar com -DCONTAR_ESTATISTICAS=0 tira toda a contagem do código
+#ifndef CONTAR_ESTATISTICAS
+#define CONTAR_ESTATISTICAS 1
+#endif
+
+/*
+Estatísticas: contadores de operações de um conjunto
+comparacoes: comparações de chaves nas descidas e buscas binárias; rotacoes: rotações das AVLs;
+alocacoes e liberacoes: nós das AVLs obtidos e devolvidos; deslocamentos: elementos movidos uma posição na inserção e remoção da lista;
+realocacoes: trocas de tamanho de vetor (crescimento e lista_realocar na lista, crescimento do vetor de nós na AVL compacta)
+*/
+typedef struct Estatisticas
+{
+    unsigned long long comparacoes;
+    unsigned long long rotacoes;
+    unsigned long long alocacoes;
+    unsigned long long liberacoes;
+    unsigned long long deslocamentos;
+    unsigned long long realocacoes;
+} ESTATISTICAS;
+
+#if CONTAR_ESTATISTICAS
+// Contadores que recebem a contagem feita nesta thread (NULL: nada é contado); conjunto.c aponta para os do conjunto em uso
+extern __thread ESTATISTICAS *estatisticas_atuais;
+#define CONTAR(campo, quantidade)                              \
+    do                                                         \
+    {                                                          \
+        if (estatisticas_atuais)                               \
+            estatisticas_atuais->campo += (quantidade);        \
+    } while (0)
+#else
+#define CONTAR(campo, quantidade) ((void)0)
+#endif
+
+#endif
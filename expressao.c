@@ -0,0 +1,394 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <limits.h>
+#include "conjunto.h"
+#include "expressao.h"
+
+#define EXPRESSAO_CONJUNTO 0
+#define EXPRESSAO_UNIAO 1
+#define EXPRESSAO_INTERSECAO 2
+#define EXPRESSAO_DIFERENCA 3
+
+/*
+Expressão: nó do DAG de operações
+Folhas apontam para um Conjunto; nós de operação, para os dois operandos. Um nó pode ser operando de vários outros
+(expressao_compartilhar), por isso cada um conta as suas referências
+*/
+struct Expressao
+{
+    int operacao;
+    Conjunto *conjunto; // só nas folhas
+    EXPRESSAO *esquerda;
+    EXPRESSAO *direita;
+    int referencias;
+};
+
+/*
+Cursor: percorre em ordem crescente os elementos de uma subexpressão, sem materializá-los
+    - folha: índice no vetor ordenado do conjunto (o da própria lista, ou uma exportação para as demais estruturas)
+    - união: o menor dos elementos atuais dos operandos
+    - intersecção: salto entre os operandos (leapfrog) até todos pararem no mesmo elemento
+    - diferença: elementos da base que nenhum dos operandos subtraídos contém
+Uniões de uniões e intersecções de intersecções viram um só cursor com vários operandos, assim como (A - B) - C,
+que vira A - {C, B}. "estimativa" é um limite superior da quantidade de elementos
+*/
+typedef struct Cursor
+{
+    int operacao;
+    int atual;
+    bool fim;
+    long long estimativa;
+    const int *vetor; // folha
+    int n, i;         // folha
+    int *exportado;   // folha: vetor alocado para estruturas sem vetor ordenado
+    struct Cursor **operandos;
+    int quantidade;
+} CURSOR;
+
+static void *alocar(size_t bytes)
+{
+    void *p = malloc(bytes > 0 ? bytes : 1);
+    if (!p)
+    {
+        printf("Erro: falha ao alocar memória para a expressão.\n");
+        exit(EXIT_FAILURE);
+    }
+    return p;
+}
+
+static EXPRESSAO *criar_expressao(int operacao, Conjunto *conjunto, EXPRESSAO *a, EXPRESSAO *b)
+{
+    EXPRESSAO *e = (EXPRESSAO *)alocar(sizeof(EXPRESSAO));
+    e->operacao = operacao;
+    e->conjunto = conjunto;
+    e->esquerda = a;
+    e->direita = b;
+    e->referencias = 1;
+    return e;
+}
+
+EXPRESSAO *expressao_conjunto(Conjunto *conjunto)
+{
+    return criar_expressao(EXPRESSAO_CONJUNTO, conjunto, NULL, NULL);
+}
+
+EXPRESSAO *expressao_uniao(EXPRESSAO *a, EXPRESSAO *b)
+{
+    return criar_expressao(EXPRESSAO_UNIAO, NULL, a, b);
+}
+
+EXPRESSAO *expressao_intersecao(EXPRESSAO *a, EXPRESSAO *b)
+{
+    return criar_expressao(EXPRESSAO_INTERSECAO, NULL, a, b);
+}
+
+EXPRESSAO *expressao_diferenca(EXPRESSAO *a, EXPRESSAO *b)
+{
+    return criar_expressao(EXPRESSAO_DIFERENCA, NULL, a, b);
+}
+
+EXPRESSAO *expressao_compartilhar(EXPRESSAO *expressao)
+{
+    if (expressao)
+        expressao->referencias++;
+    return expressao;
+}
+
+void expressao_apagar(EXPRESSAO **expressao)
+{
+    if (!expressao || !*expressao)
+        return;
+    EXPRESSAO *e = *expressao;
+    *expressao = NULL;
+    if (--e->referencias > 0)
+        return;
+    expressao_apagar(&e->esquerda);
+    expressao_apagar(&e->direita);
+    free(e);
+}
+
+/////// CURSORES ///////
+
+static void cursor_buscar(CURSOR *c, int chave);
+static void cursor_avancar(CURSOR *c);
+
+/*
+    Posicionar
+    Ideia: depois que os operandos avançaram, acha o elemento atual do cursor (ver a descrição de cada operação em CURSOR)
+*/
+static void cursor_posicionar(CURSOR *c)
+{
+    if (c->operacao == EXPRESSAO_CONJUNTO)
+    {
+        c->fim = c->i >= c->n;
+        if (!c->fim)
+            c->atual = c->vetor[c->i];
+    }
+    else if (c->operacao == EXPRESSAO_UNIAO)
+    {
+        c->fim = true;
+        for (int k = 0; k < c->quantidade; k++)
+        {
+            CURSOR *o = c->operandos[k];
+            if (!o->fim && (c->fim || o->atual < c->atual))
+            {
+                c->atual = o->atual;
+                c->fim = false;
+            }
+        }
+    }
+    else if (c->operacao == EXPRESSAO_INTERSECAO)
+    {
+        // salta de operando em operando até todos estarem no mesmo elemento
+        int chave = c->operandos[0]->atual;
+        int alinhados = 0;
+        for (int k = 0; alinhados < c->quantidade; k = (k + 1) % c->quantidade)
+        {
+            CURSOR *o = c->operandos[k];
+            cursor_buscar(o, chave);
+            if (o->fim)
+            {
+                c->fim = true;
+                return;
+            }
+            if (o->atual == chave)
+            {
+                alinhados++;
+            }
+            else
+            {
+                chave = o->atual;
+                alinhados = 1;
+            }
+        }
+        c->atual = chave;
+        c->fim = false;
+    }
+    else
+    {
+        CURSOR *base = c->operandos[0];
+        while (!base->fim)
+        {
+            bool removido = false;
+            for (int k = 1; k < c->quantidade && !removido; k++)
+            {
+                cursor_buscar(c->operandos[k], base->atual);
+                removido = !c->operandos[k]->fim && c->operandos[k]->atual == base->atual;
+            }
+            if (!removido)
+            {
+                c->atual = base->atual;
+                c->fim = false;
+                return;
+            }
+            cursor_avancar(base);
+        }
+        c->fim = true;
+    }
+}
+
+/*
+    Buscar
+    Parâmetros: cursor e chave
+    Ideia: avança o cursor até o primeiro elemento >= chave (nunca volta). Na folha, por galope: passos que dobram a partir
+    da posição atual e busca binária no último passo, O(log d) para um salto de d posições
+*/
+static void cursor_buscar(CURSOR *c, int chave)
+{
+    if (c->fim || c->atual >= chave)
+        return;
+    if (c->operacao == EXPRESSAO_CONJUNTO)
+    {
+        int inf = c->i, passo = 1; // vetor[inf] < chave
+        while (inf + passo < c->n && c->vetor[inf + passo] < chave)
+        {
+            inf += passo;
+            passo *= 2;
+        }
+        int sup = inf + passo < c->n ? inf + passo : c->n;
+        while (sup - inf > 1)
+        {
+            int meio = inf + (sup - inf) / 2;
+            if (c->vetor[meio] < chave)
+                inf = meio;
+            else
+                sup = meio;
+        }
+        c->i = sup;
+    }
+    else if (c->operacao == EXPRESSAO_DIFERENCA)
+    {
+        cursor_buscar(c->operandos[0], chave);
+    }
+    else
+    {
+        for (int k = 0; k < c->quantidade; k++)
+        {
+            cursor_buscar(c->operandos[k], chave);
+        }
+    }
+    cursor_posicionar(c);
+}
+
+// Próximo elemento: como os elementos são inteiros distintos, é o primeiro >= atual + 1
+static void cursor_avancar(CURSOR *c)
+{
+    if (c->fim)
+        return;
+    if (c->atual == INT_MAX)
+    {
+        c->fim = true;
+        return;
+    }
+    cursor_buscar(c, c->atual + 1);
+}
+
+static void adicionar(EXPRESSAO ***vetor, int *n, int *capacidade, EXPRESSAO *e)
+{
+    if (*n == *capacidade)
+    {
+        *capacidade *= 2;
+        EXPRESSAO **novo = (EXPRESSAO **)realloc(*vetor, *capacidade * sizeof(EXPRESSAO *));
+        if (!novo)
+        {
+            printf("Erro: falha ao alocar memória para a expressão.\n");
+            exit(EXIT_FAILURE);
+        }
+        *vetor = novo;
+    }
+    (*vetor)[(*n)++] = e;
+}
+
+/*
+    Coletar operandos
+    Ideia: desce pelos operandos que são da mesma operação associativa (união ou intersecção), juntando-os em um vetor
+*/
+static void coletar(EXPRESSAO *e, int operacao, EXPRESSAO ***vetor, int *n, int *capacidade)
+{
+    if (e->operacao != operacao)
+    {
+        adicionar(vetor, n, capacidade, e);
+        return;
+    }
+    coletar(e->esquerda, operacao, vetor, n, capacidade);
+    coletar(e->direita, operacao, vetor, n, capacidade);
+}
+
+static CURSOR *montar_cursor(EXPRESSAO *e, bool reordenar)
+{
+    CURSOR *c = (CURSOR *)alocar(sizeof(CURSOR));
+    c->operacao = e->operacao;
+    c->exportado = NULL;
+    c->operandos = NULL;
+    c->quantidade = 0;
+    c->i = 0;
+
+    if (e->operacao == EXPRESSAO_CONJUNTO)
+    {
+        c->n = tamanho_conjunto(e->conjunto);
+        c->vetor = elementos_conjunto(e->conjunto);
+        if (!c->vetor)
+        {
+            c->exportado = (int *)alocar(c->n * sizeof(int));
+            c->n = exportar_conjunto(e->conjunto, c->exportado);
+            c->vetor = c->exportado;
+        }
+        c->estimativa = c->n;
+        cursor_posicionar(c);
+        return c;
+    }
+
+    int capacidade = 4;
+    EXPRESSAO **filhos = (EXPRESSAO **)alocar(capacidade * sizeof(EXPRESSAO *));
+    if (e->operacao == EXPRESSAO_DIFERENCA)
+    {
+        EXPRESSAO *base = e;
+        while (base->operacao == EXPRESSAO_DIFERENCA)
+            base = base->esquerda;
+        filhos[c->quantidade++] = base;
+        // (A - B) - C = A - {C, B}: só a esquerda se achata, já que A - (B - C) não é A - B - C
+        for (EXPRESSAO *d = e; d->operacao == EXPRESSAO_DIFERENCA; d = d->esquerda)
+            adicionar(&filhos, &c->quantidade, &capacidade, d->direita);
+    }
+    else
+    {
+        coletar(e, e->operacao, &filhos, &c->quantidade, &capacidade);
+    }
+
+    c->operandos = (CURSOR **)alocar(c->quantidade * sizeof(CURSOR *));
+    for (int k = 0; k < c->quantidade; k++)
+    {
+        c->operandos[k] = montar_cursor(filhos[k], reordenar);
+    }
+    free(filhos);
+
+    if (e->operacao == EXPRESSAO_INTERSECAO && reordenar)
+    {
+        // o operando com menos elementos guia os saltos da intersecção (inserção direta: são poucos operandos)
+        for (int k = 1; k < c->quantidade; k++)
+        {
+            CURSOR *o = c->operandos[k];
+            int j = k - 1;
+            while (j >= 0 && c->operandos[j]->estimativa > o->estimativa)
+            {
+                c->operandos[j + 1] = c->operandos[j];
+                j--;
+            }
+            c->operandos[j + 1] = o;
+        }
+    }
+
+    c->estimativa = c->operandos[0]->estimativa;
+    for (int k = 1; k < c->quantidade; k++)
+    {
+        long long estimativa = c->operandos[k]->estimativa;
+        if (e->operacao == EXPRESSAO_UNIAO)
+            c->estimativa += estimativa;
+        else if (e->operacao == EXPRESSAO_INTERSECAO && estimativa < c->estimativa)
+            c->estimativa = estimativa;
+    }
+    if (c->estimativa > INT_MAX)
+        c->estimativa = INT_MAX;
+    cursor_posicionar(c);
+    return c;
+}
+
+static void apagar_cursor(CURSOR *c)
+{
+    for (int k = 0; k < c->quantidade; k++)
+    {
+        apagar_cursor(c->operandos[k]);
+    }
+    free(c->operandos);
+    free(c->exportado);
+    free(c);
+}
+
+/*
+    Avaliar
+    Parâmetros: expressão, estrutura do resultado e se as intersecções devem ser reordenadas
+    Ideia: monta a árvore de cursores (um por nó, com as operações associativas achatadas) e a percorre uma única vez,
+    escrevendo a saída já ordenada e sem repetidos em um vetor do tamanho da estimativa (limite superior, então não há realocação),
+    que é entregue direto a criar_conjunto_de_ordenado. Nenhum conjunto intermediário é criado.
+    Um nó compartilhado no DAG ganha um cursor por uso
+*/
+Conjunto *expressao_avaliar(EXPRESSAO *expressao, int tipo, bool reordenar)
+{
+    if (!expressao)
+        return criar_conjunto(tipo, 0);
+
+    CURSOR *raiz = montar_cursor(expressao, reordenar);
+    int *saida = (int *)alocar(raiz->estimativa * sizeof(int));
+    int n = 0;
+    while (!raiz->fim)
+    {
+        saida[n++] = raiz->atual;
+        cursor_avancar(raiz);
+    }
+    apagar_cursor(raiz);
+
+    Conjunto *resultado = criar_conjunto_de_ordenado(tipo, saida, n);
+    free(saida);
+    return resultado;
+}
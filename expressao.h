@@ -0,0 +1,25 @@
+#ifndef EXPRESSAO_H
+#define EXPRESSAO_H
+#include <stdbool.h>
+#include "conjunto.h"
+
+typedef struct Expressao EXPRESSAO;
+
+// Folha: um conjunto já existente (não é copiado; deve existir, sem alterações, até a avaliação)
+EXPRESSAO *expressao_conjunto(Conjunto *conjunto);
+
+// Nós de operação: recebem a posse das expressões "a" e "b"
+EXPRESSAO *expressao_uniao(EXPRESSAO *a, EXPRESSAO *b);
+EXPRESSAO *expressao_intersecao(EXPRESSAO *a, EXPRESSAO *b);
+EXPRESSAO *expressao_diferenca(EXPRESSAO *a, EXPRESSAO *b);
+
+// Nova referência para a mesma expressão, para usá-la em mais de um lugar (DAG)
+EXPRESSAO *expressao_compartilhar(EXPRESSAO *expressao);
+
+// Libera uma referência; o nó (e o que só ele usava) é apagado quando não resta nenhuma
+void expressao_apagar(EXPRESSAO **expressao);
+
+// Avalia a expressão em uma só passada ordenada, criando o resultado com a estrutura "tipo"
+// reordenar: as intersecções são percorridas do operando com menor cardinalidade estimada para o maior
+Conjunto *expressao_avaliar(EXPRESSAO *expressao, int tipo, bool reordenar);
+#endif
@@ -0,0 +1,199 @@
+#include <stdbool.h>
+#include "intersecao_vetores.h"
+
+/*
+    Kernels de interseção de vetores ordenados
+    Todos recebem dois vetores ordenados e sem repetições e escrevem os elementos comuns direto em "saida"
+    (que precisa comportar o menor dos dois tamanhos). O kernel é escolhido uma única vez, em tempo de execução,
+    conforme as instruções que a CPU suporta (CPUID): AVX2, depois SSE2, e por fim a versão escalar
+*/
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#define INTERSECAO_X86
+#include <immintrin.h>
+#endif
+
+/*
+    Intercalação escalar
+    Ideia: percorre os dois vetores paralelamente, avançando o de menor elemento; quando são iguais, escreve o elemento
+    e avança ambos. Também termina as caudas que sobram dos kernels SIMD
+*/
+int intersecao_vetores_escalar(const int *a, int na, const int *b, int nb, int *saida)
+{
+    int i = 0, j = 0, k = 0;
+    while (i < na && j < nb)
+    {
+        if (a[i] == b[j])
+        {
+            saida[k++] = a[i];
+            i++;
+            j++;
+        }
+        else if (a[i] > b[j])
+        {
+            j++;
+        }
+        else
+        {
+            i++;
+        }
+    }
+    return k;
+}
+
+/*
+    Interseção por galope
+    Ideia: para cada elemento do vetor menor, procura-se no maior a partir da posição onde a busca anterior parou.
+    Os saltos dobram de tamanho (1, 2, 4, ...) até passar do elemento procurado, e então uma busca binária fecha o intervalo.
+    Custo: O(m log(n/m)), bem melhor que O(n + m) quando m é muito menor que n
+*/
+int intersecao_vetores_galope(const int *menor, int n_menor, const int *maior, int n_maior, int *saida)
+{
+    int k = 0, inicio = 0;
+    for (int i = 0; i < n_menor && inicio < n_maior; i++)
+    {
+        int x = menor[i];
+        // galope: acha um intervalo (inicio + salto/2, inicio + salto] que contém a primeira posição com valor >= x
+        int salto = 1;
+        while (inicio + salto - 1 < n_maior && maior[inicio + salto - 1] < x)
+        {
+            salto *= 2;
+        }
+        int inf = inicio + salto / 2;
+        int sup = inicio + salto - 1 < n_maior ? inicio + salto - 1 : n_maior;
+        // busca binária pela primeira posição com valor >= x
+        while (inf < sup)
+        {
+            int meio = inf + (sup - inf) / 2;
+            if (maior[meio] < x)
+            {
+                inf = meio + 1;
+            }
+            else
+            {
+                sup = meio;
+            }
+        }
+        inicio = inf;
+        if (inicio < n_maior && maior[inicio] == x)
+        {
+            saida[k++] = x;
+            inicio++;
+        }
+    }
+    return k;
+}
+
+#ifdef INTERSECAO_X86
+/*
+    Escrever correspondências, função auxiliar dos kernels SIMD
+    Ideia: cada bit ligado da máscara indica um elemento do bloco de "a" que apareceu no bloco de "b"
+*/
+static inline int escrever_mascara(const int *bloco, unsigned int mascara, int *saida)
+{
+    int k = 0;
+    while (mascara)
+    {
+        saida[k++] = bloco[__builtin_ctz(mascara)];
+        mascara &= mascara - 1;
+    }
+    return k;
+}
+
+/*
+    Kernel SSE2 (blocos de 4 x 4)
+    Ideia: carrega 4 elementos de cada vetor e compara o bloco de "a" com as 4 rotações do bloco de "b",
+    cobrindo os 16 pares com 4 comparações. O bloco cujo último elemento é menor (ou ambos, se iguais) é descartado,
+    pois nenhum de seus elementos pode aparecer mais adiante no outro vetor
+*/
+__attribute__((target("sse2"))) static int intersecao_sse2(const int *a, int na, const int *b, int nb, int *saida)
+{
+    int i = 0, j = 0, k = 0;
+    while (i + 4 <= na && j + 4 <= nb)
+    {
+        __m128i va = _mm_loadu_si128((const __m128i *)(a + i));
+        __m128i vb = _mm_loadu_si128((const __m128i *)(b + j));
+
+        __m128i iguais = _mm_cmpeq_epi32(va, vb);
+        iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(0, 3, 2, 1))));
+        iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(1, 0, 3, 2))));
+        iguais = _mm_or_si128(iguais, _mm_cmpeq_epi32(va, _mm_shuffle_epi32(vb, _MM_SHUFFLE(2, 1, 0, 3))));
+
+        k += escrever_mascara(a + i, (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(iguais)), saida + k);
+
+        int ultimo_a = a[i + 3], ultimo_b = b[j + 3];
+        i += (ultimo_a <= ultimo_b) ? 4 : 0;
+        j += (ultimo_b <= ultimo_a) ? 4 : 0;
+    }
+    return k + intersecao_vetores_escalar(a + i, na - i, b + j, nb - j, saida + k);
+}
+
+/*
+    Kernel AVX2 (blocos de 8 x 8)
+    Ideia: mesma do kernel SSE, com blocos de 8 elementos e as 8 rotações do bloco de "b" feitas por permutação entre as lanes
+*/
+__attribute__((target("avx2"))) static int intersecao_avx2(const int *a, int na, const int *b, int nb, int *saida)
+{
+    const __m256i rotacao = _mm256_setr_epi32(1, 2, 3, 4, 5, 6, 7, 0);
+    int i = 0, j = 0, k = 0;
+    while (i + 8 <= na && j + 8 <= nb)
+    {
+        __m256i va = _mm256_loadu_si256((const __m256i *)(a + i));
+        __m256i vb = _mm256_loadu_si256((const __m256i *)(b + j));
+
+        __m256i iguais = _mm256_cmpeq_epi32(va, vb);
+        for (int r = 1; r < 8; r++)
+        {
+            vb = _mm256_permutevar8x32_epi32(vb, rotacao);
+            iguais = _mm256_or_si256(iguais, _mm256_cmpeq_epi32(va, vb));
+        }
+
+        k += escrever_mascara(a + i, (unsigned int)_mm256_movemask_ps(_mm256_castsi256_ps(iguais)), saida + k);
+
+        int ultimo_a = a[i + 7], ultimo_b = b[j + 7];
+        i += (ultimo_a <= ultimo_b) ? 8 : 0;
+        j += (ultimo_b <= ultimo_a) ? 8 : 0;
+    }
+    return k + intersecao_vetores_escalar(a + i, na - i, b + j, nb - j, saida + k);
+}
+#endif
+
+/*
+    Seleção do kernel
+    Ideia: consulta a CPU apenas na primeira chamada e guarda o resultado
+*/
+int intersecao_kernel_ativo(void)
+{
+    static int kernel = -1;
+    if (kernel < 0)
+    {
+        kernel = KERNEL_ESCALAR;
+#ifdef INTERSECAO_X86
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2"))
+        {
+            kernel = KERNEL_AVX2;
+        }
+        else if (__builtin_cpu_supports("sse2"))
+        {
+            kernel = KERNEL_SSE2;
+        }
+#endif
+    }
+    return kernel;
+}
+
+int intersecao_vetores(const int *a, int na, const int *b, int nb, int *saida)
+{
+    switch (intersecao_kernel_ativo())
+    {
+#ifdef INTERSECAO_X86
+    case KERNEL_AVX2:
+        return intersecao_avx2(a, na, b, nb, saida);
+    case KERNEL_SSE2:
+        return intersecao_sse2(a, na, b, nb, saida);
+#endif
+    default:
+        return intersecao_vetores_escalar(a, na, b, nb, saida);
+    }
+}
@@ -0,0 +1,21 @@
+#ifndef INTERSECAO_VETORES_H
+#define INTERSECAO_VETORES_H
+
+// Kernels disponíveis para a interseção de vetores ordenados
+#define KERNEL_ESCALAR 0
+#define KERNEL_SSE2 1
+#define KERNEL_AVX2 2
+
+// Escreve em "saida" os elementos comuns a dois vetores ordenados e sem repetições, retornando quantos foram escritos
+int intersecao_vetores(const int *a, int na, const int *b, int nb, int *saida);
+
+// Versão escalar (intercalação simples), usada quando a CPU não tem SIMD
+int intersecao_vetores_escalar(const int *a, int na, const int *b, int nb, int *saida);
+
+// Interseção por galope (busca exponencial), para quando um vetor é muito menor que o outro
+int intersecao_vetores_galope(const int *menor, int n_menor, const int *maior, int n_maior, int *saida);
+
+// Retorna qual kernel intersecao_vetores utiliza nesta CPU
+int intersecao_kernel_ativo(void);
+
+#endif
@@ -0,0 +1,231 @@
+#define _POSIX_C_SOURCE 200809L // clock_gettime com -std=c99
+#include <stdio.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <time.h>
+#include "latencia.h"
+
+/*
+    Histogramas de latência
+    Ideia:
+        - Medir todas as operações custaria duas leituras de relógio por chamada; com amostragem, só uma operação sorteada
+          a cada ~N paga isso, e as demais só decrementam um contador da própria thread
+        - O intervalo até a próxima amostra é sorteado entre 1 e 2N - 1 (média N), para que uma carga periódica não
+          caia sempre na mesma fase
+        - Histograma log-linear: valores menores que 2^BITS_SUBFAIXA_LATENCIA têm uma faixa cada; os demais caem na
+          potência de 2 do seu bit mais alto, dividida em 2^BITS_SUBFAIXA_LATENCIA partes iguais. Assim o erro relativo
+          é o mesmo de 1 ns a minutos, com poucas centenas de contadores por histograma
+        - Há um histograma por operação e faixa de tamanho: inserir na lista custa muito diferente com 10^3 ou 10^7 elementos
+        - Os contadores são atualizados com operações atômicas, então várias threads podem registrar ao mesmo tempo
+*/
+
+#define SUBFAIXAS (1 << BITS_SUBFAIXA_LATENCIA)
+#define FAIXAS_HISTOGRAMA ((64 - BITS_SUBFAIXA_LATENCIA + 1) * SUBFAIXAS)
+
+typedef struct
+{
+    unsigned long long contagem[FAIXAS_HISTOGRAMA];
+    unsigned long long amostras;
+    unsigned long long soma;
+    unsigned long long maximo;
+} HISTOGRAMA;
+
+static HISTOGRAMA histogramas[QUANTIDADE_OPERACOES_LATENCIA][FAIXAS_TAMANHO_LATENCIA];
+static unsigned int intervalo_amostragem = 0;
+
+// Estado da amostragem de cada thread: operações até a próxima amostra e gerador (xorshift) do sorteio
+static __thread long restantes = 0;
+static __thread uint32_t estado_sorteio = 0;
+
+static const char *nomes_operacoes[QUANTIDADE_OPERACOES_LATENCIA] = {"inserir", "remover", "pertence", "uniao", "intersecao"};
+
+static unsigned long long agora_ns(void)
+{
+    struct timespec t;
+    clock_gettime(CLOCK_MONOTONIC, &t);
+    return (unsigned long long)t.tv_sec * 1000000000ULL + (unsigned long long)t.tv_nsec;
+}
+
+static uint32_t sortear(void)
+{
+    if (estado_sorteio == 0)
+    {
+        estado_sorteio = (uint32_t)(uintptr_t)&estado_sorteio | 1; // semente diferente em cada thread
+    }
+    estado_sorteio ^= estado_sorteio << 13;
+    estado_sorteio ^= estado_sorteio >> 17;
+    estado_sorteio ^= estado_sorteio << 5;
+    return estado_sorteio;
+}
+
+void latencia_amostragem(unsigned int intervalo)
+{
+    __atomic_store_n(&intervalo_amostragem, intervalo, __ATOMIC_RELAXED);
+}
+
+unsigned long long latencia_iniciar(void)
+{
+    unsigned int intervalo = __atomic_load_n(&intervalo_amostragem, __ATOMIC_RELAXED);
+    // uma contagem maior que o maior intervalo possível vem de uma amostragem anterior mais esparsa: recomeça já
+    if (intervalo == 0 || (--restantes > 0 && restantes < 2 * (long)intervalo))
+    {
+        return 0;
+    }
+    restantes = intervalo == 1 ? 1 : 1 + sortear() % (2 * (unsigned long)intervalo - 1);
+    return agora_ns();
+}
+
+/*
+    Faixa do histograma de um valor
+    Ideia: com e = posição do bit mais alto (e >= BITS_SUBFAIXA_LATENCIA), os BITS_SUBFAIXA_LATENCIA bits seguintes escolhem
+    a subdivisão; valor_faixa faz o caminho inverso e devolve o meio da faixa
+*/
+static int faixa_histograma(unsigned long long valor)
+{
+    if (valor < SUBFAIXAS)
+    {
+        return (int)valor;
+    }
+    int e = 63 - __builtin_clzll(valor);
+    int sub = (int)(valor >> (e - BITS_SUBFAIXA_LATENCIA)) & (SUBFAIXAS - 1);
+    return (e - BITS_SUBFAIXA_LATENCIA + 1) * SUBFAIXAS + sub;
+}
+
+static unsigned long long valor_faixa(int faixa)
+{
+    if (faixa < SUBFAIXAS)
+    {
+        return (unsigned long long)faixa;
+    }
+    int e = faixa / SUBFAIXAS + BITS_SUBFAIXA_LATENCIA - 1;
+    int sub = faixa % SUBFAIXAS;
+    unsigned long long largura = 1ULL << (e - BITS_SUBFAIXA_LATENCIA);
+    return (1ULL << e) + sub * largura + largura / 2;
+}
+
+static int faixa_tamanho(long tamanho)
+{
+    int faixa = 0;
+    while (tamanho >= 10 && faixa < FAIXAS_TAMANHO_LATENCIA - 1)
+    {
+        tamanho /= 10;
+        faixa++;
+    }
+    return faixa;
+}
+
+void latencia_registrar(int operacao, unsigned long long inicio, long tamanho)
+{
+    if (inicio == 0 || operacao < 0 || operacao >= QUANTIDADE_OPERACOES_LATENCIA)
+    {
+        return;
+    }
+    unsigned long long duracao = agora_ns() - inicio;
+    HISTOGRAMA *h = &histogramas[operacao][faixa_tamanho(tamanho)];
+    __atomic_fetch_add(&h->contagem[faixa_histograma(duracao)], 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->amostras, 1, __ATOMIC_RELAXED);
+    __atomic_fetch_add(&h->soma, duracao, __ATOMIC_RELAXED);
+    unsigned long long maximo = __atomic_load_n(&h->maximo, __ATOMIC_RELAXED);
+    while (duracao > maximo &&
+           !__atomic_compare_exchange_n(&h->maximo, &maximo, duracao, true, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+    {
+    }
+}
+
+/*
+    Resumo
+    Ideia: soma os histogramas das faixas pedidas e percorre as contagens acumuladas até passar de cada percentil
+    (o percentil p é a menor faixa que acumula pelo menos ceil(p * amostras) amostras)
+*/
+RESUMO_LATENCIA latencia_resumo(int operacao, int faixa)
+{
+    RESUMO_LATENCIA resumo;
+    memset(&resumo, 0, sizeof(RESUMO_LATENCIA));
+    if (operacao < 0 || operacao >= QUANTIDADE_OPERACOES_LATENCIA || faixa >= FAIXAS_TAMANHO_LATENCIA)
+    {
+        return resumo;
+    }
+    int primeira = faixa < 0 ? 0 : faixa;
+    int ultima = faixa < 0 ? FAIXAS_TAMANHO_LATENCIA - 1 : faixa;
+
+    static __thread unsigned long long contagem[FAIXAS_HISTOGRAMA];
+    memset(contagem, 0, sizeof(contagem));
+    unsigned long long soma = 0;
+    for (int f = primeira; f <= ultima; f++)
+    {
+        HISTOGRAMA *h = &histogramas[operacao][f];
+        resumo.amostras += __atomic_load_n(&h->amostras, __ATOMIC_RELAXED);
+        soma += __atomic_load_n(&h->soma, __ATOMIC_RELAXED);
+        unsigned long long maximo = __atomic_load_n(&h->maximo, __ATOMIC_RELAXED);
+        resumo.maximo = maximo > resumo.maximo ? maximo : resumo.maximo;
+        for (int i = 0; i < FAIXAS_HISTOGRAMA; i++)
+        {
+            contagem[i] += __atomic_load_n(&h->contagem[i], __ATOMIC_RELAXED);
+        }
+    }
+    if (resumo.amostras == 0)
+    {
+        return resumo;
+    }
+    resumo.media = soma / resumo.amostras;
+
+    // alvos em milésimos: 500, 990 e 999 de cada 1000 amostras, arredondados para cima
+    unsigned long long alvos[3] = {(resumo.amostras * 500 + 999) / 1000, (resumo.amostras * 990 + 999) / 1000,
+                                   (resumo.amostras * 999 + 999) / 1000};
+    unsigned long long *saidas[3] = {&resumo.p50, &resumo.p99, &resumo.p999};
+    unsigned long long acumulado = 0;
+    int proximo = 0;
+    for (int i = 0; i < FAIXAS_HISTOGRAMA && proximo < 3; i++)
+    {
+        acumulado += contagem[i];
+        while (proximo < 3 && acumulado >= alvos[proximo])
+        {
+            unsigned long long valor = valor_faixa(i);
+            *saidas[proximo++] = valor < resumo.maximo ? valor : resumo.maximo;
+        }
+    }
+    return resumo;
+}
+
+void latencia_imprimir(FILE *arquivo)
+{
+    fprintf(arquivo, "%-10s %-8s %12s %12s %12s %12s %12s %12s\n", "operacao", "tamanho", "amostras", "media_ns", "p50_ns",
+            "p99_ns", "p999_ns", "max_ns");
+    for (int operacao = 0; operacao < QUANTIDADE_OPERACOES_LATENCIA; operacao++)
+    {
+        for (int faixa = -1; faixa < FAIXAS_TAMANHO_LATENCIA; faixa++)
+        {
+            RESUMO_LATENCIA r = latencia_resumo(operacao, faixa);
+            if (r.amostras == 0)
+            {
+                continue;
+            }
+            char tamanho[16];
+            if (faixa < 0)
+                snprintf(tamanho, sizeof(tamanho), "todos");
+            else
+                snprintf(tamanho, sizeof(tamanho), "<1e%d", faixa + 1);
+            fprintf(arquivo, "%-10s %-8s %12llu %12llu %12llu %12llu %12llu %12llu\n", nomes_operacoes[operacao], tamanho,
+                    r.amostras, r.media, r.p50, r.p99, r.p999, r.maximo);
+        }
+    }
+}
+
+void latencia_zerar(void)
+{
+    for (int operacao = 0; operacao < QUANTIDADE_OPERACOES_LATENCIA; operacao++)
+    {
+        for (int faixa = 0; faixa < FAIXAS_TAMANHO_LATENCIA; faixa++)
+        {
+            HISTOGRAMA *h = &histogramas[operacao][faixa];
+            for (int i = 0; i < FAIXAS_HISTOGRAMA; i++)
+            {
+                __atomic_store_n(&h->contagem[i], 0, __ATOMIC_RELAXED);
+            }
+            __atomic_store_n(&h->amostras, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&h->soma, 0, __ATOMIC_RELAXED);
+            __atomic_store_n(&h->maximo, 0, __ATOMIC_RELAXED);
+        }
+    }
+}
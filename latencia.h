@@ -0,0 +1,50 @@
+#ifndef LATENCIA_H
+#define LATENCIA_H
+#include <stdio.h>
+
+// Operações medidas
+#define LATENCIA_INSERIR 0
+#define LATENCIA_REMOVER 1
+#define LATENCIA_PERTENCE 2
+#define LATENCIA_UNIAO 3
+#define LATENCIA_INTERSECAO 4
+#define QUANTIDADE_OPERACOES_LATENCIA 5
+
+// Faixas de tamanho do conjunto, por potência de 10 (faixa f: tamanhos de 10^f a 10^(f+1) - 1; a última inclui os maiores)
+#define FAIXAS_TAMANHO_LATENCIA 10
+
+// Subdivisões de cada potência de 2 do histograma (2^BITS_SUBFAIXA_LATENCIA): erro relativo de no máximo 1/32 nos percentis
+#define BITS_SUBFAIXA_LATENCIA 4
+
+/*
+Resumo de latência: quantidade de amostras e, em nanossegundos, média, percentis 50, 99 e 99,9 e o máximo
+Os percentis são o meio da faixa do histograma em que caem; o máximo é exato
+*/
+typedef struct ResumoLatencia
+{
+    unsigned long long amostras;
+    unsigned long long media;
+    unsigned long long p50;
+    unsigned long long p99;
+    unsigned long long p999;
+    unsigned long long maximo;
+} RESUMO_LATENCIA;
+
+// Define a amostragem: 0 desliga (padrão), 1 mede todas as operações, N mede em média uma a cada N
+void latencia_amostragem(unsigned int intervalo);
+
+// Início de uma operação: o instante (ns) se ela foi sorteada para ser medida, ou 0
+unsigned long long latencia_iniciar(void);
+
+// Fim de uma operação iniciada com latencia_iniciar, sobre um conjunto de "tamanho" elementos (nada é feito se inicio for 0)
+void latencia_registrar(int operacao, unsigned long long inicio, long tamanho);
+
+// Resumo de uma operação em uma faixa de tamanho (faixa < 0: todas as faixas juntas)
+RESUMO_LATENCIA latencia_resumo(int operacao, int faixa);
+
+// Escreve uma tabela com o resumo de cada operação e faixa que tem amostras
+void latencia_imprimir(FILE *arquivo);
+
+// Descarta todas as amostras
+void latencia_zerar(void);
+#endif
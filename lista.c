@@ -1,11 +1,20 @@
+#define _POSIX_C_SOURCE 200809L // posix_memalign
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <string.h>
+#include <pthread.h>
+#include <sys/mman.h>
 #include "lista.h"
+#include "intersecao_vetores.h"
+#include "ordenacao.h"
+#include "estatisticas.h"
 
 /*
 Struct Lista: equivale a uma Lista Linear Sequencial Ordenada e Dinamicamente Alocada
 Possui um indicador para início, fim , o tamanho atual da lista e o tamanho máximo que ela suporta, além da própria lista em formato de vetor
+O tamanho máximo é apenas a capacidade atual do vetor: quando a lista enche, ela cresce multiplicando a capacidade pelo fator de crescimento
+Opcionalmente, a lista mantém uma cópia dos elementos no layout de Eytzinger (ver lista_otimizar_busca), usada só pelo pertencimento
 */
 struct lista_
 {
@@ -14,42 +23,395 @@ struct lista_
     int fim;
     int tamanho_atual;
     int tamanho_maximo;
+    float fator_crescimento;
+    int *eytzinger;        // cópia em ordem de busca em largura (posições 1..tamanho_atual), NULL se ainda não montada
+    bool eytzinger_ativo;  // layout habilitado por lista_otimizar_busca
+    bool eytzinger_valido; // cópia em dia com "lista"; toda alteração a invalida e ela é remontada na próxima busca
+    void *mapa;            // arquivo mapeado (mmap) onde "lista" está, ou NULL se o vetor veio de malloc
+    size_t tamanho_mapa;
+    uint64_t *lapides;       // remoção preguiçosa: bit i ligado -> a posição i foi removida (NULL enquanto não há lápides)
+    bool remocao_preguicosa; // remover só marca a posição (ver lista_remocao_preguicosa)
+    float limite_lapides;    // fração de lápides em [0, fim) a partir da qual a remoção compacta a lista
 };
+/*
+    Com lápides, "fim" conta as posições ocupadas do vetor (vivas e removidas) e "tamanho_atual" só as vivas.
+    As posições removidas guardam o valor antigo, então o vetor [0, fim) continua em ordem e as buscas binárias valem sem mudança
+*/
 typedef struct lista_ LISTA;
 //////CRIAÇÃO /////////
 /*
 Criação da lista
-Parâmetro: Recebe o parâmetro "n", tamanho máximo da lista
+Parâmetro: Recebe o parâmetro "n", capacidade inicial da lista (a lista cresce depois, se necessário)
 Ideia: Tenta alocar espaço para a struct lista e para a própria lista dentro da struct, se conseguir, define os parâmetros iniciais
 */
 LISTA *lista_criar(int n)
 {
     /*Pré-condição: existir espaço na memória*/
     LISTA *lista = (LISTA *)malloc(sizeof(LISTA));
-    // Aloca dinamicamente o espaço necessário para a lista (equivale ao tamanho do conjunto, que é dado)
+    if (lista == NULL)
+    {
+        return NULL;
+    }
+    // Aloca dinamicamente o espaço necessário para a lista (equivale ao tamanho do conjunto, que é dado), com pelo menos 1 posição
+    if (n < 1)
+    {
+        n = 1;
+    }
     lista->lista = (int *)malloc(n * sizeof(int));
 
+    if (lista->lista == NULL)
+    {
+        free(lista);
+        return NULL;
+    }
+    lista->inicio = 0;
+    lista->fim = lista->inicio; /// lista vazia
+    lista->tamanho_atual = 0;
+    lista->tamanho_maximo = n;
+    lista->fator_crescimento = FATOR_CRESCIMENTO;
+    lista->eytzinger = NULL;
+    lista->eytzinger_ativo = false;
+    lista->eytzinger_valido = false;
+    lista->mapa = NULL;
+    lista->tamanho_mapa = 0;
+    lista->lapides = NULL;
+    lista->remocao_preguicosa = false;
+    lista->limite_lapides = LIMITE_LAPIDES;
+    return lista;
+}
+
+/*
+Criação da lista a partir de um vetor
+Parâmetros: vetor ordenado e sem repetições e seu tamanho
+Ideia: o vetor já está no formato da lista, então basta copiá-lo de uma vez (O(n)), sem busca binária nem deslocamentos
+*/
+LISTA *lista_criar_de_vetor(const int *vetor, int n)
+{
+    LISTA *lista = lista_criar(n);
     if (lista != NULL && lista->lista != NULL)
     {
-        lista->inicio = 0;
-        lista->fim = lista->inicio; /// lista vazia
-        lista->tamanho_atual = 0;
-        lista->tamanho_maximo = n;
+        memcpy(lista->lista, vetor, n * sizeof(int));
+        lista->fim = n;
+        lista->tamanho_atual = n;
     }
     return lista;
 }
 
+/*
+Criação da lista sobre um arquivo mapeado
+Parâmetros: o mapeamento (mmap com PROT_READ | PROT_WRITE e MAP_PRIVATE), seu tamanho e o vetor ordenado de n elementos dentro dele
+Ideia: a lista usa o vetor mapeado diretamente, sem cópia, e passa a ser dona do mapeamento. Como ele é privado, as alterações
+no lugar (inserções que cabem, remoções) não chegam ao arquivo; quando precisar crescer, o vetor é copiado para a memória comum.
+Se a lista não puder ser criada, o mapeamento é desfeito do mesmo jeito
+*/
+LISTA *lista_criar_de_mapa(void *mapa, size_t tamanho_mapa, int *vetor, int n)
+{
+    LISTA *lista = (LISTA *)malloc(sizeof(LISTA));
+    if (lista == NULL)
+    {
+        munmap(mapa, tamanho_mapa);
+        return NULL;
+    }
+    lista->lista = vetor;
+    lista->inicio = 0;
+    lista->fim = n;
+    lista->tamanho_atual = n;
+    lista->tamanho_maximo = n;
+    lista->fator_crescimento = FATOR_CRESCIMENTO;
+    lista->eytzinger = NULL;
+    lista->eytzinger_ativo = false;
+    lista->eytzinger_valido = false;
+    lista->mapa = mapa;
+    lista->tamanho_mapa = tamanho_mapa;
+    lista->lapides = NULL;
+    lista->remocao_preguicosa = false;
+    lista->limite_lapides = LIMITE_LAPIDES;
+    return lista;
+}
+
+////// CAPACIDADE //////
+/*
+    Trocar o vetor de tamanho, função auxiliar de Reservar e Realocar
+    Parâmetros: lista e nova capacidade (>= tamanho atual)
+    Ideia: realloc no caso comum; se o vetor está em um arquivo mapeado, copia-o para um vetor novo e desfaz o mapeamento
+*/
+static bool lista_trocar_vetor(LISTA *l, int capacidade)
+{
+    CONTAR(realocacoes, 1);
+    if (l->mapa == NULL)
+    {
+        int *nova_lista = (int *)realloc(l->lista, capacidade * sizeof(int));
+        if (nova_lista == NULL)
+        {
+            return false;
+        }
+        l->lista = nova_lista;
+        return true;
+    }
+    int *nova_lista = (int *)malloc(capacidade * sizeof(int));
+    if (nova_lista == NULL)
+    {
+        return false;
+    }
+    memcpy(nova_lista, l->lista, l->fim * sizeof(int));
+    munmap(l->mapa, l->tamanho_mapa);
+    l->mapa = NULL;
+    l->tamanho_mapa = 0;
+    l->lista = nova_lista;
+    return true;
+}
+
+/*
+    Reservar
+    Parâmetros: lista e capacidade desejada
+    Ideia: garante que o vetor comporte pelo menos "capacidade" elementos, realocando-o uma única vez se necessário.
+    Útil quando se sabe de antemão quantos elementos serão inseridos. Nunca diminui a capacidade
+*/
+bool lista_reservar(LISTA *l, int capacidade)
+{
+    if (l == NULL)
+    {
+        return false;
+    }
+    if (capacidade <= l->tamanho_maximo)
+    {
+        return true;
+    }
+    if (!lista_trocar_vetor(l, capacidade))
+    {
+        return false;
+    }
+    l->tamanho_maximo = capacidade;
+    return true;
+}
+
+/*
+    Crescer, função auxiliar da Inserção
+    Parâmetro: lista cheia
+    Ideia: multiplica a capacidade pelo fator de crescimento (crescimento geométrico), o que deixa o custo
+    das realocações amortizado em O(1) por inserção. Cresce pelo menos uma posição
+*/
+static bool lista_crescer(LISTA *l)
+{
+    int nova_capacidade = (int)(l->tamanho_maximo * l->fator_crescimento);
+    if (nova_capacidade <= l->tamanho_maximo)
+    {
+        nova_capacidade = l->tamanho_maximo + 1;
+    }
+    return lista_reservar(l, nova_capacidade);
+}
+
+/*
+    Definir fator de crescimento
+    Parâmetros: lista e o novo fator
+    Ideia: fatores maiores fazem menos realocações, mas desperdiçam mais memória. O fator precisa ser maior que 1
+*/
+bool lista_definir_fator_crescimento(LISTA *l, float fator)
+{
+    if (l == NULL || !(fator > 1.0f))
+    {
+        return false;
+    }
+    l->fator_crescimento = fator;
+    return true;
+}
+
+////// LÁPIDES //////
+/*
+    Lápide
+    Parâmetros: lista e posição em [0, fim)
+    Ideia: consulta o bit da posição no mapa de lápides; sem mapa, nenhuma posição foi removida
+*/
+static inline bool lista_e_lapide(const LISTA *l, int i)
+{
+    return l->lapides != NULL && ((l->lapides[i >> 6] >> (i & 63)) & 1);
+}
+
+/*
+    Próxima posição viva, função auxiliar dos percursos
+    Parâmetros: lista e posição inicial
+    Ideia: pula as lápides a partir de "i", uma palavra de 64 posições por vez quando a palavra toda foi removida. Retorna fim se não houver
+*/
+static int lista_proxima_viva(const LISTA *l, int i)
+{
+    if (l->lapides == NULL)
+    {
+        return i;
+    }
+    while (i < l->fim && lista_e_lapide(l, i))
+    {
+        i = (i & 63) == 0 && l->lapides[i >> 6] == UINT64_MAX ? i + 64 : i + 1;
+    }
+    return i < l->fim ? i : l->fim;
+}
+
+/*
+    Compactar
+    Parâmetro: lista
+    Ideia: uma única passada copia para a frente as posições vivas, como na remoção em lote, e descarta o mapa de lápides.
+    Custo O(fim), pago uma vez por muitas remoções. Roda sozinha quando a fração de lápides passa do limite (ver lista_remover),
+    antes de operações que precisam do vetor contíguo (inserção com deslocamento, inserção em lote, layout de Eytzinger,
+    lista_realocar) e ao desativar a remoção preguiçosa
+*/
+bool lista_compactar(LISTA *l)
+{
+    if (l == NULL)
+    {
+        return false;
+    }
+    if (l->lapides == NULL)
+    {
+        return true;
+    }
+    int destino = 0;
+    for (int i = 0; i < l->fim; i++)
+    {
+        if (!lista_e_lapide(l, i))
+        {
+            l->lista[destino++] = l->lista[i];
+        }
+    }
+    CONTAR(deslocamentos, destino);
+    l->fim = destino;
+    free(l->lapides);
+    l->lapides = NULL;
+    return true;
+}
+
+/*
+    Marcar lápide, função auxiliar da Remoção
+    Parâmetros: lista e posição viva a ser removida
+    Ideia: liga o bit da posição em vez de deslocar os elementos à direita. O mapa é alocado na primeira lápide com uma posição por
+    elemento ocupado; enquanto há lápides, "fim" não cresce (a inserção ocupa lápides ou compacta antes), então o mapa nunca precisa crescer.
+    Se a fração de lápides passa do limite, compacta. Retorna false só se faltar memória para o mapa
+*/
+static bool lista_marcar_lapide(LISTA *l, int posicao)
+{
+    if (l->lapides == NULL)
+    {
+        l->lapides = (uint64_t *)calloc((l->fim + 63) / 64, sizeof(uint64_t));
+        if (l->lapides == NULL)
+        {
+            return false;
+        }
+    }
+    l->lapides[posicao >> 6] |= 1ULL << (posicao & 63);
+    l->tamanho_atual--;
+    l->eytzinger_valido = false;
+    if (l->fim - l->tamanho_atual > l->limite_lapides * l->fim)
+    {
+        lista_compactar(l);
+    }
+    return true;
+}
+
+/*
+    Remoção preguiçosa
+    Parâmetros: lista e se deve ser ativada
+    Ideia: com ela ativa, lista_remover marca a posição como lápide em vez de deslocar a cauda do vetor, e a compactação é feita
+    de uma vez quando as lápides passam do limite. Vale para cargas com rajadas de remoções; desativar compacta a lista
+*/
+bool lista_remocao_preguicosa(LISTA *l, bool ativar)
+{
+    if (l == NULL)
+    {
+        return false;
+    }
+    l->remocao_preguicosa = ativar;
+    if (!ativar)
+    {
+        lista_compactar(l);
+    }
+    return true;
+}
+
+/*
+    Definir limite de lápides
+    Parâmetros: lista e a nova fração, entre 0 e 1
+    Ideia: limites maiores adiam a compactação (menos passadas, mais posições mortas nas buscas e percursos); com 0, cada remoção compacta
+*/
+bool lista_definir_limite_lapides(LISTA *l, float limite)
+{
+    if (l == NULL || !(limite >= 0.0f && limite <= 1.0f))
+    {
+        return false;
+    }
+    l->limite_lapides = limite;
+    return true;
+}
+
+/*
+    Quantidade de lápides
+    Parâmetro: lista
+    Ideia: posições removidas que ainda ocupam o vetor (esperando a compactação)
+*/
+int lista_lapides(LISTA *l)
+{
+    if (l != NULL)
+    {
+        return l->fim - l->tamanho_atual;
+    }
+    return ERRO;
+}
+
+/*
+    Ocupar lápide, função auxiliar da Inserção
+    Parâmetros: lista com lápides e o elemento a ser inserido
+    Ideia: se o próprio elemento está em uma lápide, basta desmarcá-la. Se a posição logo antes ou logo depois de onde ele entraria
+    é uma lápide, o elemento é escrito nela: o vizinho vivo de cada lado continua menor (ou maior) que ele, então a ordem se mantém
+    e não há deslocamento. Retorna 1 se inseriu, 0 se o elemento já está vivo na lista, ou ERRO se não há lápide vizinha
+*/
+static int lista_ocupar_lapide(LISTA *l, int x, int posicao)
+{
+    int i = -1;
+    if (posicao < l->fim && l->lista[posicao] == x)
+    {
+        if (!lista_e_lapide(l, posicao))
+        {
+            return 0;
+        }
+        i = posicao;
+    }
+    else if (posicao > 0 && lista_e_lapide(l, posicao - 1))
+    {
+        i = posicao - 1;
+    }
+    else if (posicao < l->fim && lista_e_lapide(l, posicao))
+    {
+        i = posicao;
+    }
+    if (i < 0)
+    {
+        return ERRO;
+    }
+    l->lista[i] = x;
+    l->lapides[i >> 6] &= ~(1ULL << (i & 63));
+    l->tamanho_atual++;
+    l->eytzinger_valido = false;
+    if (l->tamanho_atual == l->fim)
+    {
+        free(l->lapides); // a última lápide foi ocupada
+        l->lapides = NULL;
+    }
+    return 1;
+}
+
 ///// INSERÇÃO ////////
 /*
     Inserção em posição específica, função auxiliar da Inserção
     Parâmetros: lista, posição a ser inserido e o item a ser inserido
-    Ideia: dada a posição, realiza shift right dos elementos maiores que o elemento na posição "pos"
+    Ideia: se a lista estiver cheia, cresce antes de inserir. Dada a posição, realiza shift right dos elementos maiores que o elemento na posição "pos"
 */
 bool lista_inserir_posicao(LISTA *l, int pos, int item)
 {
-    // verifica se existe espaço e se a posição está na lista
-    if ((pos != ERRO && !lista_cheia(l)) && (pos <= l->fim))
+    if (lista_cheia(l) && !lista_crescer(l))
+    {
+        return false;
+    }
+    // verifica se a posição está na lista
+    if (pos != ERRO && pos <= l->fim)
     {
+        CONTAR(deslocamentos, l->fim - pos);
         // percorre a lista começando do fim até a posição
         for (int i = (l->fim - 1); i >= pos; i--)
         {
@@ -60,16 +422,37 @@ bool lista_inserir_posicao(LISTA *l, int pos, int item)
         l->lista[pos] = item;
         l->fim++;
         l->tamanho_atual++;
+        l->eytzinger_valido = false;
         return true;
     }
     // se as condições não forem corretas, não insere na lista
     return false;
 }
+/*
+    Limite inferior sem desvios, função auxiliar das buscas
+    Parâmetros: vetor ordenado, seu tamanho e o elemento procurado
+    Ideia: em vez de comparar e escolher uma metade com "if" (um desvio que o processador erra metade das vezes),
+    o início da janela avança ou não conforme o resultado da comparação, o que o compilador transforma em movimentação condicional.
+    O laço roda sempre log n vezes. Retorna a primeira posição com elemento >= x (ou n)
+*/
+static int limite_inferior(const int *v, int n, int x)
+{
+    const int *base = v;
+    while (n > 1)
+    {
+        int metade = n / 2;
+        CONTAR(comparacoes, 1);
+        base = (base[metade - 1] < x) ? base + metade : base;
+        n -= metade;
+    }
+    return (int)(base - v) + (n == 1 && *base < x);
+}
+
 /*
     Busca Binária de posição para inserção, função auxiliar para Inserção
     Parâmetros:  lista e elemento a ser inserido
-    Ideia: por meio de uma busca binária adaptada, divide sucessivamente o vetor ao meio,
-    procurando a posição ou na metade inferior ou superior, e retorna uma posição atrás do elemento exatamente maior que o elemento a ser inserido
+    Ideia: a busca binária sem desvios acha a primeira posição com elemento maior ou igual ao inserido;
+    se o elemento dessa posição é o próprio, ele já existe e não deve ser inserido
 */
 int lista_busca_binaria_insercao(LISTA *l, int elemento_inserido)
 {
@@ -77,38 +460,32 @@ int lista_busca_binaria_insercao(LISTA *l, int elemento_inserido)
     {
         return ERRO;
     }
-    int inf = 0;
-    int sup = l->fim - 1;
-    int meio, valor;
-
-    while (inf <= sup)
+    int posicao = limite_inferior(l->lista, l->fim, elemento_inserido);
+    if (posicao < l->fim && l->lista[posicao] == elemento_inserido)
     {
-        meio = (inf + sup) / 2;
-        valor = l->lista[meio];
-        if (valor == elemento_inserido)
-        {
-            return ERRO; /// note que aqui o elemento já existe, por o conjunto tratar elementos únicos, não deve ser inserido
-        }
-        else if (valor > elemento_inserido)
-        {
-            sup = meio - 1;
-        }
-        else
-        {
-            inf = meio + 1;
-        }
+        return ERRO; /// note que aqui o elemento já existe, por o conjunto tratar elementos únicos, não deve ser inserido
     }
     // retorna indice de onde o elemento deve ser inserido
-    return inf;
+    return posicao;
 }
 
 /*
 Inserir na Lista
 Parâmetros: Recebe a lista e o elemento a ser inserido
-Ideia: acha a posicao do elemento a ser inserido e insere naquela posição específica
+Ideia: acha a posicao do elemento a ser inserido e insere naquela posição específica.
+Com lápides, o elemento entra numa posição removida vizinha, se houver; senão, a lista é compactada antes do deslocamento
 */
 bool lista_inserir(LISTA *l, int elemento_procurado)
 {
+    if (l != NULL && l->lapides != NULL)
+    {
+        int ocupou = lista_ocupar_lapide(l, elemento_procurado, limite_inferior(l->lista, l->fim, elemento_procurado));
+        if (ocupou != ERRO)
+        {
+            return ocupou == 1;
+        }
+        lista_compactar(l);
+    }
     // Acha a posição do elemento a ser inserido
     int posicao = lista_busca_binaria_insercao(l, elemento_procurado);
     // se o elemento já existe no conjunto, não pode ser inserido 2 vezes
@@ -119,48 +496,193 @@ bool lista_inserir(LISTA *l, int elemento_procurado)
     return (lista_inserir_posicao(l, posicao, elemento_procurado));
 }
 
-////// BUSCA E PERTENCIMENTO ////
 /*
-    Busca
-    Parâmetros: lista e elemento a ser procurado (x)
-    Ideia: divide o vetor ao meio sucessivamente e procura o elemento ou na metade superior ou inferior
+Inserir em lote
+Parâmetros: lista, vetor ordenado e sem repetições com os elementos a serem inseridos, e seu tamanho k
+Ideia: em vez de k buscas binárias e k deslocamentos, faz uma intercalação (merge) de trás para frente dentro do próprio vetor.
+Uma primeira passada paralela conta quantos elementos do lote ainda não estão na lista, o que dá a posição final do último elemento;
+a segunda passada vai colocando o maior elemento restante no fim, sem sobrescrever nada que ainda não foi lido.
+Custo: O(n + k). Retorna quantos elementos foram inseridos (ERRO se não houver memória)
 */
-int lista_busca_binaria(LISTA *l, int x)
+int lista_inserir_lote(LISTA *l, const int *ordenado, int k)
 {
-    if (l == NULL || lista_vazia(l))
+    if (l == NULL)
     {
         return ERRO;
     }
-
-    int inf = 0;
-    int sup = l->fim - 1;
-    int meio, valor;
-    while (inf <= sup)
+    lista_compactar(l);
+    // conta os elementos novos
+    int novos = 0;
+    int i = 0, j = 0;
+    while (j < k)
     {
-        meio = (inf + sup) / 2;
-        valor = l->lista[meio];
-
-        if (valor == x)
+        if (i < l->fim && l->lista[i] < ordenado[j])
         {
-            return meio;
+            i++;
         }
-        else if (valor > x)
+        else
         {
-            sup = meio - 1;
+            if (i >= l->fim || l->lista[i] != ordenado[j])
+            {
+                novos++;
+            }
+            j++;
+        }
+    }
+    if (novos == 0)
+    {
+        return 0;
+    }
+    if (l->tamanho_atual + novos > l->tamanho_maximo && !lista_reservar(l, l->tamanho_atual + novos))
+    {
+        return ERRO;
+    }
+
+    // intercala de trás para frente
+    i = l->fim - 1;
+    j = k - 1;
+    int destino = l->fim + novos - 1;
+    while (j >= 0)
+    {
+        if (i >= 0 && l->lista[i] > ordenado[j])
+        {
+            l->lista[destino--] = l->lista[i--];
         }
         else
         {
-            inf = meio + 1;
+            if (i >= 0 && l->lista[i] == ordenado[j])
+            {
+                i--; // elemento repetido: mantém apenas a cópia da lista
+            }
+            l->lista[destino--] = ordenado[j--];
         }
     }
+    l->fim += novos;
+    l->tamanho_atual += novos;
+    l->eytzinger_valido = false;
+    return novos;
+}
+
+////// BUSCA E PERTENCIMENTO ////
+/*
+    Busca
+    Parâmetros: lista e elemento a ser procurado (x)
+    Ideia: divide o vetor ao meio sucessivamente (sem desvios, ver limite_inferior) e confere se a posição final é o elemento
+*/
+int lista_busca_binaria(LISTA *l, int x)
+{
+    if (l == NULL || lista_vazia(l))
+    {
+        return ERRO;
+    }
+    int posicao = limite_inferior(l->lista, l->fim, x);
+    if (posicao < l->fim && l->lista[posicao] == x && !lista_e_lapide(l, posicao))
+    {
+        return posicao;
+    }
     return ERRO;
 }
+
+/*
+    Montagem do layout de Eytzinger, função auxiliar do Pertencimento
+    Parâmetros: lista, próxima posição a ler do vetor ordenado e posição k da cópia
+    Ideia: a cópia guarda a árvore binária de busca implícita em ordem de busca em largura: a raiz fica em 1 e os filhos de k em 2k e 2k+1.
+    Um percurso em ordem da árvore implícita visita as posições na ordem crescente dos elementos, então basta ir lendo o vetor ordenado.
+    A recursão tem profundidade log n
+*/
+static int lista_montar_eytzinger(LISTA *l, int i, int k)
+{
+    if (k <= l->tamanho_atual)
+    {
+        i = lista_montar_eytzinger(l, i, 2 * k);
+        l->eytzinger[k] = l->lista[i++];
+        i = lista_montar_eytzinger(l, i, 2 * k + 1);
+    }
+    return i;
+}
+
+/*
+    Atualização do layout de Eytzinger
+    Ideia: remonta a cópia só quando alguma alteração a invalidou (remontagem preguiçosa, O(n)): uma lista que parou de mudar paga isso uma vez.
+    O vetor é alinhado a 64 bytes para que os 16 elementos de um mesmo nível de prefetch fiquem em uma só linha de cache
+*/
+static bool lista_atualizar_eytzinger(LISTA *l)
+{
+    if (l->eytzinger_valido)
+    {
+        return true;
+    }
+    lista_compactar(l); // a cópia é montada lendo o vetor em sequência, sem lápides
+    free(l->eytzinger);
+    size_t bytes = ((size_t)(l->tamanho_atual + 1) * sizeof(int) + 63) / 64 * 64;
+    void *copia = NULL;
+    if (posix_memalign(&copia, 64, bytes) != 0)
+    {
+        l->eytzinger = NULL;
+        return false;
+    }
+    l->eytzinger = (int *)copia;
+    lista_montar_eytzinger(l, 0, 1);
+    l->eytzinger_valido = true;
+    return true;
+}
+
+/*
+    Otimizar busca
+    Parâmetros: lista e se o layout de leitura deve ser usado
+    Ideia: com o layout ativo, o pertencimento desce pela cópia em ordem de Eytzinger em vez da busca binária no vetor ordenado.
+    Os primeiros níveis da árvore implícita ficam juntos no começo do vetor (sempre na cache) e os 16 descendentes de um nó 4 níveis abaixo
+    são vizinhos, então um prefetch por passo esconde a latência da memória. Vale para listas grandes que mudam pouco; desativar libera a cópia
+*/
+bool lista_otimizar_busca(LISTA *l, bool ativar)
+{
+    if (l == NULL)
+    {
+        return false;
+    }
+    l->eytzinger_ativo = ativar;
+    if (!ativar)
+    {
+        free(l->eytzinger);
+        l->eytzinger = NULL;
+        l->eytzinger_valido = false;
+    }
+    return true;
+}
+
+/*
+    Pertencimento pelo layout de Eytzinger
+    Ideia: a descida é k = 2k + (elemento em k < x), sem desvios, buscando antecipadamente a linha dos netos de 4 níveis abaixo.
+    Ao final, k saiu da árvore; os bits 1 finais de k são as vezes em que se desceu à direita depois da última descida à esquerda,
+    e retirá-los (mais o último 0) leva ao menor elemento >= x, que é comparado com x
+*/
+static bool lista_pertence_eytzinger(LISTA *l, int x)
+{
+    const int *b = l->eytzinger;
+    int n = l->tamanho_atual;
+    unsigned int k = 1;
+    while (k <= (unsigned int)n)
+    {
+        __builtin_prefetch(b + 16 * k);
+        CONTAR(comparacoes, 1);
+        k = 2 * k + (b[k] < x);
+    }
+    k >>= __builtin_ffs((int)~k);
+    return k != 0 && b[k] == x;
+}
+
 /*
     Pertencimento ao conjunto: retorna true caso pertence, caso contrário false
     Parâmetros: lista e elemento a ser procurado
+    Ideia: com o layout de leitura ativo (e memória para a cópia), usa a descida de Eytzinger; senão, a busca binária.
+    Enquanto há lápides, fica na busca binária: remontar a cópia compactaria a lista a cada remoção preguiçosa
 */
 bool lista_pertence(LISTA *l, int chave)
 {
+    if (l != NULL && l->eytzinger_ativo && l->lapides == NULL && lista_atualizar_eytzinger(l))
+    {
+        return lista_pertence_eytzinger(l, chave);
+    }
     if (lista_busca_binaria(l, chave) != ERRO)
     {
         return true;
@@ -168,6 +690,55 @@ bool lista_pertence(LISTA *l, int chave)
     return false;
 }
 
+/*
+    Pertencimento em lote
+    Parâmetros: lista, vetor de k chaves (em qualquer ordem, podendo repetir) e vetor de saída com k posições
+    Ideia: k buscas binárias independentes pagam, cada uma, log n acessos espalhados pela memória.
+    Aqui as chaves são ordenadas (pelos índices, com radix sort) e procuradas em ordem crescente, cada uma por galope
+    a partir de onde a anterior parou: a varredura anda só para a frente no vetor, o custo é O(k log(n/k)) e os acessos
+    próximos reaproveitam a cache. saida[i] diz se chaves[i] pertence à lista. Retorna quantas chaves pertencem
+*/
+int lista_pertence_lote(LISTA *l, const int *chaves, int k, bool *saida)
+{
+    if (l == NULL || k <= 0)
+    {
+        return 0;
+    }
+    int encontradas = 0;
+    int *ordem = (int *)malloc(k * sizeof(int));
+    if (ordem == NULL || !ordenar_indices(chaves, ordem, k))
+    {
+        // sem memória para ordenar: uma busca por chave
+        free(ordem);
+        for (int i = 0; i < k; i++)
+        {
+            saida[i] = lista_pertence(l, chaves[i]);
+            encontradas += saida[i];
+        }
+        return encontradas;
+    }
+
+    const int *v = l->lista;
+    int n = l->fim, inicio = 0; // as lápides guardam o valor antigo: o galope passa por elas e só a comparação final as exclui
+    for (int i = 0; i < k; i++)
+    {
+        int x = chaves[ordem[i]];
+        // galope: acha um intervalo (inicio + salto/2, inicio + salto] que contém a primeira posição com valor >= x
+        int salto = 1;
+        while (inicio + salto - 1 < n && v[inicio + salto - 1] < x)
+        {
+            salto *= 2;
+        }
+        int fim = inicio + salto - 1 < n ? inicio + salto - 1 : n;
+        inicio += salto / 2;
+        inicio += limite_inferior(v + inicio, fim - inicio, x);
+        saida[ordem[i]] = inicio < n && v[inicio] == x && !lista_e_lapide(l, inicio);
+        encontradas += saida[ordem[i]];
+    }
+    free(ordem);
+    return encontradas;
+}
+
 //////// UNIÃO /////////////
 
 /*
@@ -178,6 +749,8 @@ bool lista_pertence(LISTA *l, int chave)
     A mesma ideia é usada para intersecção, só que printa-se apenas os elementos que pertencem aos dois conjuntos.
     Quando uma lista acaba de ser percorrida, printa-se os elementos da outra (que serão maiores que o maior elemento da lista x)
     A ideia advém da propriedade: A união B = A + B - (A intersecção B)
+    Os elementos saem em ordem, então são escritos direto no vetor do resultado (sem a busca binária de lista_inserir),
+    que já nasce com espaço para as duas listas; o tamanho é definido uma vez, no final
 */
 LISTA *lista_uniao(LISTA *lista1, LISTA *lista2)
 {
@@ -195,43 +768,52 @@ LISTA *lista_uniao(LISTA *lista1, LISTA *lista2)
     }
 
     LISTA *lista_resultado;
-    // cria-se uma lista com o maior tamanho das 2, dado que esse é o maior tamanho para interseccao
+    // cria-se uma lista com a soma dos tamanhos das 2, dado que esse é o maior tamanho para a união
     lista_resultado = lista_criar(lista1->tamanho_atual + lista2->tamanho_atual);
+    if (lista_resultado == NULL)
+    {
+        return NULL;
+    }
+    int *saida = lista_resultado->lista;
+    int k = 0;
 
-    int i = 0, j = 0;
-    while (i < lista1->tamanho_atual && j < lista2->tamanho_atual)
+    // as posições vão de 0 a "fim", pulando as lápides (lista_proxima_viva)
+    int i = lista_proxima_viva(lista1, 0), j = lista_proxima_viva(lista2, 0);
+    while (i < lista1->fim && j < lista2->fim)
     {
         if (lista1->lista[i] == lista2->lista[j])
         {
-            lista_inserir(lista_resultado, lista1->lista[i]);
-            i++;
-            j++;
+            saida[k++] = lista1->lista[i];
+            i = lista_proxima_viva(lista1, i + 1);
+            j = lista_proxima_viva(lista2, j + 1);
         }
         else if (lista1->lista[i] > lista2->lista[j])
         {
-            lista_inserir(lista_resultado, lista2->lista[j]);
-            j++;
+            saida[k++] = lista2->lista[j];
+            j = lista_proxima_viva(lista2, j + 1);
         }
         else
         {
-            lista_inserir(lista_resultado, lista1->lista[i]);
-            i++;
+            saida[k++] = lista1->lista[i];
+            i = lista_proxima_viva(lista1, i + 1);
         }
     }
 
     // adiciona os elementos restantes de lista1, se existirem
-    while (i < lista1->tamanho_atual)
+    while (i < lista1->fim)
     {
-        lista_inserir(lista_resultado, lista1->lista[i]);
-        i++;
+        saida[k++] = lista1->lista[i];
+        i = lista_proxima_viva(lista1, i + 1);
     }
 
     // adiciona os elementos restantes de lista2, se existirem
-    while (j < lista2->tamanho_atual)
+    while (j < lista2->fim)
     {
-        lista_inserir(lista_resultado, lista2->lista[j]);
-        j++;
+        saida[k++] = lista2->lista[j];
+        j = lista_proxima_viva(lista2, j + 1);
     }
+    lista_resultado->fim = k;
+    lista_resultado->tamanho_atual = k;
     // para usar apenas o espaço de memória desejado, vamos utilizar a função "realloc"
     if (lista_resultado->tamanho_atual != 0)
     {
@@ -244,7 +826,9 @@ LISTA *lista_uniao(LISTA *lista1, LISTA *lista2)
 /*
     Intersecção
     Parâmetros: duas listas a serem achados os elementos em comum
-    Ideia: mesma ideia para união, de percorrer os vetores paralelamente, (para Big Oh de O(n)), mas apenas printa-se os elementos em comum (A intersecção B)
+    Ideia: mesma ideia para união, de percorrer os vetores paralelamente, (para Big Oh de O(n)), mas apenas guarda-se os elementos em comum (A intersecção B).
+    O percurso é feito por intersecao_vetores, que usa comparações em bloco SSE4.2/AVX2 quando a CPU permite,
+    e escreve os elementos comuns direto no vetor do resultado (sem passar pela busca binária de lista_inserir)
 */
 LISTA *lista_intersecao(LISTA *lista1, LISTA *lista2)
 {
@@ -262,37 +846,297 @@ LISTA *lista_intersecao(LISTA *lista1, LISTA *lista2)
     {
         lista_resultado = lista_criar(lista1->tamanho_atual);
     }
-    int i = 0, j = 0;
-    while (i < lista1->tamanho_atual && j < lista2->tamanho_atual)
+    if (lista_resultado == NULL)
     {
-        if (lista1->lista[i] == lista2->lista[j])
+        return NULL;
+    }
+    int comuns = 0;
+    if (lista1->lapides == NULL && lista2->lapides == NULL)
+    {
+        comuns = intersecao_vetores(lista1->lista, lista1->tamanho_atual, lista2->lista, lista2->tamanho_atual, lista_resultado->lista);
+    }
+    else
+    {
+        // com lápides, o valor antigo de uma posição removida não pode casar: intercalação escalar pulando as lápides
+        int i = lista_proxima_viva(lista1, 0), j = lista_proxima_viva(lista2, 0);
+        while (i < lista1->fim && j < lista2->fim)
         {
-            lista_inserir(lista_resultado, lista1->lista[i]);
-            i++;
-            j++;
+            int x = lista1->lista[i], y = lista2->lista[j];
+            if (x == y)
+            {
+                lista_resultado->lista[comuns++] = x;
+            }
+            if (x <= y)
+                i = lista_proxima_viva(lista1, i + 1);
+            if (y <= x)
+                j = lista_proxima_viva(lista2, j + 1);
         }
-        else if (lista1->lista[i] > lista2->lista[j])
+    }
+    lista_resultado->fim = comuns;
+    lista_resultado->tamanho_atual = comuns;
+    // para usar apenas o espaço de memória desejado, vamos utilizar a função "realloc"
+    if (lista_resultado->tamanho_atual != 0)
+    {
+        lista_realocar(lista_resultado);
+    }
+    return lista_resultado;
+}
+/*
+    Intersecção por galope
+    Parâmetros: a lista menor e a lista maior
+    Ideia: em vez de percorrer a lista maior inteira, cada elemento da menor é procurado nela por busca exponencial (galope),
+    sempre a partir de onde a busca anterior parou. Vale a pena quando uma lista é muitas vezes maior que a outra
+*/
+LISTA *lista_intersecao_galope(LISTA *menor, LISTA *maior)
+{
+    if (menor == NULL || maior == NULL)
+    {
+        return NULL;
+    }
+    if (menor->lapides != NULL || maior->lapides != NULL)
+    {
+        return lista_intersecao(menor, maior); // o galope lê os vetores crus; com lápides, a intercalação as pula
+    }
+    LISTA *lista_resultado = lista_criar(menor->tamanho_atual);
+    if (lista_resultado == NULL)
+    {
+        return NULL;
+    }
+    int comuns = intersecao_vetores_galope(menor->lista, menor->tamanho_atual, maior->lista, maior->tamanho_atual, lista_resultado->lista);
+    lista_resultado->fim = comuns;
+    lista_resultado->tamanho_atual = comuns;
+    if (lista_resultado->tamanho_atual != 0)
+    {
+        lista_realocar(lista_resultado);
+    }
+    return lista_resultado;
+}
+////// UNIÃO E INTERSECÇÃO PARALELAS //////
+/*
+Fatia: pedaço das duas listas processado por uma thread
+As fatias são delimitadas pelo caminho de intercalação (merge path): a intercalação de "a" e "b" é uma sequência de n + m passos,
+e cada thread fica com um trecho de (n + m) / threads passos, o que dá o mesmo trabalho a todas, mesmo se os valores estiverem
+concentrados em uma das listas
+*/
+typedef struct
+{
+    const int *a;
+    const int *b;
+    int inicio_a, fim_a;
+    int inicio_b, fim_b;
+    bool uniao;     // true -> união, false -> intersecção
+    int *saida;     // NULL na passada de contagem
+    int quantidade; // elementos da saída desta fatia (resultado da passada de contagem)
+} FATIA_LISTA;
+
+/*
+    Caminho de intercalação
+    Parâmetros: os dois vetores, seus tamanhos e a diagonal (quantos passos da intercalação já foram dados)
+    Ideia: busca binária pela divisão (i, j), com i + j = diagonal, em que os i primeiros de "a" e os j primeiros de "b"
+    são exatamente os "diagonal" primeiros da intercalação (em caso de empate, o de "a" vem antes).
+    Se a divisão separa um elemento de "a" do seu igual em "b", o de "b" é puxado para a mesma fatia,
+    para que a união não o repita e a intersecção não o perca
+*/
+static void caminho_intercalacao(const int *a, int na, const int *b, int nb, int diagonal, int *i, int *j)
+{
+    int inf = diagonal > nb ? diagonal - nb : 0;
+    int sup = diagonal < na ? diagonal : na;
+    while (inf < sup)
+    {
+        int meio = inf + (sup - inf) / 2;
+        if (a[meio] <= b[diagonal - meio - 1])
         {
-            j++;
+            inf = meio + 1;
         }
         else
         {
-            i++;
+            sup = meio;
         }
     }
-    // para usar apenas o espaço de memória desejado, vamos utilizar a função "realloc"
-    if (lista_resultado->tamanho_atual != 0)
+    *i = inf;
+    *j = diagonal - inf;
+    if (*i > 0 && *j < nb && a[*i - 1] == b[*j])
     {
-        lista_realocar(lista_resultado);
+        (*j)++;
     }
-    return lista_resultado;
 }
+
+/*
+    Execução de uma fatia (corpo de cada thread)
+    Ideia: na passada de contagem (saida NULL), só conta quantos elementos a fatia produz; na passada de escrita,
+    escreve-os a partir da posição da fatia no vetor do resultado. A intersecção escreve com intersecao_vetores (SIMD)
+*/
+static void *fatia_executar(void *argumento)
+{
+    FATIA_LISTA *f = (FATIA_LISTA *)argumento;
+    int i = f->inicio_a, j = f->inicio_b, k = 0;
+    if (!f->uniao && f->saida != NULL)
+    {
+        f->quantidade = intersecao_vetores(f->a + i, f->fim_a - i, f->b + j, f->fim_b - j, f->saida);
+        return NULL;
+    }
+    while (i < f->fim_a && j < f->fim_b)
+    {
+        int x = f->a[i], y = f->b[j];
+        if (f->uniao)
+        {
+            if (f->saida != NULL)
+                f->saida[k] = x <= y ? x : y;
+            k++;
+        }
+        else if (x == y)
+        {
+            k++;
+        }
+        i += x <= y;
+        j += y <= x;
+    }
+    if (f->uniao)
+    {
+        // restos das duas listas (no máximo um deles não é vazio)
+        if (f->saida != NULL)
+        {
+            memcpy(f->saida + k, f->a + i, (f->fim_a - i) * sizeof(int));
+            memcpy(f->saida + k + (f->fim_a - i), f->b + j, (f->fim_b - j) * sizeof(int));
+        }
+        k += (f->fim_a - i) + (f->fim_b - j);
+    }
+    f->quantidade = k;
+    return NULL;
+}
+
+/*
+    Executar fatias
+    Ideia: a fatia 0 roda na própria thread chamadora e as demais em threads novas; se alguma thread não puder ser criada,
+    sua fatia roda na chamadora. Retorna quando todas terminaram
+*/
+static void executar_fatias(FATIA_LISTA *fatias, int quantidade)
+{
+    pthread_t *threads = (pthread_t *)malloc(quantidade * sizeof(pthread_t));
+    bool *criada = (bool *)calloc(quantidade, sizeof(bool));
+    for (int t = 1; t < quantidade; t++)
+    {
+        criada[t] = threads != NULL && criada != NULL && pthread_create(&threads[t], NULL, fatia_executar, &fatias[t]) == 0;
+    }
+    fatia_executar(&fatias[0]);
+    for (int t = 1; t < quantidade; t++)
+    {
+        if (criada != NULL && criada[t])
+            pthread_join(threads[t], NULL);
+        else
+            fatia_executar(&fatias[t]);
+    }
+    free(threads);
+    free(criada);
+}
+
+/*
+    Operação paralela
+    Parâmetros: as duas listas, quantidade de threads e se é união ou intersecção
+    Ideia:
+        1) divide a intercalação em fatias iguais pelo caminho de intercalação
+        2) passada de contagem: cada thread conta o tamanho da saída da sua fatia
+        3) a soma de prefixos das contagens dá onde cada fatia começa no resultado, que é alocado já com o tamanho exato
+        4) passada de escrita: cada thread escreve a sua fatia direto no vetor do resultado, sem sincronização
+    Cada thread recebe pelo menos MINIMO_POR_THREAD passos da intercalação; abaixo disso, criar threads custa mais do que ganha
+*/
+static LISTA *lista_operacao_paralela(LISTA *lista1, LISTA *lista2, int threads, bool uniao)
+{
+    const int *a = lista1->lista, *b = lista2->lista;
+    int na = lista1->tamanho_atual, nb = lista2->tamanho_atual;
+    long long total_passos = (long long)na + nb;
+    if (threads > total_passos / MINIMO_POR_THREAD)
+    {
+        threads = (int)(total_passos / MINIMO_POR_THREAD);
+    }
+    if (threads < 1)
+    {
+        threads = 1;
+    }
+    FATIA_LISTA *fatias = (FATIA_LISTA *)malloc(threads * sizeof(FATIA_LISTA));
+    if (fatias == NULL)
+    {
+        return NULL;
+    }
+    intersecao_kernel_ativo(); // escolhe o kernel SIMD antes de as threads o consultarem
+
+    int i_anterior = 0, j_anterior = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        int i = na, j = nb;
+        if (t + 1 < threads)
+        {
+            caminho_intercalacao(a, na, b, nb, (int)(total_passos * (t + 1) / threads), &i, &j);
+        }
+        fatias[t] = (FATIA_LISTA){a, b, i_anterior, i, j_anterior, j, uniao, NULL, 0};
+        i_anterior = i;
+        j_anterior = j;
+    }
+
+    executar_fatias(fatias, threads);
+    int total = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        total += fatias[t].quantidade;
+    }
+    LISTA *resultado = lista_criar(total);
+    if (resultado == NULL)
+    {
+        free(fatias);
+        return NULL;
+    }
+    int posicao = 0;
+    for (int t = 0; t < threads; t++)
+    {
+        fatias[t].saida = resultado->lista + posicao;
+        posicao += fatias[t].quantidade;
+    }
+    executar_fatias(fatias, threads);
+
+    resultado->fim = total;
+    resultado->tamanho_atual = total;
+    free(fatias);
+    return resultado;
+}
+
+/*
+    União paralela
+    Parâmetros: duas listas e a quantidade de threads
+    Ideia: com uma thread (ou listas pequenas demais para dividir, ou com lápides), é a lista_uniao; senão, ver lista_operacao_paralela
+*/
+LISTA *lista_uniao_paralela(LISTA *lista1, LISTA *lista2, int threads)
+{
+    if (lista1 == NULL || lista2 == NULL || threads <= 1 || lista1->lapides != NULL || lista2->lapides != NULL ||
+        (long long)lista1->tamanho_atual + lista2->tamanho_atual < 2LL * MINIMO_POR_THREAD)
+    {
+        return lista_uniao(lista1, lista2);
+    }
+    return lista_operacao_paralela(lista1, lista2, threads, true);
+}
+
+/*
+    Intersecção paralela
+    Parâmetros: duas listas e a quantidade de threads
+    Ideia: com uma thread (ou listas pequenas demais para dividir, ou com lápides), é a lista_intersecao; senão, ver lista_operacao_paralela
+*/
+LISTA *lista_intersecao_paralela(LISTA *lista1, LISTA *lista2, int threads)
+{
+    if (lista1 == NULL || lista2 == NULL || threads <= 1 || lista1->lapides != NULL || lista2->lapides != NULL ||
+        (long long)lista1->tamanho_atual + lista2->tamanho_atual < 2LL * MINIMO_POR_THREAD)
+    {
+        return lista_intersecao(lista1, lista2);
+    }
+    return lista_operacao_paralela(lista1, lista2, threads, false);
+}
+
 ////// REMOÇÃO ////////
 /*
     Remover
     Parâmetros: lista e elemento a ser removido
     Ideia: utiliza-se a função de "Busca", por busca binária, para achar a posição do elemento.
-    A partir disso, se encontrado, o elemento é retirado e realiza-se shift left dos elementos à direita do elemento removido
+    A partir disso, se encontrado, o elemento é retirado e realiza-se shift left dos elementos à direita do elemento removido.
+    Com a remoção preguiçosa ativa, a posição só é marcada como lápide (O(log n)), e a lista é compactada quando a fração de
+    lápides passa de limite_lapides (cada compactação O(n) é paga por pelo menos limite_lapides * n remoções)
 */
 bool lista_remover(LISTA *l, int x)
 {
@@ -305,21 +1149,63 @@ bool lista_remover(LISTA *l, int x)
     {
         return false;
     }
-    // Shift para a esquerda
-    for (int i = posicao; i < (l->fim); i++)
+    // a última posição sai sem deslocamento; as demais viram lápide (se faltar memória para o mapa, desloca normalmente)
+    if (l->remocao_preguicosa && posicao < l->fim - 1 && lista_marcar_lapide(l, posicao))
     {
-        l->lista[i] = l->lista[i + 1];
+        return true;
     }
-    if (l->lista[l->fim] != -1)
+    CONTAR(deslocamentos, l->fim - 1 - posicao);
+    // Shift para a esquerda (o último elemento é o da posição fim - 1)
+    for (int i = posicao; i < (l->fim - 1); i++)
     {
-        // Apenas libere memória se os elementos forem ponteiros alocados
-        l->lista[l->fim] = -1;
+        l->lista[i] = l->lista[i + 1];
     }
-    l->lista[l->fim] = -1;
     l->fim--;
     l->tamanho_atual--;
+    l->eytzinger_valido = false;
     return true;
 }
+/*
+    Remover em lote
+    Parâmetros: lista, vetor ordenado e sem repetições com os elementos a serem removidos, e seu tamanho k
+    Ideia: percorre a lista e o lote paralelamente uma única vez, copiando para a frente apenas os elementos que não estão no lote.
+    Cada elemento que permanece é deslocado no máximo uma vez. Custo: O(n + k). Retorna quantos elementos foram removidos
+*/
+int lista_remover_lote(LISTA *l, const int *ordenado, int k)
+{
+    if (l == NULL)
+    {
+        return ERRO;
+    }
+    int destino = 0, j = 0, vivos = l->tamanho_atual;
+    for (int i = 0; i < l->fim; i++)
+    {
+        if (lista_e_lapide(l, i))
+        {
+            continue; // a passada já compacta: as lápides ficam para trás
+        }
+        while (j < k && ordenado[j] < l->lista[i])
+        {
+            j++;
+        }
+        if (j < k && ordenado[j] == l->lista[i])
+        {
+            j++;
+            continue; // elemento removido
+        }
+        l->lista[destino++] = l->lista[i];
+    }
+    int removidos = vivos - destino;
+    l->fim = destino;
+    l->tamanho_atual = destino;
+    free(l->lapides);
+    l->lapides = NULL;
+    if (removidos > 0)
+    {
+        l->eytzinger_valido = false;
+    }
+    return removidos;
+}
 ///// APAGAR ///////
 /*
     Apagar
@@ -333,10 +1219,16 @@ bool lista_apagar(LISTA **l)
         return false;
     }
 
-    if ((*l)->lista != NULL)
+    if ((*l)->mapa != NULL)
+    {
+        munmap((*l)->mapa, (*l)->tamanho_mapa);
+    }
+    else if ((*l)->lista != NULL)
     {
         free((*l)->lista);
     }
+    free((*l)->eytzinger);
+    free((*l)->lapides);
 
     free(*l);
     *l = NULL;
@@ -344,29 +1236,109 @@ bool lista_apagar(LISTA **l)
     return true;
 }
 
-/////// IMPRIMIR ////////
+/////// ITERADOR ///////
 /*
-    Imprimir
-    Parâmetro: lista
-    Ideia: percorre a lista da posição 0 até o tamanho atual dela
+    Iterador da Lista
+    Parâmetro: iterador e lista
+    Ideia: o vetor já está em ordem, então o iterador é só uma posição nele; proximo devolve o elemento da posição e avança
 */
-void lista_imprimir(LISTA *l)
+void lista_iterador_iniciar(ITERADOR_LISTA *iterador, LISTA *l)
 {
-    printf("{");
-    if (l == NULL || lista_vazia(l))
+    iterador->vetor = l != NULL ? l->lista : NULL;
+    iterador->lapides = l != NULL ? l->lapides : NULL;
+    iterador->n = l != NULL ? l->fim : 0;
+    iterador->posicao = 0;
+}
+
+bool lista_iterador_proximo(ITERADOR_LISTA *iterador, int *elemento)
+{
+    // pula as lápides (posições removidas na remoção preguiçosa)
+    while (iterador->lapides != NULL && iterador->posicao < iterador->n &&
+           ((iterador->lapides[iterador->posicao >> 6] >> (iterador->posicao & 63)) & 1))
     {
-        printf("}");
-        return;
+        iterador->posicao++;
     }
-    for (int i = 0; i < l->tamanho_atual; i++)
+    if (iterador->posicao >= iterador->n)
     {
-        printf("%d ", l->lista[i]);
+        return false;
+    }
+    *elemento = iterador->vetor[iterador->posicao++];
+    return true;
+}
+
+/*
+    Buscar a partir de
+    Parâmetro: iterador, chave e onde escrever o elemento encontrado
+    Ideia: galope a partir da posição atual (passos 1, 2, 4, ... até passar da chave) e busca binária no último passo,
+    como em intersecao_vetores_galope; pular d elementos custa O(log d). Devolve o primeiro elemento >= chave e avança além dele.
+    As lápides guardam o valor antigo, então o galope passa por elas e lista_iterador_proximo pula as que sobrarem
+*/
+bool lista_iterador_buscar_a_partir_de(ITERADOR_LISTA *iterador, int chave, int *elemento)
+{
+    const int *v = iterador->vetor;
+    int inicio = iterador->posicao, passo = 1;
+    while (inicio + passo < iterador->n && v[inicio + passo] < chave)
+    {
+        CONTAR(comparacoes, 1);
+        inicio += passo;
+        passo *= 2;
+    }
+    // A resposta está em [inicio, fim): v[inicio - 1] < chave (ou inicio é a posição atual) e v[fim] >= chave (ou fim é n)
+    int fim = inicio + passo < iterador->n ? inicio + passo : iterador->n;
+    while (inicio < fim)
+    {
+        CONTAR(comparacoes, 1);
+        int meio = inicio + (fim - inicio) / 2;
+        if (v[meio] < chave)
+        {
+            inicio = meio + 1;
+        }
+        else
+        {
+            fim = meio;
+        }
     }
-    printf("}");
+    iterador->posicao = inicio;
+    return lista_iterador_proximo(iterador, elemento);
 }
 
 /////// Funções Auxiliares ////////
 
+/*
+    Elementos da Lista
+    Parâmetro: lista
+    Ideia: retorna o vetor ordenado da lista, só para leitura; deixa de valer quando a lista é alterada. Não altera a lista: se há
+    lápides o vetor tem buracos e retorna NULL (quem precisa dos elementos usa lista_exportar, ou compacta antes com lista_compactar)
+*/
+const int *lista_elementos(LISTA *l)
+{
+    return l != NULL && l->lapides == NULL ? l->lista : NULL;
+}
+
+/*
+    Exportar
+    Parâmetros: lista e vetor de saída (com espaço para lista_tamanho elementos)
+    Ideia: copia os elementos em ordem crescente, pulando as lápides sem compactar a lista. Retorna quantos foram copiados
+*/
+int lista_exportar(LISTA *l, int *saida)
+{
+    if (l == NULL)
+    {
+        return 0;
+    }
+    if (l->lapides == NULL)
+    {
+        memcpy(saida, l->lista, l->tamanho_atual * sizeof(int));
+        return l->tamanho_atual;
+    }
+    int n = 0;
+    for (int i = lista_proxima_viva(l, 0); i < l->fim; i = lista_proxima_viva(l, i + 1))
+    {
+        saida[n++] = l->lista[i];
+    }
+    return n;
+}
+
 /*
     Tamanho da Lista
     Parâmetro: lista
@@ -381,10 +1353,11 @@ int lista_tamanho(LISTA *l)
     return ERRO;
 }
 /*
-    Realocar memória para a Lista
+    Realocar memória para a Lista (shrink to fit)
     Parâmetro: lista
     Ideia: tem o objetivo de não disperdiçar espaço de memória. Funções como intersecção e união utilizam memória a mais para realizar seus processos,
-    e precisam de um "realloc" ao final desse processo. Para isso, a função realoca memória para o "tamanho atual" da lista
+    e precisam de um "realloc" ao final desse processo. Para isso, a função realoca memória para o "tamanho atual" da lista (com pelo menos 1 posição)
+    e a capacidade passa a ser esse tamanho; uma inserção posterior faz a lista crescer novamente
 */
 bool lista_realocar(LISTA *l)
 {
@@ -393,17 +1366,31 @@ bool lista_realocar(LISTA *l)
         printf("Erro ao realocar, L nulo");
         return false;
     }
-    int *nova_lista = (int *)realloc(l->lista, l->tamanho_atual * sizeof(int));
-    if (nova_lista == NULL)
+    lista_compactar(l);
+    int capacidade = l->tamanho_atual > 0 ? l->tamanho_atual : 1;
+    if (!lista_trocar_vetor(l, capacidade))
     {
         printf("Erro ao realocar");
         return false;
     }
-    l->lista = nova_lista;
+    l->tamanho_maximo = capacidade;
     l->fim = l->tamanho_atual;
     // printf("\n Realocar deu sucesso!!");
     return true;
 }
+/*
+    Capacidade da Lista
+    Parâmetro: lista
+    Ideia: retorna quantos elementos cabem no vetor atual sem realocação
+*/
+int lista_capacidade(LISTA *l)
+{
+    if (l != NULL)
+    {
+        return l->tamanho_maximo;
+    }
+    return ERRO;
+}
 /*
     Lista Vazia
     Parâmetro: lista
@@ -425,13 +1412,13 @@ bool lista_vazia(LISTA *l)
 /*
     Lista Cheia
     Parâmetro: lista
-    Ideia: se o tamanho máximo da lista é igual ao tamanho máximo da lista, ela está cheia
+    Ideia: se as posições ocupadas (incluindo lápides) chegaram ao tamanho máximo da lista, ela está cheia
 */
 bool lista_cheia(LISTA *l)
 {
     if (l != NULL)
     {
-        if (l->tamanho_atual == l->tamanho_maximo)
+        if (l->fim == l->tamanho_maximo)
         {
             return true;
         }
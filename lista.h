@@ -1,22 +1,64 @@
 
 #ifndef LISTA_H
 #define LISTA_H
+#include <stddef.h>
+#include <stdint.h>
 #define TAM_MAX 100
 // #define inicial 0
 #define ERRO -1
+// Fator padrão pelo qual a capacidade da lista é multiplicada quando ela enche
+#define FATOR_CRESCIMENTO 2.0f
+// Fração padrão de lápides (posições removidas na remoção preguiçosa) a partir da qual a lista é compactada
+#ifndef LIMITE_LAPIDES
+#define LIMITE_LAPIDES 0.5f
+#endif
+// Passos mínimos da intercalação por thread nas operações paralelas (abaixo disso, a thread não se paga)
+#ifndef MINIMO_POR_THREAD
+#define MINIMO_POR_THREAD 65536
+#endif
 
 typedef struct lista_ LISTA;
+
+// Iterador da lista: posição no vetor ordenado; qualquer alteração na lista o invalida
+typedef struct IteradorLista
+{
+    const int *vetor;
+    const uint64_t *lapides; // posições removidas que o iterador pula (NULL se não há)
+    int n;
+    int posicao;
+} ITERADOR_LISTA;
+
 LISTA *lista_criar(int n);
+LISTA *lista_criar_de_vetor(const int *vetor, int n);
+LISTA *lista_criar_de_mapa(void *mapa, size_t tamanho_mapa, int *vetor, int n);
 bool lista_inserir(LISTA *lista, int item);
 bool lista_remover(LISTA *lista, int chave);
+int lista_inserir_lote(LISTA *lista, const int *ordenado, int k);
+int lista_remover_lote(LISTA *lista, const int *ordenado, int k);
 int lista_busca_binaria(LISTA *lista, int chave);
 int lista_tamanho(LISTA *lista);
+const int *lista_elementos(LISTA *lista);
+int lista_exportar(LISTA *lista, int *saida);
 bool lista_pertence(LISTA *lista, int chave);
+int lista_pertence_lote(LISTA *lista, const int *chaves, int k, bool *saida);
+bool lista_otimizar_busca(LISTA *lista, bool ativar);
+bool lista_remocao_preguicosa(LISTA *lista, bool ativar);
+bool lista_definir_limite_lapides(LISTA *lista, float limite);
+bool lista_compactar(LISTA *lista);
+int lista_lapides(LISTA *lista);
 bool lista_vazia(LISTA *lista);
 bool lista_cheia(LISTA *lista);
-void lista_imprimir(LISTA *lista);
 bool lista_apagar(LISTA **lista);
 LISTA *lista_uniao(LISTA *lista1, LISTA *lista2);
 LISTA *lista_intersecao(LISTA *lista1, LISTA *lista2);
+LISTA *lista_intersecao_galope(LISTA *menor, LISTA *maior);
+LISTA *lista_uniao_paralela(LISTA *lista1, LISTA *lista2, int threads);
+LISTA *lista_intersecao_paralela(LISTA *lista1, LISTA *lista2, int threads);
 bool lista_realocar(LISTA *lista);
+bool lista_reservar(LISTA *lista, int capacidade);
+bool lista_definir_fator_crescimento(LISTA *lista, float fator);
+int lista_capacidade(LISTA *lista);
+void lista_iterador_iniciar(ITERADOR_LISTA *iterador, LISTA *lista);
+bool lista_iterador_proximo(ITERADOR_LISTA *iterador, int *elemento);
+bool lista_iterador_buscar_a_partir_de(ITERADOR_LISTA *iterador, int chave, int *elemento);
 #endif
@@ -0,0 +1,622 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "lista_blocos.h"
+#include "intersecao_vetores.h"
+#include "estatisticas.h"
+
+/*
+Lista sequencial ordenada em blocos (vetor em camadas)
+Em vez de um único vetor, as chaves ficam em blocos ordenados de até CHAVES_BLOCO posições, e um diretório pequeno
+guarda os blocos em ordem, junto com a maior chave de cada um.
+    - Busca: binária no diretório (sem ler os blocos) e depois binária dentro do bloco
+    - Inserção e remoção deslocam só as chaves do próprio bloco, não a cauda inteira da lista: O(CHAVES_BLOCO + log n)
+    - Um bloco cheio é dividido ao meio; dois blocos vizinhos que, juntos, caibam em meio bloco são juntados.
+      Assim, dois vizinhos quaisquer somam mais de CHAVES_BLOCO / 2 chaves e há no máximo 4n / CHAVES_BLOCO + 1 blocos,
+      então as divisões e junções (que deslocam o diretório) também custam O(n / CHAVES_BLOCO)
+    - Com CHAVES_BLOCO perto de raiz de n, cada alteração é O(raiz de n); com o padrão de 1024, o diretório de
+      10 milhões de chaves tem no máximo cerca de 40 mil blocos
+    - Dentro de cada bloco as chaves continuam contíguas, então união e interseção leem a memória em ordem, bloco a bloco
+*/
+#define MINIMO_JUNCAO (CHAVES_BLOCO / 2)
+
+typedef struct
+{
+    int *chaves; // CHAVES_BLOCO posições, as "quantidade" primeiras em ordem crescente
+    int quantidade;
+} BLOCO;
+
+struct ListaBlocos
+{
+    BLOCO *blocos;  // diretório: as chaves de cada bloco são maiores que as do bloco anterior; nenhum bloco fica vazio
+    int *ultimos;   // maior chave de cada bloco, separada para a busca no diretório ler só esse vetor
+    int quantidade; // blocos em uso
+    int capacidade; // posições do diretório
+    int tamanho;
+};
+
+// Primeira posição com chave >= x
+static int limite_inferior(const int *chaves, int n, int x)
+{
+    int inicio = 0, fim = n;
+    while (inicio < fim)
+    {
+        CONTAR(comparacoes, 1);
+        int meio = (inicio + fim) / 2;
+        if (chaves[meio] < x)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+// Primeira posição com chave > x
+static int limite_superior(const int *chaves, int n, int x)
+{
+    int inicio = 0, fim = n;
+    while (inicio < fim)
+    {
+        CONTAR(comparacoes, 1);
+        int meio = (inicio + fim) / 2;
+        if (chaves[meio] <= x)
+            inicio = meio + 1;
+        else
+            fim = meio;
+    }
+    return inicio;
+}
+
+/////// DIRETÓRIO ///////
+/*
+    Reservar diretório
+    Ideia: garante espaço para "capacidade" blocos no diretório, dobrando-o quando precisa crescer
+*/
+static bool reservar_diretorio(LISTA_BLOCOS *lista, int capacidade)
+{
+    if (capacidade <= lista->capacidade)
+    {
+        return true;
+    }
+    int nova = lista->capacidade > 0 ? lista->capacidade : 1;
+    while (nova < capacidade)
+    {
+        nova *= 2;
+    }
+    BLOCO *blocos = (BLOCO *)realloc(lista->blocos, nova * sizeof(BLOCO));
+    if (blocos == NULL)
+    {
+        return false;
+    }
+    lista->blocos = blocos;
+    int *ultimos = (int *)realloc(lista->ultimos, nova * sizeof(int));
+    if (ultimos == NULL)
+    {
+        return false;
+    }
+    lista->ultimos = ultimos;
+    lista->capacidade = nova;
+    CONTAR(realocacoes, 1);
+    return true;
+}
+
+/*
+    Abrir posição no diretório
+    Ideia: cria um bloco vazio e o coloca na posição "b" do diretório, deslocando os seguintes. Retorna false se faltou memória
+*/
+static bool abrir_bloco(LISTA_BLOCOS *lista, int b)
+{
+    if (!reservar_diretorio(lista, lista->quantidade + 1))
+    {
+        return false;
+    }
+    int *chaves = (int *)malloc(CHAVES_BLOCO * sizeof(int));
+    if (chaves == NULL)
+    {
+        return false;
+    }
+    CONTAR(alocacoes, 1);
+    memmove(&lista->blocos[b + 1], &lista->blocos[b], (lista->quantidade - b) * sizeof(BLOCO));
+    memmove(&lista->ultimos[b + 1], &lista->ultimos[b], (lista->quantidade - b) * sizeof(int));
+    CONTAR(deslocamentos, lista->quantidade - b);
+    lista->blocos[b].chaves = chaves;
+    lista->blocos[b].quantidade = 0;
+    lista->quantidade++;
+    return true;
+}
+
+// Libera o bloco da posição "b" e o tira do diretório
+static void fechar_bloco(LISTA_BLOCOS *lista, int b)
+{
+    free(lista->blocos[b].chaves);
+    CONTAR(liberacoes, 1);
+    memmove(&lista->blocos[b], &lista->blocos[b + 1], (lista->quantidade - b - 1) * sizeof(BLOCO));
+    memmove(&lista->ultimos[b], &lista->ultimos[b + 1], (lista->quantidade - b - 1) * sizeof(int));
+    CONTAR(deslocamentos, lista->quantidade - b - 1);
+    lista->quantidade--;
+}
+
+/*
+    Localizar bloco
+    Ideia: busca binária no vetor das maiores chaves: o primeiro bloco cuja maior chave é >= chave é o único que pode contê-la.
+    Retorna lista->quantidade se a chave é maior que todas
+*/
+static int localizar_bloco(LISTA_BLOCOS *lista, int chave)
+{
+    return limite_inferior(lista->ultimos, lista->quantidade, chave);
+}
+
+/////// CRIAR E APAGAR ///////
+LISTA_BLOCOS *lista_blocos_criar(void)
+{
+    LISTA_BLOCOS *lista = (LISTA_BLOCOS *)malloc(sizeof(LISTA_BLOCOS));
+    if (lista == NULL)
+    {
+        return NULL;
+    }
+    lista->blocos = NULL;
+    lista->ultimos = NULL;
+    lista->quantidade = 0;
+    lista->capacidade = 0;
+    lista->tamanho = 0;
+    return lista;
+}
+
+/*
+    Construção a partir de vetor ordenado
+    Parâmetros: vetor ordenado sem repetições e seu tamanho
+    Ideia: as chaves são divididas igualmente entre o menor número de blocos que as comporta, em O(n).
+    Os blocos saem quase cheios, como o vetor da lista; a primeira inserção em cada um o divide
+*/
+LISTA_BLOCOS *lista_blocos_criar_de_vetor(const int *ordenado, int n)
+{
+    LISTA_BLOCOS *lista = lista_blocos_criar();
+    if (lista == NULL)
+    {
+        return NULL;
+    }
+    int blocos = (n + CHAVES_BLOCO - 1) / CHAVES_BLOCO;
+    if (!reservar_diretorio(lista, blocos))
+    {
+        lista_blocos_apagar(&lista);
+        return NULL;
+    }
+    int usados = 0;
+    for (int b = 0; b < blocos; b++)
+    {
+        if (!abrir_bloco(lista, b))
+        {
+            lista_blocos_apagar(&lista);
+            return NULL;
+        }
+        int k = n / blocos + (b < n % blocos);
+        memcpy(lista->blocos[b].chaves, ordenado + usados, k * sizeof(int));
+        lista->blocos[b].quantidade = k;
+        usados += k;
+        lista->ultimos[b] = ordenado[usados - 1];
+    }
+    lista->tamanho = n;
+    return lista;
+}
+
+bool lista_blocos_apagar(LISTA_BLOCOS **lista)
+{
+    if (lista == NULL || *lista == NULL)
+    {
+        return false;
+    }
+    for (int b = 0; b < (*lista)->quantidade; b++)
+    {
+        free((*lista)->blocos[b].chaves);
+    }
+    free((*lista)->blocos);
+    free((*lista)->ultimos);
+    free(*lista);
+    *lista = NULL;
+    return true;
+}
+
+/////// INSERÇÃO E REMOÇÃO ///////
+/*
+    Dividir bloco
+    Ideia: abre um bloco logo após "b" e move para ele a metade de cima das chaves de "b"
+*/
+static bool dividir_bloco(LISTA_BLOCOS *lista, int b)
+{
+    if (!abrir_bloco(lista, b + 1))
+    {
+        return false;
+    }
+    BLOCO *esquerdo = &lista->blocos[b], *direito = &lista->blocos[b + 1];
+    int metade = esquerdo->quantidade / 2;
+    direito->quantidade = esquerdo->quantidade - metade;
+    memcpy(direito->chaves, esquerdo->chaves + metade, direito->quantidade * sizeof(int));
+    esquerdo->quantidade = metade;
+    lista->ultimos[b + 1] = lista->ultimos[b];
+    lista->ultimos[b] = esquerdo->chaves[metade - 1];
+    return true;
+}
+
+/*
+    Inserção
+    Ideia: acha o bloco pelo diretório (uma chave maior que todas vai para o último bloco) e a posição por busca binária;
+    se o bloco está cheio, ele é dividido antes. Só as chaves maiores do próprio bloco são deslocadas
+*/
+bool lista_blocos_inserir(LISTA_BLOCOS *lista, int chave)
+{
+    if (lista == NULL)
+    {
+        return false;
+    }
+    if (lista->quantidade == 0 && !abrir_bloco(lista, 0))
+    {
+        return false;
+    }
+    int b = localizar_bloco(lista, chave);
+    if (b == lista->quantidade)
+    {
+        b--;
+    }
+    BLOCO *bloco = &lista->blocos[b];
+    int i = limite_inferior(bloco->chaves, bloco->quantidade, chave);
+    if (i < bloco->quantidade && bloco->chaves[i] == chave)
+    {
+        return false;
+    }
+    if (bloco->quantidade == CHAVES_BLOCO)
+    {
+        if (!dividir_bloco(lista, b))
+        {
+            return false;
+        }
+        // a divisão pode ter realocado o diretório
+        if (i > lista->blocos[b].quantidade)
+        {
+            i -= lista->blocos[b].quantidade;
+            b++;
+        }
+        bloco = &lista->blocos[b];
+    }
+    memmove(&bloco->chaves[i + 1], &bloco->chaves[i], (bloco->quantidade - i) * sizeof(int));
+    CONTAR(deslocamentos, bloco->quantidade - i);
+    bloco->chaves[i] = chave;
+    bloco->quantidade++;
+    if (i == bloco->quantidade - 1)
+    {
+        lista->ultimos[b] = chave;
+    }
+    lista->tamanho++;
+    return true;
+}
+
+/*
+    Juntar blocos
+    Ideia: se o bloco "b" e um vizinho cabem juntos em meio bloco, as chaves do da direita passam para o da esquerda,
+    que fica com metade do bloco livre para inserções, e o da direita é liberado
+*/
+static void juntar_blocos(LISTA_BLOCOS *lista, int b)
+{
+    int esquerdo;
+    if (b + 1 < lista->quantidade && lista->blocos[b].quantidade + lista->blocos[b + 1].quantidade <= MINIMO_JUNCAO)
+    {
+        esquerdo = b;
+    }
+    else if (b > 0 && lista->blocos[b - 1].quantidade + lista->blocos[b].quantidade <= MINIMO_JUNCAO)
+    {
+        esquerdo = b - 1;
+    }
+    else
+    {
+        return;
+    }
+    BLOCO *destino = &lista->blocos[esquerdo], *origem = &lista->blocos[esquerdo + 1];
+    memcpy(destino->chaves + destino->quantidade, origem->chaves, origem->quantidade * sizeof(int));
+    destino->quantidade += origem->quantidade;
+    lista->ultimos[esquerdo] = lista->ultimos[esquerdo + 1];
+    fechar_bloco(lista, esquerdo + 1);
+}
+
+/*
+    Remoção
+    Ideia: acha o bloco e a posição como na inserção e desloca só as chaves maiores do bloco.
+    Um bloco que fica vazio sai do diretório; um que fica pequeno é juntado a um vizinho (juntar_blocos)
+*/
+bool lista_blocos_remover(LISTA_BLOCOS *lista, int chave)
+{
+    if (lista == NULL)
+    {
+        return false;
+    }
+    int b = localizar_bloco(lista, chave);
+    if (b == lista->quantidade)
+    {
+        return false;
+    }
+    BLOCO *bloco = &lista->blocos[b];
+    int i = limite_inferior(bloco->chaves, bloco->quantidade, chave);
+    if (i == bloco->quantidade || bloco->chaves[i] != chave)
+    {
+        return false;
+    }
+    memmove(&bloco->chaves[i], &bloco->chaves[i + 1], (bloco->quantidade - i - 1) * sizeof(int));
+    CONTAR(deslocamentos, bloco->quantidade - i - 1);
+    bloco->quantidade--;
+    lista->tamanho--;
+    if (bloco->quantidade == 0)
+    {
+        fechar_bloco(lista, b);
+        return true;
+    }
+    if (i == bloco->quantidade)
+    {
+        lista->ultimos[b] = bloco->chaves[i - 1];
+    }
+    juntar_blocos(lista, b);
+    return true;
+}
+
+/////// BUSCA ///////
+bool lista_blocos_pertence(LISTA_BLOCOS *lista, int chave)
+{
+    if (lista == NULL)
+    {
+        return false;
+    }
+    int b = localizar_bloco(lista, chave);
+    if (b == lista->quantidade)
+    {
+        return false;
+    }
+    BLOCO *bloco = &lista->blocos[b];
+    int i = limite_inferior(bloco->chaves, bloco->quantidade, chave);
+    return i < bloco->quantidade && bloco->chaves[i] == chave;
+}
+
+/////// PERCURSO ///////
+/*
+    Exportar
+    Parâmetros: lista e vetor de saída (com espaço para lista_blocos_tamanho elementos)
+    Ideia: copia as chaves de cada bloco, na ordem do diretório. Retorna a quantidade de chaves
+*/
+int lista_blocos_exportar(LISTA_BLOCOS *lista, int *saida)
+{
+    int n = 0;
+    for (int b = 0; lista != NULL && b < lista->quantidade; b++)
+    {
+        memcpy(saida + n, lista->blocos[b].chaves, lista->blocos[b].quantidade * sizeof(int));
+        n += lista->blocos[b].quantidade;
+    }
+    return n;
+}
+
+int lista_blocos_tamanho(LISTA_BLOCOS *lista)
+{
+    return lista != NULL ? lista->tamanho : 0;
+}
+
+int lista_blocos_quantidade_blocos(LISTA_BLOCOS *lista)
+{
+    return lista != NULL ? lista->quantidade : 0;
+}
+
+/*
+    Cursor: posição (bloco, índice) para percorrer a lista em ordem, usado pela união
+*/
+typedef struct
+{
+    LISTA_BLOCOS *lista;
+    int bloco;
+    int posicao;
+} CURSOR_BLOCOS;
+
+static bool cursor_valido(CURSOR_BLOCOS *cursor)
+{
+    return cursor->bloco < cursor->lista->quantidade;
+}
+
+static int cursor_valor(CURSOR_BLOCOS *cursor)
+{
+    return cursor->lista->blocos[cursor->bloco].chaves[cursor->posicao];
+}
+
+static void cursor_avancar(CURSOR_BLOCOS *cursor)
+{
+    if (++cursor->posicao == cursor->lista->blocos[cursor->bloco].quantidade)
+    {
+        cursor->bloco++;
+        cursor->posicao = 0;
+    }
+}
+
+/*
+    Intercalar com lote
+    Ideia: une a sequência dos blocos com um vetor ordenado em "saida", como na união de duas listas ordenadas.
+    Retorna o tamanho da saída
+*/
+static int intercalar(LISTA_BLOCOS *lista, const int *ordenado, int k, int *saida)
+{
+    CURSOR_BLOCOS cursor = {lista, 0, 0};
+    int n = 0, j = 0;
+    while (cursor_valido(&cursor) && j < k)
+    {
+        int x = cursor_valor(&cursor);
+        if (x < ordenado[j])
+        {
+            saida[n++] = x;
+            cursor_avancar(&cursor);
+        }
+        else
+        {
+            if (x == ordenado[j])
+                cursor_avancar(&cursor);
+            saida[n++] = ordenado[j++];
+        }
+    }
+    for (; cursor_valido(&cursor); cursor_avancar(&cursor))
+        saida[n++] = cursor_valor(&cursor);
+    while (j < k)
+        saida[n++] = ordenado[j++];
+    return n;
+}
+
+// Troca o conteúdo da lista pelo de "nova", que é liberada
+static void substituir(LISTA_BLOCOS *lista, LISTA_BLOCOS *nova)
+{
+    for (int b = 0; b < lista->quantidade; b++)
+    {
+        free(lista->blocos[b].chaves);
+    }
+    free(lista->blocos);
+    free(lista->ultimos);
+    *lista = *nova;
+    free(nova);
+}
+
+/////// LOTE ///////
+/*
+    Inserção em lote
+    Parâmetros: lista, vetor ordenado sem repetições e seu tamanho
+    Ideia: como na árvore B+, um lote pequeno é inserido chave a chave (cada inserção só mexe em um bloco);
+    um lote do tamanho da lista ou maior é intercalado com os blocos e a lista é reconstruída em O(n + k)
+*/
+int lista_blocos_inserir_lote(LISTA_BLOCOS *lista, const int *ordenado, int k)
+{
+    if (lista == NULL)
+    {
+        return -1;
+    }
+    if (k >= lista->tamanho && k > 0)
+    {
+        int *todas = (int *)malloc(((long)lista->tamanho + k) * sizeof(int));
+        if (todas != NULL)
+        {
+            int antes = lista->tamanho;
+            int n = intercalar(lista, ordenado, k, todas);
+            LISTA_BLOCOS *nova = lista_blocos_criar_de_vetor(todas, n);
+            free(todas);
+            if (nova != NULL)
+            {
+                substituir(lista, nova);
+                return n - antes;
+            }
+        }
+    }
+    int inseridos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        inseridos += lista_blocos_inserir(lista, ordenado[i]);
+    }
+    return inseridos;
+}
+
+int lista_blocos_remover_lote(LISTA_BLOCOS *lista, const int *ordenado, int k)
+{
+    if (lista == NULL)
+    {
+        return -1;
+    }
+    int removidos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        removidos += lista_blocos_remover(lista, ordenado[i]);
+    }
+    return removidos;
+}
+
+/////// UNIÃO E INTERSECÇÃO ///////
+/*
+    União
+    Ideia: as duas sequências de blocos são intercaladas em um vetor (O(n + m), lendo cada bloco em ordem)
+    e a lista resultado é montada dele em blocos quase cheios
+*/
+LISTA_BLOCOS *lista_blocos_uniao(LISTA_BLOCOS *lista1, LISTA_BLOCOS *lista2)
+{
+    if (lista1 == NULL || lista2 == NULL)
+    {
+        return NULL;
+    }
+    int *saida = (int *)malloc(((long)lista1->tamanho + lista2->tamanho + 1) * sizeof(int));
+    if (saida == NULL)
+    {
+        return NULL;
+    }
+    CURSOR_BLOCOS a = {lista1, 0, 0}, b = {lista2, 0, 0};
+    int n = 0;
+    while (cursor_valido(&a) && cursor_valido(&b))
+    {
+        int x = cursor_valor(&a), y = cursor_valor(&b);
+        if (x <= y)
+        {
+            saida[n++] = x;
+            cursor_avancar(&a);
+            if (x == y)
+                cursor_avancar(&b);
+        }
+        else
+        {
+            saida[n++] = y;
+            cursor_avancar(&b);
+        }
+    }
+    for (; cursor_valido(&a); cursor_avancar(&a))
+        saida[n++] = cursor_valor(&a);
+    for (; cursor_valido(&b); cursor_avancar(&b))
+        saida[n++] = cursor_valor(&b);
+
+    LISTA_BLOCOS *resultado = lista_blocos_criar_de_vetor(saida, n);
+    free(saida);
+    return resultado;
+}
+
+/*
+    Intersecção
+    Ideia: o restante do bloco atual de cada lista é intersectado com o kernel de vetores (intersecao_vetores, com SIMD).
+    Depois, o bloco com a menor maior chave (x) acabou: nenhuma das suas chaves aparece nos blocos seguintes da outra lista.
+    Na outra lista, as chaves <= x também não aparecem mais adiante, então a posição pula para depois delas (limite_superior).
+    Cada comum é escrito uma única vez e cada trecho é lido O(1) vezes: O(n + m)
+*/
+LISTA_BLOCOS *lista_blocos_intersecao(LISTA_BLOCOS *lista1, LISTA_BLOCOS *lista2)
+{
+    if (lista1 == NULL || lista2 == NULL)
+    {
+        return NULL;
+    }
+    int menor = lista1->tamanho < lista2->tamanho ? lista1->tamanho : lista2->tamanho;
+    int *saida = (int *)malloc((menor + 1) * sizeof(int));
+    if (saida == NULL)
+    {
+        return NULL;
+    }
+    int i = 0, j = 0, pa = 0, pb = 0, n = 0;
+    while (i < lista1->quantidade && j < lista2->quantidade)
+    {
+        BLOCO *x = &lista1->blocos[i], *y = &lista2->blocos[j];
+        n += intersecao_vetores(x->chaves + pa, x->quantidade - pa, y->chaves + pb, y->quantidade - pb, saida + n);
+        if (lista1->ultimos[i] <= lista2->ultimos[j])
+        {
+            pb += limite_superior(y->chaves + pb, y->quantidade - pb, lista1->ultimos[i]);
+            i++;
+            pa = 0;
+            if (pb == y->quantidade)
+            {
+                j++;
+                pb = 0;
+            }
+        }
+        else
+        {
+            pa += limite_superior(x->chaves + pa, x->quantidade - pa, lista2->ultimos[j]);
+            j++;
+            pb = 0;
+            if (pa == x->quantidade)
+            {
+                i++;
+                pa = 0;
+            }
+        }
+    }
+
+    LISTA_BLOCOS *resultado = lista_blocos_criar_de_vetor(saida, n);
+    free(saida);
+    return resultado;
+}
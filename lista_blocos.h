@@ -0,0 +1,24 @@
+#ifndef LISTA_BLOCOS_H
+#define LISTA_BLOCOS_H
+
+// Capacidade de cada bloco, em chaves (com int de 4 bytes, o padrão ocupa 4KB); um bloco cheio é dividido em dois pela metade
+#ifndef CHAVES_BLOCO
+#define CHAVES_BLOCO 1024
+#endif
+
+typedef struct ListaBlocos LISTA_BLOCOS;
+
+LISTA_BLOCOS *lista_blocos_criar(void);
+LISTA_BLOCOS *lista_blocos_criar_de_vetor(const int *ordenado, int n);
+bool lista_blocos_apagar(LISTA_BLOCOS **lista);
+bool lista_blocos_inserir(LISTA_BLOCOS *lista, int chave);
+bool lista_blocos_remover(LISTA_BLOCOS *lista, int chave);
+int lista_blocos_inserir_lote(LISTA_BLOCOS *lista, const int *ordenado, int k);
+int lista_blocos_remover_lote(LISTA_BLOCOS *lista, const int *ordenado, int k);
+bool lista_blocos_pertence(LISTA_BLOCOS *lista, int chave);
+int lista_blocos_tamanho(LISTA_BLOCOS *lista);
+int lista_blocos_quantidade_blocos(LISTA_BLOCOS *lista);
+int lista_blocos_exportar(LISTA_BLOCOS *lista, int *saida);
+LISTA_BLOCOS *lista_blocos_uniao(LISTA_BLOCOS *lista1, LISTA_BLOCOS *lista2);
+LISTA_BLOCOS *lista_blocos_intersecao(LISTA_BLOCOS *lista1, LISTA_BLOCOS *lista2);
+#endif
@@ -1,48 +1,175 @@
+#define _POSIX_C_SOURCE 200809L // mkstemp, pwrite e off_t com -std=c99
 #include <stdio.h>
 #include <stdlib.h>
 #include <stdbool.h>
+#include <unistd.h>
 #include "conjunto.h"
-int main(int argc, char *argv[])
+#include "entrada.h"
+#include "expressao.h"
+#include "latencia.h"
+
+// Lê a quantidade k e, em seguida, k inteiros; o vetor tem pelo menos uma posição e deve ser liberado por quem chamou
+static int *ler_vetor(ENTRADA *entrada, int *k)
 {
-  Conjunto *A, *B;
-  int n_a, n_b, x;
-  int op;
-  int tipo;
+  *k = 0;
+  entrada_inteiro(entrada, k);
+  int *vetor = (int *)malloc((*k > 0 ? *k : 1) * sizeof(int));
+  if (!vetor)
+  {
+    printf("Erro: falha ao alocar memória.\n");
+    exit(EXIT_FAILURE);
+  }
+  *k = entrada_inteiros(entrada, vetor, *k);
+  return vetor;
+}
+
+// Vetor com os elementos do conjunto em ordem crescente (com pelo menos uma posição); a quantidade vai para "n"
+static int *elementos_ordenados(Conjunto *conjunto, int *n)
+{
+  int tamanho = tamanho_conjunto(conjunto);
+  int *ordenado = (int *)malloc((tamanho > 0 ? tamanho : 1) * sizeof(int));
+  if (!ordenado)
+  {
+    printf("Erro: falha ao alocar memória.\n");
+    exit(EXIT_FAILURE);
+  }
+  *n = exportar_conjunto(conjunto, ordenado);
+  return ordenado;
+}
+
+// Contadores em uma linha: comparações, rotações, alocações, liberações, deslocamentos e realocações
+static void imprimir_estatisticas(ESTATISTICAS estatisticas)
+{
+  printf("%llu %llu %llu %llu %llu %llu\n", estatisticas.comparacoes, estatisticas.rotacoes, estatisticas.alocacoes,
+         estatisticas.liberacoes, estatisticas.deslocamentos, estatisticas.realocacoes);
+}
+
+// Quantidade de amostras de latência de cada operação medida, em uma linha (faixa < 0: todas as faixas de tamanho)
+static void imprimir_amostras(int faixa)
+{
+  for (int operacao = 0; operacao < QUANTIDADE_OPERACOES_LATENCIA; operacao++)
+  {
+    printf("%llu ", latencia_resumo(operacao, faixa).amostras);
+  }
+  printf("\n");
+}
+
+// Contadores do alocador de nós em uma linha: slabs, capacidade, nós em uso e livres
+static void imprimir_ocupacao(OCUPACAO ocupacao)
+{
+  printf("%d %d %d %d\n", ocupacao.slabs, ocupacao.capacidade, ocupacao.em_uso, ocupacao.livres);
+}
+
+// Elementos que restam no iterador, entre chaves
+static void imprimir_restantes(ITERADOR *iterador)
+{
+  int elemento = 0;
+  printf("{");
+  while (iterador_proximo(iterador, &elemento))
+  {
+    printf("%d ", elemento);
+  }
+  printf("}\n");
+}
 
-  scanf("%d", &tipo); // 0 -> ED1, 1 -> ED2
+// Resposta de pertence_conjunto para cada chave, uma por vez (sem o caminho em lote)
+static void imprimir_pertencimento(const char *rotulo, Conjunto *conjunto, const int *chaves, int k)
+{
+  printf("%s: ", rotulo);
+  for (int i = 0; i < k; i++)
+  {
+    printf("%d", pertence_conjunto(conjunto, chaves[i]));
+  }
+  printf("\n");
+}
 
-  scanf(" %d %d", &n_a, &n_b);
+// Cópia do conjunto na estrutura "tipo"
+static Conjunto *copiar_conjunto(Conjunto *conjunto, int tipo)
+{
+  int n = 0;
+  int *ordenado = elementos_ordenados(conjunto, &n);
+  Conjunto *copia = criar_conjunto_de_ordenado(tipo, ordenado, n);
+  free(ordenado);
+  return copia;
+}
 
-  A = criar_conjunto(tipo, n_a);
-  B = criar_conjunto(tipo, n_b);
+// Diferença a - b calculada elemento a elemento, na estrutura de a (para conferir a avaliação das expressões)
+static Conjunto *diferenca_direta(Conjunto *a, Conjunto *b, int tipo)
+{
+  int n = 0, k = 0;
+  int *ordenado = elementos_ordenados(a, &n);
+  for (int i = 0; i < n; i++)
+  {
+    if (!pertence_conjunto(b, ordenado[i]))
+    {
+      ordenado[k++] = ordenado[i];
+    }
+  }
+  Conjunto *diferenca = criar_conjunto_de_ordenado(tipo, ordenado, k);
+  free(ordenado);
+  return diferenca;
+}
 
-  for (int i = 0; i < n_a; i++)
+static bool conjuntos_iguais(Conjunto *a, Conjunto *b)
+{
+  int na = 0, nb = 0;
+  int *va = elementos_ordenados(a, &na);
+  int *vb = elementos_ordenados(b, &nb);
+  bool iguais = na == nb;
+  for (int i = 0; iguais && i < na; i++)
   {
-    scanf("%d", &x);
-    inserir_elemento(A, x);
+    iguais = va[i] == vb[i];
   }
+  free(va);
+  free(vb);
+  return iguais;
+}
+
+int main(int argc, char *argv[])
+{
+  Conjunto *A, *B;
+  int n_a = 0, n_b = 0;
+  int op = 0;
+  int tipo = 0;
 
-  for (int i = 0; i < n_b; i++)
+  // a entrada inteira é lida de uma vez (mmap quando é um arquivo) e os números são convertidos sem scanf
+  ENTRADA *entrada = entrada_abrir(0);
+  if (!entrada)
   {
-    scanf("%d", &x);  
-    inserir_elemento(B, x);
+    printf("Erro: falha ao ler a entrada.\n");
+    return EXIT_FAILURE;
   }
 
+  entrada_inteiro(entrada, &tipo); // 0 -> ED1, 1 -> ED2, 2 -> ED3, 3 -> ED4, 4 -> ED5, 5 -> ED6, 6 -> automático, 7 -> ED7
+
+  entrada_inteiro(entrada, &n_a);
+  entrada_inteiro(entrada, &n_b);
+
+  // os elementos são lidos para um vetor e o conjunto é montado em lote
+  int *elementos = (int *)malloc(((n_a > n_b ? n_a : n_b) + 1) * sizeof(int));
+
+  n_a = entrada_inteiros(entrada, elementos, n_a);
+  A = criar_conjunto_de_vetor(tipo, elementos, n_a);
+
+  n_b = entrada_inteiros(entrada, elementos, n_b);
+  B = criar_conjunto_de_vetor(tipo, elementos, n_b);
+  free(elementos);
+
   printf("\ninsercoes feitas!\n");
   imprimir_conjunto(A);
   printf("\n");
   imprimir_conjunto(B);
   printf("\n");
 
-  scanf("%d", &op);
+  entrada_inteiro(entrada, &op);
 
   switch (op)
   {
   case 1:
   {
     // pertence
-    int elemento_procurado;
-    scanf("%d", &elemento_procurado);
+    int elemento_procurado = 0;
+    entrada_inteiro(entrada, &elemento_procurado);
     
     if (pertence_conjunto(A, elemento_procurado))
     {
@@ -71,12 +198,547 @@ int main(int argc, char *argv[])
   case 4:
   {
     // remoção (considerando-se apenas do conjunto A)
-    int elemento_removido;
-    scanf(" %d", &elemento_removido);
+    int elemento_removido = 0;
+    entrada_inteiro(entrada, &elemento_removido);
     if(!remover_elemento(A, elemento_removido)) printf("elemento nao esta no conjunto\n");
     imprimir_conjunto(A);
+    break;
+  }
+  case 5:
+  {
+    // inserção e remoção em lote no conjunto A: k elementos a inserir e m a remover (em qualquer ordem, podendo repetir)
+    int k = 0, m = 0;
+    int *inseridos = ler_vetor(entrada, &k);
+    int *removidos = ler_vetor(entrada, &m);
+    printf("inseridos: %zu\n", inserir_elementos(A, inseridos, (size_t)k));
+    printf("removidos: %zu\n", remover_elementos(A, removidos, (size_t)m));
+    imprimir_conjunto(A);
+    free(inseridos);
+    free(removidos);
+    break;
+  }
+  case 6:
+  {
+    // sequência de inserções e remoções no conjunto A, um elemento por vez: k elementos a inserir e depois m a remover
+    int k = 0, m = 0, contagem = 0;
+    int *inseridos = ler_vetor(entrada, &k);
+    int *removidos = ler_vetor(entrada, &m);
+    for (int i = 0; i < k; i++)
+    {
+      contagem += inserir_elemento(A, inseridos[i]);
+    }
+    printf("inseridos: %d\n", contagem);
+    contagem = 0;
+    for (int i = 0; i < m; i++)
+    {
+      contagem += remover_elemento(A, removidos[i]);
+    }
+    printf("removidos: %d\n", contagem);
+    imprimir_conjunto(A);
+    free(inseridos);
+    free(removidos);
+    break;
+  }
+  case 7:
+  {
+    // pertencimento em lote em A: k chaves (em qualquer ordem, podendo repetir); imprime quantas pertencem e a resposta de cada uma
+    int k = 0;
+    int *chaves = ler_vetor(entrada, &k);
+    bool *respostas = (bool *)malloc((k > 0 ? k : 1) * sizeof(bool));
+    if (!respostas)
+    {
+      printf("Erro: falha ao alocar memória.\n");
+      exit(EXIT_FAILURE);
+    }
+    printf("pertencem: %zu\n", pertence_lote(A, chaves, (size_t)k, respostas));
+    for (int i = 0; i < k; i++)
+    {
+      printf("%d", respostas[i]);
+    }
+    printf("\n");
+    free(chaves);
+    free(respostas);
+    break;
+  }
+  case 8:
+  {
+    // o contrário da operação 6: remove m elementos de A e depois insere k, um elemento por vez
+    int k = 0, m = 0, contagem = 0;
+    int *removidos = ler_vetor(entrada, &m);
+    int *inseridos = ler_vetor(entrada, &k);
+    for (int i = 0; i < m; i++)
+    {
+      contagem += remover_elemento(A, removidos[i]);
+    }
+    printf("removidos: %d\n", contagem);
+    contagem = 0;
+    for (int i = 0; i < k; i++)
+    {
+      contagem += inserir_elemento(A, inseridos[i]);
+    }
+    printf("inseridos: %d\n", contagem);
+    imprimir_conjunto(A);
+    free(removidos);
+    free(inseridos);
+    break;
+  }
+  case 9:
+  {
+    // expressão sobre A e B (B passado para a estrutura tipo_b), em notação pós-fixa:
+    // 1: A, 2: B, 3: união, 4: intersecção, 5: diferença, 6: repete o topo da pilha (subexpressão compartilhada)
+    // o resultado da expressão (avaliada com e sem reordenação) é conferido com o das operações feitas uma a uma
+    int tipo_b = 0, k = 0, topo = 0;
+    bool valida = true;
+    entrada_inteiro(entrada, &tipo_b);
+    int *programa = ler_vetor(entrada, &k);
+    Conjunto *copia = copiar_conjunto(B, tipo_b);
+    apagar_conjunto(B);
+    B = copia;
+
+    EXPRESSAO **pilha = (EXPRESSAO **)malloc((k > 0 ? k : 1) * sizeof(EXPRESSAO *));
+    Conjunto **diretos = (Conjunto **)malloc((k > 0 ? k : 1) * sizeof(Conjunto *));
+    if (!pilha || !diretos)
+    {
+      printf("Erro: falha ao alocar memória.\n");
+      exit(EXIT_FAILURE);
+    }
+    for (int i = 0; i < k && valida; i++)
+    {
+      int codigo = programa[i];
+      if (codigo == 1 || codigo == 2)
+      {
+        Conjunto *folha = codigo == 1 ? A : B;
+        pilha[topo] = expressao_conjunto(folha);
+        diretos[topo++] = copiar_conjunto(folha, codigo == 1 ? tipo : tipo_b);
+      }
+      else if (codigo >= 3 && codigo <= 5 && topo >= 2)
+      {
+        topo -= 2;
+        Conjunto *x = diretos[topo], *y = diretos[topo + 1];
+        if (codigo == 3)
+        {
+          pilha[topo] = expressao_uniao(pilha[topo], pilha[topo + 1]);
+          diretos[topo] = uniao_conjuntos(x, y);
+        }
+        else if (codigo == 4)
+        {
+          pilha[topo] = expressao_intersecao(pilha[topo], pilha[topo + 1]);
+          diretos[topo] = intersecao_conjuntos(x, y);
+        }
+        else
+        {
+          pilha[topo] = expressao_diferenca(pilha[topo], pilha[topo + 1]);
+          diretos[topo] = diferenca_direta(x, y, tipo);
+        }
+        apagar_conjunto(x);
+        apagar_conjunto(y);
+        topo++;
+      }
+      else if (codigo == 6 && topo >= 1)
+      {
+        pilha[topo] = expressao_compartilhar(pilha[topo - 1]);
+        diretos[topo] = copiar_conjunto(diretos[topo - 1], tipo);
+        topo++;
+      }
+      else
+      {
+        valida = false;
+      }
+    }
+    if (valida && topo == 1)
+    {
+      Conjunto *reordenado = expressao_avaliar(pilha[0], tipo, true);
+      Conjunto *em_ordem = expressao_avaliar(pilha[0], tipo, false);
+      imprimir_conjunto(reordenado);
+      printf(conjuntos_iguais(reordenado, diretos[0]) && conjuntos_iguais(em_ordem, diretos[0]) ? "confere\n" : "nao confere\n");
+      apagar_conjunto(reordenado);
+      apagar_conjunto(em_ordem);
+    }
+    else
+    {
+      printf("expressao invalida\n");
+    }
+    while (topo > 0)
+    {
+      topo--;
+      expressao_apagar(&pilha[topo]);
+      apagar_conjunto(diretos[topo]);
+    }
+    free(pilha);
+    free(diretos);
+    free(programa);
+    break;
+  }
+  case 10:
+  {
+    // persistência: A é gravado em um arquivo temporário no formato dado (0: comprimido, 1: vetor), que pode ser estragado antes
+    // da carga (modo 1: truncado em "posicao" bytes; modo 2: o byte "valor" é escrito em "posicao"; posições negativas contam do fim).
+    // O arquivo é carregado na estrutura tipo_carga (negativo: a gravada no arquivo) e o conjunto carregado recebe os elementos do vetor
+    int formato = 0, modo = 0, posicao = 0, valor = 0, tipo_carga = -1, k = 0;
+    entrada_inteiro(entrada, &formato);
+    entrada_inteiro(entrada, &modo);
+    entrada_inteiro(entrada, &posicao);
+    entrada_inteiro(entrada, &valor);
+    entrada_inteiro(entrada, &tipo_carga);
+    int *inseridos = ler_vetor(entrada, &k);
+
+    char caminho[] = "/tmp/conjuntoXXXXXX";
+    int fd = mkstemp(caminho);
+    if (fd < 0 || !salvar_conjunto(A, caminho, formato))
+    {
+      printf("Erro: falha ao gravar o arquivo.\n");
+      exit(EXIT_FAILURE);
+    }
+    off_t tamanho = lseek(fd, 0, SEEK_END);
+    off_t onde = posicao < 0 ? tamanho + posicao : posicao;
+    unsigned char byte = (unsigned char)valor;
+    if ((modo == 1 && ftruncate(fd, onde) != 0) || (modo == 2 && pwrite(fd, &byte, 1, onde) != 1))
+    {
+      printf("Erro: falha ao alterar o arquivo.\n");
+      exit(EXIT_FAILURE);
+    }
+    close(fd);
+    Conjunto *carregado = carregar_conjunto(caminho, tipo_carga);
+    unlink(caminho);
+
+    if (!carregado)
+    {
+      printf("arquivo invalido\n");
+    }
+    else
+    {
+      int contagem = 0;
+      printf("estrutura: %d\n", estrutura_conjunto(carregado));
+      imprimir_conjunto(carregado);
+      for (int i = 0; i < k; i++)
+      {
+        contagem += inserir_elemento(carregado, inseridos[i]);
+      }
+      printf("inseridos: %d\n", contagem);
+      imprimir_conjunto(carregado);
+      apagar_conjunto(carregado);
+    }
+    free(inseridos);
+    break;
+  }
+  case 11:
+  {
+    // contadores de operações: zera os de A e B, insere k elementos em A e remove m, um por vez, imprimindo os contadores de A
+    // depois de zerar, das inserções e das remoções; depois os de B (que não foi usado) e os de A zerados de novo
+    int k = 0, m = 0;
+    int *inseridos = ler_vetor(entrada, &k);
+    int *removidos = ler_vetor(entrada, &m);
+    zerar_estatisticas(A);
+    zerar_estatisticas(B);
+    imprimir_estatisticas(obter_estatisticas(A));
+    for (int i = 0; i < k; i++)
+    {
+      inserir_elemento(A, inseridos[i]);
+    }
+    imprimir_estatisticas(obter_estatisticas(A));
+    for (int i = 0; i < m; i++)
+    {
+      remover_elemento(A, removidos[i]);
+    }
+    imprimir_estatisticas(obter_estatisticas(A));
+    imprimir_estatisticas(obter_estatisticas(B));
+    zerar_estatisticas(A);
+    imprimir_estatisticas(obter_estatisticas(A));
+    free(inseridos);
+    free(removidos);
+    break;
+  }
+  case 12:
+  {
+    // latência: medindo todas as operações, insere o primeiro vetor em A, remove o segundo e procura as chaves do terceiro, um por
+    // vez, e faz a união e a intersecção de A e B; imprime as amostras de cada operação no total e nas faixas de tamanho 0 a 2, se
+    // os percentis estão em ordem, as amostras depois de operações com a medição desligada e depois de latencia_zerar
+    int k = 0, m = 0, q = 0;
+    int *inseridos = ler_vetor(entrada, &k);
+    int *removidos = ler_vetor(entrada, &m);
+    int *chaves = ler_vetor(entrada, &q);
+    latencia_zerar();
+    latencia_amostragem(1);
+    for (int i = 0; i < k; i++)
+    {
+      inserir_elemento(A, inseridos[i]);
+    }
+    for (int i = 0; i < m; i++)
+    {
+      remover_elemento(A, removidos[i]);
+    }
+    for (int i = 0; i < q; i++)
+    {
+      pertence_conjunto(A, chaves[i]);
+    }
+    Conjunto *uniao = uniao_conjuntos(A, B);
+    Conjunto *intersecao = intersecao_conjuntos(A, B);
+    imprimir_amostras(-1);
+    for (int faixa = 0; faixa < 3; faixa++)
+    {
+      imprimir_amostras(faixa);
+    }
+    bool em_ordem = true;
+    for (int operacao = 0; operacao < QUANTIDADE_OPERACOES_LATENCIA; operacao++)
+    {
+      RESUMO_LATENCIA resumo = latencia_resumo(operacao, -1);
+      if (resumo.amostras && !(resumo.p50 <= resumo.p99 && resumo.p99 <= resumo.p999 && resumo.media <= resumo.maximo))
+        em_ordem = false;
+    }
+    printf(em_ordem ? "percentis em ordem\n" : "percentis fora de ordem\n");
+    latencia_amostragem(0);
+    inserir_elemento(A, 0);
+    pertence_conjunto(A, 0);
+    imprimir_amostras(-1);
+    latencia_zerar();
+    imprimir_amostras(-1);
+    apagar_conjunto(uniao);
+    apagar_conjunto(intersecao);
+    free(inseridos);
+    free(removidos);
+    free(chaves);
+    break;
+  }
+  case 13:
+  {
+    // iterador: percorre A inteiro; depois, em um novo iterador, busca cada chave do vetor com iterador_buscar_a_partir_de
+    // (imprimindo o elemento encontrado ou "fim") e percorre o que sobrou
+    int q = 0, elemento = 0;
+    int *chaves = ler_vetor(entrada, &q);
+    ITERADOR *iterador = iterador_criar(A);
+    imprimir_restantes(iterador);
+    iterador_apagar(&iterador);
+    iterador = iterador_criar(A);
+    for (int i = 0; i < q; i++)
+    {
+      if (iterador_buscar_a_partir_de(iterador, chaves[i], &elemento))
+        printf("%d ", elemento);
+      else
+        printf("fim ");
+    }
+    printf("\n");
+    imprimir_restantes(iterador);
+    iterador_apagar(&iterador);
+    free(chaves);
+    break;
+  }
+  case 14:
+  {
+    // união e intersecção com B passado para a estrutura tipo_b; imprime a estrutura e os elementos de cada resultado
+    int tipo_b = 0;
+    entrada_inteiro(entrada, &tipo_b);
+    Conjunto *copia = copiar_conjunto(B, tipo_b);
+    apagar_conjunto(B);
+    B = copia;
+    Conjunto *uniao = uniao_conjuntos(A, B);
+    Conjunto *intersecao = intersecao_conjuntos(A, B);
+    printf("estrutura: %d\n", estrutura_conjunto(uniao));
+    imprimir_conjunto(uniao);
+    printf("estrutura: %d\n", estrutura_conjunto(intersecao));
+    imprimir_conjunto(intersecao);
+    apagar_conjunto(uniao);
+    apagar_conjunto(intersecao);
+    break;
+  }
+  case 15:
+  {
+    // remoção preguiçosa: com ela ligada, remove o primeiro vetor de A e insere o segundo, um elemento por vez; depois de cada fase
+    // imprime a contagem, A e se o vetor de A está contíguo (elementos_conjunto só o devolve sem lápides, e imprimir não compacta);
+    // por fim desliga a remoção preguiçosa, o que compacta
+    int k = 0, m = 0, removidos = 0, inseridos = 0;
+    int *remover = ler_vetor(entrada, &k);
+    int *inserir = ler_vetor(entrada, &m);
+    remocao_preguicosa_conjunto(A, true);
+    for (int i = 0; i < k; i++)
+    {
+      removidos += remover_elemento(A, remover[i]);
+    }
+    printf("removidos: %d\n", removidos);
+    imprimir_conjunto(A);
+    printf(elementos_conjunto(A) ? "contiguo\n" : "com lapides\n");
+    for (int i = 0; i < m; i++)
+    {
+      inseridos += inserir_elemento(A, inserir[i]);
+    }
+    printf("inseridos: %d\n", inseridos);
+    imprimir_conjunto(A);
+    printf(elementos_conjunto(A) ? "contiguo\n" : "com lapides\n");
+    remocao_preguicosa_conjunto(A, false);
+    printf(elementos_conjunto(A) ? "contiguo\n" : "com lapides\n");
+    free(remover);
+    free(inserir);
+    break;
+  }
+  case 16:
+  {
+    // alocador de nós da AVL: remove o primeiro vetor de A e insere o segundo, um elemento por vez, imprimindo a ocupação
+    // (ocupacao_conjunto) antes, depois das remoções e depois das inserções, e A no fim
+    int k = 0, m = 0;
+    int *remover = ler_vetor(entrada, &k);
+    int *inserir = ler_vetor(entrada, &m);
+    imprimir_ocupacao(ocupacao_conjunto(A));
+    for (int i = 0; i < k; i++)
+    {
+      remover_elemento(A, remover[i]);
+    }
+    imprimir_ocupacao(ocupacao_conjunto(A));
+    for (int i = 0; i < m; i++)
+    {
+      inserir_elemento(A, inserir[i]);
+    }
+    imprimir_ocupacao(ocupacao_conjunto(A));
+    imprimir_conjunto(A);
+    free(remover);
+    free(inserir);
+    break;
+  }
+  case 17:
+  {
+    // capacidade da lista: define o fator de crescimento (em centésimos: 150 -> 1,5) e reserva espaço; insere o vetor em A, um
+    // elemento por vez, imprimindo cada capacidade nova, e reduz a capacidade ao tamanho no fim
+    int centesimos = 0, reserva = 0, k = 0;
+    entrada_inteiro(entrada, &centesimos);
+    entrada_inteiro(entrada, &reserva);
+    int *inserir = ler_vetor(entrada, &k);
+    printf("capacidade: %d\n", capacidade_conjunto(A));
+    printf(fator_crescimento_conjunto(A, centesimos / 100.0f) ? "fator aceito\n" : "fator recusado\n");
+    bool reservado = reservar_conjunto(A, reserva);
+    int capacidade = capacidade_conjunto(A);
+    printf(reservado ? "reservado: %d\n" : "nao reservado: %d\n", capacidade);
+    printf("capacidades:");
+    for (int i = 0; i < k; i++)
+    {
+      inserir_elemento(A, inserir[i]);
+      if (capacidade_conjunto(A) != capacidade)
+      {
+        capacidade = capacidade_conjunto(A);
+        printf(" %d", capacidade);
+      }
+    }
+    printf("\n");
+    bool ajustado = ajustar_capacidade_conjunto(A);
+    printf(ajustado ? "ajustado: %d\n" : "nao ajustado: %d\n", capacidade_conjunto(A));
+    imprimir_conjunto(A);
+    free(inserir);
+    break;
+  }
+  case 18:
+  {
+    // fator de carga da tabela hash: define o fator (em centésimos: 50 -> 0,5), imprimindo a capacidade antes e depois, e insere
+    // o vetor em A um elemento por vez, imprimindo cada capacidade nova
+    int centesimos = 0, k = 0;
+    entrada_inteiro(entrada, &centesimos);
+    int *inserir = ler_vetor(entrada, &k);
+    printf("capacidade: %d\n", capacidade_conjunto(A));
+    bool aceito = fator_carga_conjunto(A, centesimos / 100.0f);
+    int capacidade = capacidade_conjunto(A);
+    printf(aceito ? "fator aceito: %d\n" : "fator recusado: %d\n", capacidade);
+    printf("capacidades:");
+    for (int i = 0; i < k; i++)
+    {
+      inserir_elemento(A, inserir[i]);
+      if (capacidade_conjunto(A) != capacidade)
+      {
+        capacidade = capacidade_conjunto(A);
+        printf(" %d", capacidade);
+      }
+    }
+    printf("\n");
+    imprimir_conjunto(A);
+    free(inserir);
+    break;
+  }
+  case 19:
+  {
+    // layout de leitura: ativa (1) ou desativa (0) o layout de Eytzinger de A e consulta as chaves; depois insere o segundo vetor
+    // um elemento por vez, remove o terceiro em lote, devolve o terceiro em lote e remove o segundo um elemento por vez,
+    // consultando as chaves depois de cada passo (cada alteração invalida a cópia)
+    int ativar = 0, k = 0, m = 0, r = 0;
+    entrada_inteiro(entrada, &ativar);
+    int *chaves = ler_vetor(entrada, &k);
+    int *inserir = ler_vetor(entrada, &m);
+    int *remover = ler_vetor(entrada, &r);
+    printf(otimizar_busca_conjunto(A, ativar != 0) ? "layout aceito\n" : "layout recusado\n");
+    imprimir_pertencimento("antes", A, chaves, k);
+    for (int i = 0; i < m; i++)
+    {
+      inserir_elemento(A, inserir[i]);
+    }
+    imprimir_pertencimento("inseridos", A, chaves, k);
+    printf("removidos: %zu\n", remover_elementos(A, remover, (size_t)r));
+    imprimir_pertencimento("removidos", A, chaves, k);
+    printf("devolvidos: %zu\n", inserir_elementos(A, remover, (size_t)r));
+    imprimir_pertencimento("devolvidos", A, chaves, k);
+    for (int i = 0; i < m; i++)
+    {
+      remover_elemento(A, inserir[i]);
+    }
+    imprimir_pertencimento("retirados", A, chaves, k);
+    imprimir_conjunto(A);
+    free(chaves);
+    free(inserir);
+    free(remover);
+    break;
+  }
+  case 20:
+  {
+    // união e intersecção de A e B com opções (threads e corte sequencial da AVL); imprime os tamanhos e os dois resultados
+    OpcoesConjunto opcoes = {1, 0};
+    entrada_inteiro(entrada, &opcoes.threads);
+    entrada_inteiro(entrada, &opcoes.corte_sequencial);
+    Conjunto *uniao = uniao_conjuntos_opcoes(A, B, &opcoes);
+    Conjunto *intersecao = intersecao_conjuntos_opcoes(A, B, &opcoes);
+    printf("tamanhos: %d %d\n", tamanho_conjunto(uniao), tamanho_conjunto(intersecao));
+    imprimir_conjunto(uniao);
+    imprimir_conjunto(intersecao);
+    apagar_conjunto(uniao);
+    apagar_conjunto(intersecao);
+    break;
+  }
+  case 21:
+  {
+    // fases de uso de A (para ver o tipo automático trocar de estrutura): quantidade de fases e, para cada uma, a ação (0 insere,
+    // 1 remove, 2 consulta), o tamanho dos lotes (0 -> um elemento por vez) e o vetor; imprime a estrutura e o tamanho depois de cada fase
+    int fases = 0;
+    entrada_inteiro(entrada, &fases);
+    for (int f = 0; f < fases; f++)
+    {
+      int acao = 0, lote = 0, k = 0;
+      entrada_inteiro(entrada, &acao);
+      entrada_inteiro(entrada, &lote);
+      int *vetor = ler_vetor(entrada, &k);
+      bool *respostas = (bool *)malloc((k > 0 ? k : 1) * sizeof(bool));
+      if (!respostas)
+      {
+        printf("Erro: falha ao alocar memória.\n");
+        exit(EXIT_FAILURE);
+      }
+      int passo = lote > 0 ? lote : 1;
+      for (int i = 0; i < k; i += passo)
+      {
+        size_t quantidade = (size_t)(k - i < passo ? k - i : passo);
+        if (acao == 0 && lote > 0)
+          inserir_elementos(A, vetor + i, quantidade);
+        else if (acao == 0)
+          inserir_elemento(A, vetor[i]);
+        else if (acao == 1 && lote > 0)
+          remover_elementos(A, vetor + i, quantidade);
+        else if (acao == 1)
+          remover_elemento(A, vetor[i]);
+        else if (lote > 0)
+          pertence_lote(A, vetor + i, quantidade, respostas);
+        else
+          pertence_conjunto(A, vetor[i]);
+      }
+      printf("estrutura: %d tamanho: %d\n", estrutura_conjunto(A), tamanho_conjunto(A));
+      free(vetor);
+      free(respostas);
+    }
+    imprimir_conjunto(A);
+    break;
   }
   }
+  entrada_fechar(&entrada);
   apagar_conjunto(A);
   apagar_conjunto(B);
   return 0;
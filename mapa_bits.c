@@ -0,0 +1,1076 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include "mapa_bits.h"
+
+/*
+Mapa de bits comprimido (no estilo "roaring")
+Cada chave de 32 bits é dividida em duas metades: os 16 bits altos escolhem um container e os 16 bits baixos são guardados nele.
+Antes da divisão, o bit de sinal é invertido, para que a ordem dos containers e das chaves siga a ordem dos inteiros com sinal.
+Cada container usa a representação mais compacta para o seu conteúdo:
+    - vetor (array): chaves baixas ordenadas, 2 bytes por chave, até LIMITE_ARRAY chaves
+    - mapa de bits (bitmap): 2^16 bits (8KB fixos), usado quando há mais de LIMITE_ARRAY chaves
+    - sequências (run): pares (início, comprimento - 1), ótimo para intervalos contínuos; gerado por mapa_bits_otimizar
+*/
+typedef struct container_
+{
+    uint16_t alta;     // 16 bits altos comuns a todas as chaves do container
+    int tipo;          // CONTAINER_ARRAY, CONTAINER_BITMAP ou CONTAINER_RUN
+    int cardinalidade; // quantidade de chaves no container
+    int capacidade;    // espaço alocado (em chaves para o vetor, em sequências para o run)
+    int sequencias;    // quantidade de sequências (apenas run)
+    uint16_t *array;   // vetor ordenado (array) ou pares início/comprimento (run)
+    uint64_t *bitmap;  // palavras do mapa de bits (bitmap)
+} CONTAINER;
+
+/*
+Struct Mapa de Bits: vetor de containers ordenado pelos 16 bits altos, com a cardinalidade total do conjunto
+*/
+struct MapaBits
+{
+    CONTAINER *containers;
+    int quantidade;
+    int capacidade;
+    int cardinalidade;
+};
+
+#if defined(__GNUC__)
+#define CONTAR_BITS(palavra) __builtin_popcountll(palavra)
+#define ZEROS_A_DIREITA(palavra) __builtin_ctzll(palavra)
+#else
+static int CONTAR_BITS(uint64_t palavra)
+{
+    int n = 0;
+    for (; palavra; palavra &= palavra - 1)
+        n++;
+    return n;
+}
+static int ZEROS_A_DIREITA(uint64_t palavra)
+{
+    int n = 0;
+    while (!(palavra & 1))
+    {
+        palavra >>= 1;
+        n++;
+    }
+    return n;
+}
+#endif
+
+/////// CHAVES ///////
+/*
+    Divisão e montagem das chaves
+    Ideia: inverter o bit de sinal faz a ordem sem sinal coincidir com a ordem com sinal
+*/
+static uint16_t chave_alta(int chave)
+{
+    return (uint16_t)(((uint32_t)chave ^ 0x80000000u) >> 16);
+}
+
+static uint16_t chave_baixa(int chave)
+{
+    return (uint16_t)((uint32_t)chave & 0xFFFFu);
+}
+
+static int montar_chave(uint16_t alta, uint16_t baixa)
+{
+    return (int)((((uint32_t)alta << 16) | baixa) ^ 0x80000000u);
+}
+
+/////// CONTAINERS ///////
+/*
+    Busca no vetor do container
+    Parâmetros: vetor ordenado, seu tamanho e a chave baixa
+    Ideia: busca binária; retorna a posição da chave ou, se não existir, -(posição de inserção + 1)
+*/
+static int busca_array(const uint16_t *array, int n, uint16_t baixa)
+{
+    int inf = 0, sup = n - 1;
+    while (inf <= sup)
+    {
+        int meio = (inf + sup) / 2;
+        if (array[meio] == baixa)
+        {
+            return meio;
+        }
+        else if (array[meio] > baixa)
+        {
+            sup = meio - 1;
+        }
+        else
+        {
+            inf = meio + 1;
+        }
+    }
+    return -(inf + 1);
+}
+
+/*
+    Liberar container
+    Parâmetro: container
+    Ideia: libera os vetores do container (a struct mora no vetor de containers do mapa)
+*/
+static void container_liberar(CONTAINER *c)
+{
+    free(c->array);
+    free(c->bitmap);
+    c->array = NULL;
+    c->bitmap = NULL;
+}
+
+/*
+    Containers vazios
+    Parâmetros: container e a chave alta
+    Ideia: inicializam um container do tipo pedido, sem elementos
+*/
+static bool container_iniciar_array(CONTAINER *c, uint16_t alta, int capacidade)
+{
+    c->alta = alta;
+    c->tipo = CONTAINER_ARRAY;
+    c->cardinalidade = 0;
+    c->sequencias = 0;
+    c->capacidade = capacidade > 0 ? capacidade : 1;
+    c->bitmap = NULL;
+    c->array = (uint16_t *)malloc(c->capacidade * sizeof(uint16_t));
+    return c->array != NULL;
+}
+
+static bool container_iniciar_bitmap(CONTAINER *c, uint16_t alta)
+{
+    c->alta = alta;
+    c->tipo = CONTAINER_BITMAP;
+    c->cardinalidade = 0;
+    c->sequencias = 0;
+    c->capacidade = 0;
+    c->array = NULL;
+    c->bitmap = (uint64_t *)calloc(PALAVRAS_BITMAP, sizeof(uint64_t));
+    return c->bitmap != NULL;
+}
+
+/*
+    Conversões entre representações
+    Ideia: o vetor vira mapa de bits ligando um bit por chave; o mapa de bits vira vetor percorrendo os bits ligados de cada palavra;
+    um run vira vetor ou mapa de bits (conforme a cardinalidade) expandindo cada sequência
+*/
+static bool container_para_bitmap(CONTAINER *c)
+{
+    CONTAINER novo;
+    if (!container_iniciar_bitmap(&novo, c->alta))
+    {
+        return false;
+    }
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        for (int i = 0; i < c->cardinalidade; i++)
+        {
+            novo.bitmap[c->array[i] >> 6] |= (uint64_t)1 << (c->array[i] & 63);
+        }
+    }
+    else if (c->tipo == CONTAINER_RUN)
+    {
+        for (int s = 0; s < c->sequencias; s++)
+        {
+            int inicio = c->array[2 * s], fim = inicio + c->array[2 * s + 1];
+            for (int v = inicio; v <= fim; v++)
+            {
+                novo.bitmap[v >> 6] |= (uint64_t)1 << (v & 63);
+            }
+        }
+    }
+    else
+    {
+        free(novo.bitmap);
+        return true;
+    }
+    novo.cardinalidade = c->cardinalidade;
+    container_liberar(c);
+    *c = novo;
+    return true;
+}
+
+static bool container_para_array(CONTAINER *c)
+{
+    CONTAINER novo;
+    if (!container_iniciar_array(&novo, c->alta, c->cardinalidade))
+    {
+        return false;
+    }
+    if (c->tipo == CONTAINER_BITMAP)
+    {
+        for (int w = 0; w < PALAVRAS_BITMAP; w++)
+        {
+            for (uint64_t palavra = c->bitmap[w]; palavra; palavra &= palavra - 1)
+            {
+                novo.array[novo.cardinalidade++] = (uint16_t)(w * 64 + ZEROS_A_DIREITA(palavra));
+            }
+        }
+    }
+    else if (c->tipo == CONTAINER_RUN)
+    {
+        for (int s = 0; s < c->sequencias; s++)
+        {
+            int inicio = c->array[2 * s], fim = inicio + c->array[2 * s + 1];
+            for (int v = inicio; v <= fim; v++)
+            {
+                novo.array[novo.cardinalidade++] = (uint16_t)v;
+            }
+        }
+    }
+    else
+    {
+        free(novo.array);
+        return true;
+    }
+    container_liberar(c);
+    *c = novo;
+    return true;
+}
+
+// Um run é convertido para a representação que comporta sua cardinalidade antes de ser alterado
+static bool container_descompactar(CONTAINER *c)
+{
+    if (c->tipo != CONTAINER_RUN)
+    {
+        return true;
+    }
+    return c->cardinalidade > LIMITE_ARRAY ? container_para_bitmap(c) : container_para_array(c);
+}
+
+/*
+    Otimização para sequências
+    Parâmetro: container
+    Ideia: conta quantas sequências de chaves consecutivas o container tem; se guardar os pares (início, comprimento)
+    ocupar menos bytes que a representação atual, o container vira run
+*/
+static int container_contar_sequencias(CONTAINER *c)
+{
+    int sequencias = 0;
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        for (int i = 0; i < c->cardinalidade; i++)
+        {
+            if (i == 0 || c->array[i] != c->array[i - 1] + 1)
+            {
+                sequencias++;
+            }
+        }
+    }
+    else if (c->tipo == CONTAINER_BITMAP)
+    {
+        // uma sequência começa em cada bit ligado cujo bit anterior está desligado
+        uint64_t anterior = 0;
+        for (int w = 0; w < PALAVRAS_BITMAP; w++)
+        {
+            uint64_t palavra = c->bitmap[w];
+            uint64_t deslocada = (palavra << 1) | (anterior >> 63);
+            sequencias += CONTAR_BITS(palavra & ~deslocada);
+            anterior = palavra;
+        }
+    }
+    else
+    {
+        sequencias = c->sequencias;
+    }
+    return sequencias;
+}
+
+static int container_memoria(CONTAINER *c)
+{
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        return c->cardinalidade * (int)sizeof(uint16_t);
+    }
+    if (c->tipo == CONTAINER_BITMAP)
+    {
+        return PALAVRAS_BITMAP * (int)sizeof(uint64_t);
+    }
+    return c->sequencias * 2 * (int)sizeof(uint16_t);
+}
+
+// Uma chave consecutiva à anterior estende a sequência atual; as demais abrem uma nova sequência
+static void estender_sequencias(uint16_t *pares, int *s, int *ultimo, int v)
+{
+    if (v == *ultimo + 1)
+    {
+        pares[2 * (*s) + 1]++;
+    }
+    else
+    {
+        (*s)++;
+        pares[2 * (*s)] = (uint16_t)v;
+        pares[2 * (*s) + 1] = 0;
+    }
+    *ultimo = v;
+}
+
+static void container_otimizar(CONTAINER *c)
+{
+    if (c->tipo == CONTAINER_RUN)
+    {
+        return;
+    }
+    int sequencias = container_contar_sequencias(c);
+    if (sequencias * 2 * (int)sizeof(uint16_t) >= container_memoria(c))
+    {
+        return;
+    }
+    uint16_t *pares = (uint16_t *)malloc(sequencias * 2 * sizeof(uint16_t));
+    if (pares == NULL)
+    {
+        return;
+    }
+    int s = -1, ultimo = -2;
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        for (int i = 0; i < c->cardinalidade; i++)
+        {
+            estender_sequencias(pares, &s, &ultimo, c->array[i]);
+        }
+    }
+    else
+    {
+        for (int w = 0; w < PALAVRAS_BITMAP; w++)
+        {
+            for (uint64_t palavra = c->bitmap[w]; palavra; palavra &= palavra - 1)
+            {
+                estender_sequencias(pares, &s, &ultimo, w * 64 + ZEROS_A_DIREITA(palavra));
+            }
+        }
+    }
+    container_liberar(c);
+    c->tipo = CONTAINER_RUN;
+    c->array = pares;
+    c->sequencias = sequencias;
+    c->capacidade = sequencias;
+}
+
+/*
+    Pertence ao container
+    Ideia: busca binária no vetor, teste de um bit no mapa de bits, ou busca binária pela última sequência que começa antes da chave no run
+*/
+static bool container_pertence(CONTAINER *c, uint16_t baixa)
+{
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        return busca_array(c->array, c->cardinalidade, baixa) >= 0;
+    }
+    if (c->tipo == CONTAINER_BITMAP)
+    {
+        return (c->bitmap[baixa >> 6] >> (baixa & 63)) & 1;
+    }
+    int inf = 0, sup = c->sequencias - 1, achada = -1;
+    while (inf <= sup)
+    {
+        int meio = (inf + sup) / 2;
+        if (c->array[2 * meio] <= baixa)
+        {
+            achada = meio;
+            inf = meio + 1;
+        }
+        else
+        {
+            sup = meio - 1;
+        }
+    }
+    return achada >= 0 && baixa <= c->array[2 * achada] + c->array[2 * achada + 1];
+}
+
+/*
+    Inserção no container
+    Ideia: no vetor, desloca as chaves maiores e insere (se o vetor já tem LIMITE_ARRAY chaves, vira mapa de bits antes);
+    no mapa de bits, liga o bit. Retorna false se a chave já existia ou faltou memória
+*/
+static bool container_inserir(CONTAINER *c, uint16_t baixa)
+{
+    if (!container_descompactar(c))
+    {
+        return false;
+    }
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        int pos = busca_array(c->array, c->cardinalidade, baixa);
+        if (pos >= 0)
+        {
+            return false;
+        }
+        pos = -pos - 1;
+        if (c->cardinalidade == LIMITE_ARRAY)
+        {
+            if (!container_para_bitmap(c))
+            {
+                return false;
+            }
+        }
+        else
+        {
+            if (c->cardinalidade == c->capacidade)
+            {
+                int nova = c->capacidade * 2 < LIMITE_ARRAY ? c->capacidade * 2 : LIMITE_ARRAY;
+                uint16_t *novo = (uint16_t *)realloc(c->array, nova * sizeof(uint16_t));
+                if (novo == NULL)
+                {
+                    return false;
+                }
+                c->array = novo;
+                c->capacidade = nova;
+            }
+            memmove(c->array + pos + 1, c->array + pos, (c->cardinalidade - pos) * sizeof(uint16_t));
+            c->array[pos] = baixa;
+            c->cardinalidade++;
+            return true;
+        }
+    }
+    uint64_t bit = (uint64_t)1 << (baixa & 63);
+    if (c->bitmap[baixa >> 6] & bit)
+    {
+        return false;
+    }
+    c->bitmap[baixa >> 6] |= bit;
+    c->cardinalidade++;
+    return true;
+}
+
+/*
+    Remoção do container
+    Ideia: no vetor, desloca as chaves maiores para a esquerda; no mapa de bits, desliga o bit
+    e, se sobrarem no máximo LIMITE_ARRAY chaves, o container volta a ser vetor
+*/
+static bool container_remover(CONTAINER *c, uint16_t baixa)
+{
+    if (!container_pertence(c, baixa) || !container_descompactar(c))
+    {
+        return false;
+    }
+    if (c->tipo == CONTAINER_ARRAY)
+    {
+        int pos = busca_array(c->array, c->cardinalidade, baixa);
+        memmove(c->array + pos, c->array + pos + 1, (c->cardinalidade - pos - 1) * sizeof(uint16_t));
+        c->cardinalidade--;
+        return true;
+    }
+    c->bitmap[baixa >> 6] &= ~((uint64_t)1 << (baixa & 63));
+    c->cardinalidade--;
+    if (c->cardinalidade <= LIMITE_ARRAY)
+    {
+        container_para_array(c);
+    }
+    return true;
+}
+
+/*
+    Cópia de container
+    Ideia: duplica os vetores do container; usada pela união para os containers que só existem em um dos mapas
+*/
+static bool container_copiar(CONTAINER *destino, CONTAINER *origem)
+{
+    *destino = *origem;
+    destino->array = NULL;
+    destino->bitmap = NULL;
+    if (origem->array != NULL)
+    {
+        // o vetor guarda uma chave por posição; o run, dois valores por sequência
+        int n = origem->tipo == CONTAINER_RUN ? 2 * origem->sequencias : origem->cardinalidade;
+        destino->capacidade = origem->tipo == CONTAINER_RUN ? origem->sequencias : (n > 0 ? n : 1);
+        destino->array = (uint16_t *)malloc((n > 0 ? n : 1) * sizeof(uint16_t));
+        if (destino->array == NULL)
+        {
+            return false;
+        }
+        memcpy(destino->array, origem->array, n * sizeof(uint16_t));
+    }
+    if (origem->bitmap != NULL)
+    {
+        destino->bitmap = (uint64_t *)malloc(PALAVRAS_BITMAP * sizeof(uint64_t));
+        if (destino->bitmap == NULL)
+        {
+            free(destino->array);
+            return false;
+        }
+        memcpy(destino->bitmap, origem->bitmap, PALAVRAS_BITMAP * sizeof(uint64_t));
+    }
+    return true;
+}
+
+/*
+    Versão descompactada de um container
+    Ideia: as operações de conjunto trabalham só com vetor e mapa de bits; um run é expandido em uma cópia temporária
+    (retornada em "temporario", que precisa ser liberado depois)
+*/
+static CONTAINER *container_operando(CONTAINER *c, CONTAINER *temporario)
+{
+    if (c->tipo != CONTAINER_RUN)
+    {
+        return c;
+    }
+    if (!container_copiar(temporario, c) || !container_descompactar(temporario))
+    {
+        return NULL;
+    }
+    return temporario;
+}
+
+/*
+    União de containers
+    Ideia:
+        - vetor com vetor: intercalação dos dois vetores ordenados, se o resultado couber em LIMITE_ARRAY; senão, liga os bits de ambos
+        - com mapa de bits: copia o mapa de bits e faz OU palavra a palavra (ou liga os bits do vetor), contando os bits com popcount
+*/
+static bool container_uniao(CONTAINER *resultado, CONTAINER *c1, CONTAINER *c2)
+{
+    CONTAINER t1, t2;
+    CONTAINER *a = container_operando(c1, &t1);
+    CONTAINER *b = container_operando(c2, &t2);
+    bool ok = (a != NULL && b != NULL);
+
+    if (ok && a->tipo == CONTAINER_ARRAY && b->tipo == CONTAINER_ARRAY && a->cardinalidade + b->cardinalidade <= LIMITE_ARRAY)
+    {
+        ok = container_iniciar_array(resultado, a->alta, a->cardinalidade + b->cardinalidade);
+        int i = 0, j = 0, k = 0;
+        while (ok && (i < a->cardinalidade || j < b->cardinalidade))
+        {
+            if (j >= b->cardinalidade || (i < a->cardinalidade && a->array[i] < b->array[j]))
+            {
+                resultado->array[k++] = a->array[i++];
+            }
+            else if (i >= a->cardinalidade || b->array[j] < a->array[i])
+            {
+                resultado->array[k++] = b->array[j++];
+            }
+            else
+            {
+                resultado->array[k++] = a->array[i++];
+                j++;
+            }
+        }
+        resultado->cardinalidade = k;
+    }
+    else if (ok)
+    {
+        ok = container_iniciar_bitmap(resultado, a->alta);
+        CONTAINER *lados[2] = {a, b};
+        for (int l = 0; ok && l < 2; l++)
+        {
+            CONTAINER *c = lados[l];
+            if (c->tipo == CONTAINER_BITMAP)
+            {
+                for (int w = 0; w < PALAVRAS_BITMAP; w++)
+                {
+                    resultado->bitmap[w] |= c->bitmap[w];
+                }
+            }
+            else
+            {
+                for (int i = 0; i < c->cardinalidade; i++)
+                {
+                    resultado->bitmap[c->array[i] >> 6] |= (uint64_t)1 << (c->array[i] & 63);
+                }
+            }
+        }
+        if (ok)
+        {
+            for (int w = 0; w < PALAVRAS_BITMAP; w++)
+            {
+                resultado->cardinalidade += CONTAR_BITS(resultado->bitmap[w]);
+            }
+            if (resultado->cardinalidade <= LIMITE_ARRAY)
+            {
+                container_para_array(resultado);
+            }
+        }
+    }
+
+    if (a == &t1)
+        container_liberar(&t1);
+    if (b == &t2)
+        container_liberar(&t2);
+    return ok;
+}
+
+/*
+    Interseção de containers
+    Ideia:
+        - vetor com vetor: intercalação guardando apenas as chaves comuns
+        - vetor com mapa de bits: testa o bit de cada chave do vetor
+        - mapa de bits com mapa de bits: E palavra a palavra, contando com popcount; com poucas chaves, o resultado vira vetor
+*/
+static bool container_intersecao(CONTAINER *resultado, CONTAINER *c1, CONTAINER *c2)
+{
+    CONTAINER t1, t2;
+    CONTAINER *a = container_operando(c1, &t1);
+    CONTAINER *b = container_operando(c2, &t2);
+    bool ok = (a != NULL && b != NULL);
+
+    if (ok && a->tipo == CONTAINER_BITMAP && b->tipo == CONTAINER_BITMAP)
+    {
+        ok = container_iniciar_bitmap(resultado, a->alta);
+        if (ok)
+        {
+            for (int w = 0; w < PALAVRAS_BITMAP; w++)
+            {
+                resultado->bitmap[w] = a->bitmap[w] & b->bitmap[w];
+                resultado->cardinalidade += CONTAR_BITS(resultado->bitmap[w]);
+            }
+            if (resultado->cardinalidade <= LIMITE_ARRAY)
+            {
+                container_para_array(resultado);
+            }
+        }
+    }
+    else if (ok)
+    {
+        // o menor (ou o vetor) é percorrido; cada chave é testada no outro
+        CONTAINER *vetor = a->tipo == CONTAINER_ARRAY ? a : b;
+        CONTAINER *outro = vetor == a ? b : a;
+        ok = container_iniciar_array(resultado, a->alta, vetor->cardinalidade);
+        if (ok && outro->tipo == CONTAINER_BITMAP)
+        {
+            for (int i = 0; i < vetor->cardinalidade; i++)
+            {
+                uint16_t v = vetor->array[i];
+                if ((outro->bitmap[v >> 6] >> (v & 63)) & 1)
+                {
+                    resultado->array[resultado->cardinalidade++] = v;
+                }
+            }
+        }
+        else if (ok)
+        {
+            int i = 0, j = 0;
+            while (i < a->cardinalidade && j < b->cardinalidade)
+            {
+                if (a->array[i] == b->array[j])
+                {
+                    resultado->array[resultado->cardinalidade++] = a->array[i];
+                    i++;
+                    j++;
+                }
+                else if (a->array[i] > b->array[j])
+                {
+                    j++;
+                }
+                else
+                {
+                    i++;
+                }
+            }
+        }
+    }
+
+    if (a == &t1)
+        container_liberar(&t1);
+    if (b == &t2)
+        container_liberar(&t2);
+    return ok;
+}
+
+/////// MAPA ///////
+/*
+    Criação do mapa
+    Ideia: começa sem containers; cada container é criado quando a primeira chave com seus 16 bits altos é inserida
+*/
+MAPA_BITS *mapa_bits_criar(void)
+{
+    MAPA_BITS *mapa = (MAPA_BITS *)malloc(sizeof(MAPA_BITS));
+    if (mapa != NULL)
+    {
+        mapa->containers = NULL;
+        mapa->quantidade = 0;
+        mapa->capacidade = 0;
+        mapa->cardinalidade = 0;
+    }
+    return mapa;
+}
+
+/*
+    Busca de container
+    Ideia: busca binária pelos 16 bits altos; retorna a posição ou -(posição de inserção + 1)
+*/
+static int mapa_bits_busca(MAPA_BITS *mapa, uint16_t alta)
+{
+    int inf = 0, sup = mapa->quantidade - 1;
+    while (inf <= sup)
+    {
+        int meio = (inf + sup) / 2;
+        if (mapa->containers[meio].alta == alta)
+        {
+            return meio;
+        }
+        else if (mapa->containers[meio].alta > alta)
+        {
+            sup = meio - 1;
+        }
+        else
+        {
+            inf = meio + 1;
+        }
+    }
+    return -(inf + 1);
+}
+
+// Garante espaço para mais um container no vetor de containers (crescimento geométrico)
+static bool mapa_bits_reservar(MAPA_BITS *mapa, int quantidade)
+{
+    if (quantidade <= mapa->capacidade)
+    {
+        return true;
+    }
+    int nova = mapa->capacidade * 2 > quantidade ? mapa->capacidade * 2 : quantidade;
+    CONTAINER *novos = (CONTAINER *)realloc(mapa->containers, nova * sizeof(CONTAINER));
+    if (novos == NULL)
+    {
+        return false;
+    }
+    mapa->containers = novos;
+    mapa->capacidade = nova;
+    return true;
+}
+
+/*
+    Criação a partir de vetor
+    Parâmetros: vetor ordenado e sem repetições e seu tamanho
+    Ideia: como as chaves estão ordenadas, as de mesmo container são vizinhas; cada grupo vira um vetor ou um mapa de bits
+    de uma só vez, e depois o container é otimizado para sequências quando isso economiza memória. Custo: O(n)
+*/
+MAPA_BITS *mapa_bits_criar_de_vetor(const int *ordenado, int n)
+{
+    MAPA_BITS *mapa = mapa_bits_criar();
+    if (mapa == NULL)
+    {
+        return NULL;
+    }
+    int i = 0;
+    while (i < n)
+    {
+        uint16_t alta = chave_alta(ordenado[i]);
+        int fim = i;
+        while (fim < n && chave_alta(ordenado[fim]) == alta)
+        {
+            fim++;
+        }
+        int quantidade = fim - i;
+        if (!mapa_bits_reservar(mapa, mapa->quantidade + 1))
+        {
+            mapa_bits_apagar(&mapa);
+            return NULL;
+        }
+        CONTAINER *c = &mapa->containers[mapa->quantidade];
+        bool ok;
+        if (quantidade <= LIMITE_ARRAY)
+        {
+            ok = container_iniciar_array(c, alta, quantidade);
+            for (int j = i; ok && j < fim; j++)
+            {
+                c->array[c->cardinalidade++] = chave_baixa(ordenado[j]);
+            }
+        }
+        else
+        {
+            ok = container_iniciar_bitmap(c, alta);
+            for (int j = i; ok && j < fim; j++)
+            {
+                uint16_t v = chave_baixa(ordenado[j]);
+                c->bitmap[v >> 6] |= (uint64_t)1 << (v & 63);
+            }
+            c->cardinalidade = quantidade;
+        }
+        if (!ok)
+        {
+            mapa_bits_apagar(&mapa);
+            return NULL;
+        }
+        container_otimizar(c);
+        mapa->quantidade++;
+        mapa->cardinalidade += quantidade;
+        i = fim;
+    }
+    return mapa;
+}
+
+/*
+    Apagar
+    Ideia: libera os vetores de cada container, o vetor de containers e o mapa
+*/
+bool mapa_bits_apagar(MAPA_BITS **mapa)
+{
+    if (mapa == NULL || *mapa == NULL)
+    {
+        return false;
+    }
+    for (int i = 0; i < (*mapa)->quantidade; i++)
+    {
+        container_liberar(&(*mapa)->containers[i]);
+    }
+    free((*mapa)->containers);
+    free(*mapa);
+    *mapa = NULL;
+    return true;
+}
+
+/*
+    Inserir
+    Ideia: acha (ou cria, na posição certa do vetor de containers) o container dos 16 bits altos e insere os 16 bits baixos nele
+*/
+bool mapa_bits_inserir(MAPA_BITS *mapa, int chave)
+{
+    if (mapa == NULL)
+    {
+        return false;
+    }
+    uint16_t alta = chave_alta(chave);
+    int pos = mapa_bits_busca(mapa, alta);
+    if (pos < 0)
+    {
+        pos = -pos - 1;
+        if (!mapa_bits_reservar(mapa, mapa->quantidade + 1))
+        {
+            return false;
+        }
+        CONTAINER novo;
+        if (!container_iniciar_array(&novo, alta, 4))
+        {
+            return false;
+        }
+        memmove(mapa->containers + pos + 1, mapa->containers + pos, (mapa->quantidade - pos) * sizeof(CONTAINER));
+        mapa->containers[pos] = novo;
+        mapa->quantidade++;
+    }
+    if (!container_inserir(&mapa->containers[pos], chave_baixa(chave)))
+    {
+        return false;
+    }
+    mapa->cardinalidade++;
+    return true;
+}
+
+/*
+    Remover
+    Ideia: remove os 16 bits baixos do container; se o container esvaziar, ele é retirado do vetor de containers
+*/
+bool mapa_bits_remover(MAPA_BITS *mapa, int chave)
+{
+    if (mapa == NULL)
+    {
+        return false;
+    }
+    int pos = mapa_bits_busca(mapa, chave_alta(chave));
+    if (pos < 0 || !container_remover(&mapa->containers[pos], chave_baixa(chave)))
+    {
+        return false;
+    }
+    if (mapa->containers[pos].cardinalidade == 0)
+    {
+        container_liberar(&mapa->containers[pos]);
+        memmove(mapa->containers + pos, mapa->containers + pos + 1, (mapa->quantidade - pos - 1) * sizeof(CONTAINER));
+        mapa->quantidade--;
+    }
+    mapa->cardinalidade--;
+    return true;
+}
+
+/*
+    Inserir e remover em lote
+    Parâmetros: mapa, vetor ordenado e sem repetições e seu tamanho k
+    Ideia: como o lote está ordenado, chaves seguidas caem no mesmo container, que fica quente na cache.
+    Retornam quantas chaves foram de fato inseridas ou removidas
+*/
+int mapa_bits_inserir_lote(MAPA_BITS *mapa, const int *ordenado, int k)
+{
+    int inseridos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        inseridos += mapa_bits_inserir(mapa, ordenado[i]);
+    }
+    return inseridos;
+}
+
+int mapa_bits_remover_lote(MAPA_BITS *mapa, const int *ordenado, int k)
+{
+    int removidos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        removidos += mapa_bits_remover(mapa, ordenado[i]);
+    }
+    return removidos;
+}
+
+bool mapa_bits_pertence(MAPA_BITS *mapa, int chave)
+{
+    if (mapa == NULL)
+    {
+        return false;
+    }
+    int pos = mapa_bits_busca(mapa, chave_alta(chave));
+    return pos >= 0 && container_pertence(&mapa->containers[pos], chave_baixa(chave));
+}
+
+int mapa_bits_tamanho(MAPA_BITS *mapa)
+{
+    return mapa != NULL ? mapa->cardinalidade : 0;
+}
+
+/*
+    Exportar
+    Parâmetros: mapa e vetor de saída (com espaço para mapa_bits_tamanho elementos)
+    Ideia: percorre os containers em ordem e, em cada um, as chaves baixas em ordem crescente, remontando a chave completa
+    no vetor. Retorna a quantidade de chaves
+*/
+int mapa_bits_exportar(MAPA_BITS *mapa, int *saida)
+{
+    int n = 0;
+    for (int i = 0; mapa != NULL && i < mapa->quantidade; i++)
+    {
+        CONTAINER *c = &mapa->containers[i];
+        if (c->tipo == CONTAINER_ARRAY)
+        {
+            for (int j = 0; j < c->cardinalidade; j++)
+            {
+                saida[n++] = montar_chave(c->alta, c->array[j]);
+            }
+        }
+        else if (c->tipo == CONTAINER_BITMAP)
+        {
+            for (int w = 0; w < PALAVRAS_BITMAP; w++)
+            {
+                for (uint64_t palavra = c->bitmap[w]; palavra; palavra &= palavra - 1)
+                {
+                    saida[n++] = montar_chave(c->alta, (uint16_t)(w * 64 + ZEROS_A_DIREITA(palavra)));
+                }
+            }
+        }
+        else
+        {
+            for (int s = 0; s < c->sequencias; s++)
+            {
+                int inicio = c->array[2 * s], fim = inicio + c->array[2 * s + 1];
+                for (int v = inicio; v <= fim; v++)
+                {
+                    saida[n++] = montar_chave(c->alta, (uint16_t)v);
+                }
+            }
+        }
+    }
+    return n;
+}
+
+/*
+    União
+    Ideia: percorre os dois vetores de containers paralelamente (eles estão ordenados pelos 16 bits altos);
+    containers com a mesma chave alta são unidos, e os que só existem em um dos mapas são copiados
+*/
+MAPA_BITS *mapa_bits_uniao(MAPA_BITS *mapa1, MAPA_BITS *mapa2)
+{
+    if (mapa1 == NULL || mapa2 == NULL)
+    {
+        return NULL;
+    }
+    MAPA_BITS *resultado = mapa_bits_criar();
+    if (resultado == NULL || !mapa_bits_reservar(resultado, mapa1->quantidade + mapa2->quantidade))
+    {
+        mapa_bits_apagar(&resultado);
+        return NULL;
+    }
+    int i = 0, j = 0;
+    while (i < mapa1->quantidade || j < mapa2->quantidade)
+    {
+        CONTAINER *destino = &resultado->containers[resultado->quantidade];
+        bool ok;
+        if (j >= mapa2->quantidade || (i < mapa1->quantidade && mapa1->containers[i].alta < mapa2->containers[j].alta))
+        {
+            ok = container_copiar(destino, &mapa1->containers[i++]);
+        }
+        else if (i >= mapa1->quantidade || mapa2->containers[j].alta < mapa1->containers[i].alta)
+        {
+            ok = container_copiar(destino, &mapa2->containers[j++]);
+        }
+        else
+        {
+            ok = container_uniao(destino, &mapa1->containers[i++], &mapa2->containers[j++]);
+        }
+        if (!ok)
+        {
+            mapa_bits_apagar(&resultado);
+            return NULL;
+        }
+        resultado->cardinalidade += destino->cardinalidade;
+        resultado->quantidade++;
+    }
+    return resultado;
+}
+
+/*
+    Intersecção
+    Ideia: apenas containers com a mesma chave alta nos dois mapas podem ter chaves em comum; os resultados vazios são descartados
+*/
+MAPA_BITS *mapa_bits_intersecao(MAPA_BITS *mapa1, MAPA_BITS *mapa2)
+{
+    if (mapa1 == NULL || mapa2 == NULL)
+    {
+        return NULL;
+    }
+    MAPA_BITS *resultado = mapa_bits_criar();
+    int menor = mapa1->quantidade < mapa2->quantidade ? mapa1->quantidade : mapa2->quantidade;
+    if (resultado == NULL || !mapa_bits_reservar(resultado, menor))
+    {
+        mapa_bits_apagar(&resultado);
+        return NULL;
+    }
+    int i = 0, j = 0;
+    while (i < mapa1->quantidade && j < mapa2->quantidade)
+    {
+        if (mapa1->containers[i].alta < mapa2->containers[j].alta)
+        {
+            i++;
+        }
+        else if (mapa2->containers[j].alta < mapa1->containers[i].alta)
+        {
+            j++;
+        }
+        else
+        {
+            CONTAINER *destino = &resultado->containers[resultado->quantidade];
+            if (!container_intersecao(destino, &mapa1->containers[i++], &mapa2->containers[j++]))
+            {
+                mapa_bits_apagar(&resultado);
+                return NULL;
+            }
+            if (destino->cardinalidade == 0)
+            {
+                container_liberar(destino);
+                continue;
+            }
+            resultado->cardinalidade += destino->cardinalidade;
+            resultado->quantidade++;
+        }
+    }
+    return resultado;
+}
+
+/*
+    Otimizar
+    Ideia: converte para run os containers em que as sequências ocupam menos memória (útil depois de uma carga em massa)
+*/
+void mapa_bits_otimizar(MAPA_BITS *mapa)
+{
+    for (int i = 0; mapa != NULL && i < mapa->quantidade; i++)
+    {
+        container_otimizar(&mapa->containers[i]);
+    }
+}
+
+/*
+    Memória
+    Ideia: soma os bytes usados pelos dados dos containers e pelo vetor de containers
+*/
+int mapa_bits_memoria(MAPA_BITS *mapa)
+{
+    if (mapa == NULL)
+    {
+        return 0;
+    }
+    int bytes = (int)sizeof(MAPA_BITS) + mapa->capacidade * (int)sizeof(CONTAINER);
+    for (int i = 0; i < mapa->quantidade; i++)
+    {
+        bytes += container_memoria(&mapa->containers[i]);
+    }
+    return bytes;
+}
@@ -0,0 +1,30 @@
+#ifndef MAPA_BITS_H
+#define MAPA_BITS_H
+#include <stdint.h>
+
+// Containers com até LIMITE_ARRAY elementos são guardados como vetor; acima disso, como mapa de bits
+#define LIMITE_ARRAY 4096
+// Quantidade de palavras de 64 bits de um container mapa de bits (2^16 bits)
+#define PALAVRAS_BITMAP 1024
+
+#define CONTAINER_ARRAY 0
+#define CONTAINER_BITMAP 1
+#define CONTAINER_RUN 2
+
+typedef struct MapaBits MAPA_BITS;
+
+MAPA_BITS *mapa_bits_criar(void);
+MAPA_BITS *mapa_bits_criar_de_vetor(const int *ordenado, int n);
+bool mapa_bits_apagar(MAPA_BITS **mapa);
+bool mapa_bits_inserir(MAPA_BITS *mapa, int chave);
+bool mapa_bits_remover(MAPA_BITS *mapa, int chave);
+int mapa_bits_inserir_lote(MAPA_BITS *mapa, const int *ordenado, int k);
+int mapa_bits_remover_lote(MAPA_BITS *mapa, const int *ordenado, int k);
+bool mapa_bits_pertence(MAPA_BITS *mapa, int chave);
+int mapa_bits_tamanho(MAPA_BITS *mapa);
+int mapa_bits_exportar(MAPA_BITS *mapa, int *saida);
+MAPA_BITS *mapa_bits_uniao(MAPA_BITS *mapa1, MAPA_BITS *mapa2);
+MAPA_BITS *mapa_bits_intersecao(MAPA_BITS *mapa1, MAPA_BITS *mapa2);
+void mapa_bits_otimizar(MAPA_BITS *mapa);
+int mapa_bits_memoria(MAPA_BITS *mapa);
+#endif
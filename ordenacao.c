@@ -0,0 +1,178 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include "ordenacao.h"
+
+// Quantidade de bits e de baldes de cada dígito do radix sort
+#define BITS_DIGITO 8
+#define BALDES (1 << BITS_DIGITO)
+
+/*
+    Chave sem sinal
+    Parâmetro: elemento
+    Ideia: inverter o bit de sinal faz a ordem dos inteiros sem sinal coincidir com a ordem dos inteiros com sinal
+    (os negativos passam a vir antes dos positivos), o que permite ordenar byte a byte
+*/
+static unsigned int chave_sem_sinal(int elemento)
+{
+    return (unsigned int)elemento ^ 0x80000000u;
+}
+
+/*
+    Ordenação
+    Parâmetros: vetor e quantidade de elementos
+    Ideia: radix sort LSD (do dígito menos significativo para o mais significativo), com dígitos de 8 bits.
+    Cada passada conta quantos elementos caem em cada balde, calcula onde cada balde começa e distribui os elementos
+    em um vetor auxiliar, de forma estável. Passadas em que todos os elementos caem no mesmo balde são puladas.
+    Custo: O(4n) tempo e O(n) de memória auxiliar. Retorna false se não houver memória para o vetor auxiliar
+*/
+bool ordenar_vetor(int *vetor, int n)
+{
+    if (n < 2)
+    {
+        return true;
+    }
+    int *auxiliar = (int *)malloc(n * sizeof(int));
+    if (auxiliar == NULL)
+    {
+        return false;
+    }
+
+    int *origem = vetor, *destino = auxiliar;
+    for (int deslocamento = 0; deslocamento < 32; deslocamento += BITS_DIGITO)
+    {
+        int contagem[BALDES] = {0};
+        for (int i = 0; i < n; i++)
+        {
+            contagem[(chave_sem_sinal(origem[i]) >> deslocamento) & (BALDES - 1)]++;
+        }
+        // se todos os elementos têm o mesmo dígito, a passada não altera a ordem
+        if (contagem[(chave_sem_sinal(origem[0]) >> deslocamento) & (BALDES - 1)] == n)
+        {
+            continue;
+        }
+        // transforma as contagens na posição inicial de cada balde
+        int posicao = 0;
+        for (int b = 0; b < BALDES; b++)
+        {
+            int quantidade = contagem[b];
+            contagem[b] = posicao;
+            posicao += quantidade;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            destino[contagem[(chave_sem_sinal(origem[i]) >> deslocamento) & (BALDES - 1)]++] = origem[i];
+        }
+        int *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+
+    // se o resultado terminou no vetor auxiliar, copia de volta
+    if (origem != vetor)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            vetor[i] = origem[i];
+        }
+    }
+    free(auxiliar);
+    return true;
+}
+
+/*
+    Ordenação de índices
+    Parâmetros: vetor de chaves (não é alterado), vetor de saída para os índices e quantidade de elementos
+    Ideia: o mesmo radix sort LSD, mas o que é distribuído nos baldes são os índices, pelo dígito da chave de cada um.
+    Como cada passada é estável, índices de chaves iguais ficam em ordem crescente. Ao final, chaves[indices[i]] está em ordem crescente.
+    Retorna false se não houver memória para o vetor auxiliar
+*/
+bool ordenar_indices(const int *chaves, int *indices, int n)
+{
+    for (int i = 0; i < n; i++)
+    {
+        indices[i] = i;
+    }
+    if (n < 2)
+    {
+        return true;
+    }
+    int *auxiliar = (int *)malloc(n * sizeof(int));
+    if (auxiliar == NULL)
+    {
+        return false;
+    }
+
+    int *origem = indices, *destino = auxiliar;
+    for (int deslocamento = 0; deslocamento < 32; deslocamento += BITS_DIGITO)
+    {
+        int contagem[BALDES] = {0};
+        for (int i = 0; i < n; i++)
+        {
+            contagem[(chave_sem_sinal(chaves[origem[i]]) >> deslocamento) & (BALDES - 1)]++;
+        }
+        if (contagem[(chave_sem_sinal(chaves[origem[0]]) >> deslocamento) & (BALDES - 1)] == n)
+        {
+            continue;
+        }
+        int posicao = 0;
+        for (int b = 0; b < BALDES; b++)
+        {
+            int quantidade = contagem[b];
+            contagem[b] = posicao;
+            posicao += quantidade;
+        }
+        for (int i = 0; i < n; i++)
+        {
+            destino[contagem[(chave_sem_sinal(chaves[origem[i]]) >> deslocamento) & (BALDES - 1)]++] = origem[i];
+        }
+        int *troca = origem;
+        origem = destino;
+        destino = troca;
+    }
+
+    if (origem != indices)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            indices[i] = origem[i];
+        }
+    }
+    free(auxiliar);
+    return true;
+}
+
+/*
+    Remover repetidos
+    Parâmetros: vetor ordenado e quantidade de elementos
+    Ideia: como os repetidos estão lado a lado, basta uma passada copiando cada elemento diferente do último mantido
+*/
+int remover_repetidos(int *vetor, int n)
+{
+    if (n < 2)
+    {
+        return n;
+    }
+    int fim = 1;
+    for (int i = 1; i < n; i++)
+    {
+        if (vetor[i] != vetor[fim - 1])
+        {
+            vetor[fim++] = vetor[i];
+        }
+    }
+    return fim;
+}
+
+/*
+    Ordenar sem repetição
+    Parâmetros: vetor e quantidade de elementos
+    Ideia: ordena e remove os repetidos, deixando o vetor no formato esperado pelas construções em lote dos conjuntos
+*/
+int ordenar_sem_repeticao(int *vetor, int n)
+{
+    if (!ordenar_vetor(vetor, n))
+    {
+        return -1;
+    }
+    return remover_repetidos(vetor, n);
+}
@@ -0,0 +1,16 @@
+#ifndef ORDENACAO_H
+#define ORDENACAO_H
+
+// Ordena o vetor em ordem crescente (radix sort, O(n))
+bool ordenar_vetor(int *vetor, int n);
+
+// Preenche "indices" com as posições de "chaves" em ordem crescente de chave, sem alterar "chaves" (radix sort estável)
+bool ordenar_indices(const int *chaves, int *indices, int n);
+
+// Remove os elementos repetidos de um vetor ordenado e retorna a nova quantidade de elementos
+int remover_repetidos(int *vetor, int n);
+
+// Ordena o vetor e remove os repetidos, retornando a nova quantidade de elementos (-1 em caso de falha)
+int ordenar_sem_repeticao(int *vetor, int n);
+
+#endif
@@ -0,0 +1,352 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include <limits.h>
+#include <fcntl.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include "persistencia.h"
+
+#define MAGICA "CNJ1"
+// Gravada no cabeçalho para detectar um arquivo escrito em uma máquina com outra ordem de bytes
+#define MARCA_ORDEM 0x01020304u
+
+/*
+Formato do arquivo (inteiros na ordem de bytes da máquina):
+    - cabeçalho de TAMANHO_CABECALHO bytes
+    - FORMATO_VETOR: os n elementos como int, em ordem crescente, logo após o cabeçalho (alinhados a 64 bytes)
+    - FORMATO_COMPRIMIDO: o índice, com uma entrada por bloco de ELEMENTOS_POR_BLOCO elementos (primeiro elemento do bloco
+      e onde começam os seus dados), seguido dos dados: para cada elemento depois do primeiro de cada bloco, a diferença
+      para o anterior menos 1, em varint (7 bits por byte, o bit mais alto indica que há mais bytes). Elementos próximos
+      ocupam 1 byte em vez de 4, e o índice permite decodificar só um bloco para procurar uma chave
+*/
+typedef struct Cabecalho
+{
+    char magica[4];
+    uint32_t marca_ordem;
+    uint32_t formato;
+    int32_t tipo;
+    uint32_t quantidade;
+    uint32_t blocos;
+    uint32_t elementos_por_bloco;
+    uint32_t reservado1;
+    uint64_t tamanho_dados;
+    uint8_t reservado2[TAMANHO_CABECALHO - 40];
+} CABECALHO;
+
+typedef struct BlocoIndice
+{
+    int32_t primeiro;
+    uint32_t deslocamento; // a partir do início dos dados
+} BLOCO_INDICE;
+
+struct ArquivoConjunto
+{
+    uint8_t *mapa;
+    size_t tamanho;
+    const CABECALHO *cabecalho;
+    const BLOCO_INDICE *indice; // FORMATO_COMPRIMIDO
+    const uint8_t *dados;       // FORMATO_COMPRIMIDO
+    int *vetor;                 // FORMATO_VETOR
+};
+
+static size_t escrever_varint(uint8_t *destino, uint32_t valor)
+{
+    size_t n = 0;
+    while (valor >= 0x80)
+    {
+        destino[n++] = (uint8_t)(valor | 0x80);
+        valor >>= 7;
+    }
+    destino[n++] = (uint8_t)valor;
+    return n;
+}
+
+// Lê um varint sem passar de "limite"; NULL se ele não terminar antes do limite ou tiver mais de 5 bytes
+static const uint8_t *ler_varint(const uint8_t *p, const uint8_t *limite, uint32_t *valor)
+{
+    uint32_t resultado = 0;
+    for (int deslocamento = 0; p < limite && deslocamento < 35; deslocamento += 7)
+    {
+        uint8_t byte = *p++;
+        resultado |= (uint32_t)(byte & 0x7f) << deslocamento;
+        if (!(byte & 0x80))
+        {
+            *valor = resultado;
+            return p;
+        }
+    }
+    return NULL;
+}
+
+/*
+    Salvar
+    Parâmetros: caminho, vetor ordenado e sem repetidos, seu tamanho, tipo da estrutura de origem e formato
+    Ideia: monta o índice e os dados em memória (no pior caso, 5 bytes por elemento) e grava cabeçalho, índice e dados
+*/
+bool persistencia_salvar(const char *caminho, const int *ordenado, int n, int tipo, int formato)
+{
+    if (n < 0 || (formato != FORMATO_COMPRIMIDO && formato != FORMATO_VETOR))
+        return false;
+
+    CABECALHO cabecalho;
+    memset(&cabecalho, 0, sizeof(cabecalho));
+    memcpy(cabecalho.magica, MAGICA, 4);
+    cabecalho.marca_ordem = MARCA_ORDEM;
+    cabecalho.formato = (uint32_t)formato;
+    cabecalho.tipo = tipo;
+    cabecalho.quantidade = (uint32_t)n;
+    cabecalho.elementos_por_bloco = ELEMENTOS_POR_BLOCO;
+
+    BLOCO_INDICE *indice = NULL;
+    uint8_t *dados = NULL;
+    if (formato == FORMATO_COMPRIMIDO)
+    {
+        cabecalho.blocos = (uint32_t)((n + ELEMENTOS_POR_BLOCO - 1) / ELEMENTOS_POR_BLOCO);
+        indice = (BLOCO_INDICE *)malloc((cabecalho.blocos > 0 ? cabecalho.blocos : 1) * sizeof(BLOCO_INDICE));
+        dados = (uint8_t *)malloc((size_t)n * 5 + 1);
+        if (!indice || !dados)
+        {
+            free(indice);
+            free(dados);
+            return false;
+        }
+        size_t usados = 0;
+        for (int i = 0; i < n; i++)
+        {
+            if (i % ELEMENTOS_POR_BLOCO == 0)
+            {
+                indice[i / ELEMENTOS_POR_BLOCO].primeiro = ordenado[i];
+                indice[i / ELEMENTOS_POR_BLOCO].deslocamento = (uint32_t)usados;
+            }
+            else
+            {
+                usados += escrever_varint(dados + usados, (uint32_t)ordenado[i] - (uint32_t)ordenado[i - 1] - 1);
+            }
+        }
+        cabecalho.tamanho_dados = usados;
+        if (usados > UINT32_MAX) // os deslocamentos do índice têm 32 bits
+        {
+            free(indice);
+            free(dados);
+            return false;
+        }
+    }
+
+    FILE *arquivo = fopen(caminho, "wb");
+    bool ok = arquivo != NULL && fwrite(&cabecalho, sizeof(cabecalho), 1, arquivo) == 1;
+    if (ok && formato == FORMATO_VETOR)
+    {
+        ok = fwrite(ordenado, sizeof(int), (size_t)n, arquivo) == (size_t)n;
+    }
+    else if (ok)
+    {
+        ok = fwrite(indice, sizeof(BLOCO_INDICE), cabecalho.blocos, arquivo) == cabecalho.blocos &&
+             fwrite(dados, 1, cabecalho.tamanho_dados, arquivo) == cabecalho.tamanho_dados;
+    }
+    if (arquivo != NULL && fclose(arquivo) != 0)
+        ok = false;
+    free(indice);
+    free(dados);
+    return ok;
+}
+
+/*
+    Validar
+    Ideia: confere que tudo o que o cabeçalho descreve cabe no arquivo, que o índice é crescente e, no formato de vetor,
+    que os elementos estão em ordem estritamente crescente (a lista montada sobre ele depende disso)
+*/
+static bool validar(ARQUIVO_CONJUNTO *arquivo)
+{
+    const CABECALHO *c = arquivo->cabecalho;
+    if (memcmp(c->magica, MAGICA, 4) != 0 || c->marca_ordem != MARCA_ORDEM || c->quantidade > INT_MAX)
+        return false;
+    size_t resto = arquivo->tamanho - TAMANHO_CABECALHO;
+    if (c->formato == FORMATO_VETOR)
+    {
+        if (resto / sizeof(int) < c->quantidade)
+            return false;
+        for (uint32_t i = 1; i < c->quantidade; i++)
+        {
+            if (arquivo->vetor[i - 1] >= arquivo->vetor[i])
+                return false;
+        }
+        return true;
+    }
+    if (c->formato != FORMATO_COMPRIMIDO || c->elementos_por_bloco == 0 || c->elementos_por_bloco > ELEMENTOS_POR_BLOCO ||
+        c->blocos != (c->quantidade + (uint64_t)c->elementos_por_bloco - 1) / c->elementos_por_bloco ||
+        resto / sizeof(BLOCO_INDICE) < c->blocos || resto - c->blocos * sizeof(BLOCO_INDICE) < c->tamanho_dados)
+        return false;
+    for (uint32_t b = 0; b < c->blocos; b++)
+    {
+        if (arquivo->indice[b].deslocamento > c->tamanho_dados ||
+            (b > 0 && (arquivo->indice[b].deslocamento < arquivo->indice[b - 1].deslocamento ||
+                       arquivo->indice[b].primeiro <= arquivo->indice[b - 1].primeiro)))
+            return false;
+    }
+    return true;
+}
+
+/*
+    Abrir
+    Ideia: mapeia o arquivo inteiro (privado e com escrita, para que uma lista montada sobre o vetor possa alterá-lo
+    no lugar sem mudar o arquivo) e aponta o índice, os dados ou o vetor para dentro do mapeamento
+*/
+ARQUIVO_CONJUNTO *persistencia_abrir(const char *caminho)
+{
+    int fd = open(caminho, O_RDONLY);
+    if (fd < 0)
+        return NULL;
+    struct stat info;
+    if (fstat(fd, &info) != 0 || !S_ISREG(info.st_mode) || info.st_size < TAMANHO_CABECALHO)
+    {
+        close(fd);
+        return NULL;
+    }
+    void *mapa = mmap(NULL, (size_t)info.st_size, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapa == MAP_FAILED)
+        return NULL;
+
+    ARQUIVO_CONJUNTO *arquivo = (ARQUIVO_CONJUNTO *)malloc(sizeof(ARQUIVO_CONJUNTO));
+    if (!arquivo)
+    {
+        munmap(mapa, (size_t)info.st_size);
+        return NULL;
+    }
+    arquivo->mapa = (uint8_t *)mapa;
+    arquivo->tamanho = (size_t)info.st_size;
+    arquivo->cabecalho = (const CABECALHO *)mapa;
+    arquivo->vetor = (int *)(arquivo->mapa + TAMANHO_CABECALHO);
+    arquivo->indice = (const BLOCO_INDICE *)(arquivo->mapa + TAMANHO_CABECALHO);
+    if (!validar(arquivo))
+    {
+        persistencia_fechar(&arquivo);
+        return NULL;
+    }
+    arquivo->dados = arquivo->mapa + TAMANHO_CABECALHO + (size_t)arquivo->cabecalho->blocos * sizeof(BLOCO_INDICE);
+    return arquivo;
+}
+
+void persistencia_fechar(ARQUIVO_CONJUNTO **arquivo)
+{
+    if (!arquivo || !*arquivo)
+        return;
+    if ((*arquivo)->mapa)
+        munmap((*arquivo)->mapa, (*arquivo)->tamanho);
+    free(*arquivo);
+    *arquivo = NULL;
+}
+
+int persistencia_quantidade(ARQUIVO_CONJUNTO *arquivo)
+{
+    return arquivo ? (int)arquivo->cabecalho->quantidade : 0;
+}
+
+int persistencia_tipo(ARQUIVO_CONJUNTO *arquivo)
+{
+    return arquivo ? arquivo->cabecalho->tipo : -1;
+}
+
+int persistencia_formato(ARQUIVO_CONJUNTO *arquivo)
+{
+    return arquivo ? (int)arquivo->cabecalho->formato : -1;
+}
+
+/*
+    Decodificar bloco
+    Parâmetros: arquivo, número do bloco e vetor de saída
+    Ideia: parte do primeiro elemento (do índice) e soma as diferenças; os dados do bloco terminam onde começam os do próximo.
+    Retorna quantos elementos o bloco tem, ou -1 se os dados não couberem no bloco ou não forem crescentes
+*/
+static int decodificar_bloco(ARQUIVO_CONJUNTO *arquivo, uint32_t b, int *saida)
+{
+    const CABECALHO *c = arquivo->cabecalho;
+    uint32_t inicio = b * c->elementos_por_bloco;
+    uint32_t quantidade = c->quantidade - inicio < c->elementos_por_bloco ? c->quantidade - inicio : c->elementos_por_bloco;
+    const uint8_t *p = arquivo->dados + arquivo->indice[b].deslocamento;
+    const uint8_t *limite = arquivo->dados + (b + 1 < c->blocos ? arquivo->indice[b + 1].deslocamento : c->tamanho_dados);
+
+    saida[0] = arquivo->indice[b].primeiro;
+    for (uint32_t i = 1; i < quantidade; i++)
+    {
+        uint32_t diferenca;
+        p = ler_varint(p, limite, &diferenca);
+        int64_t proximo = (int64_t)saida[i - 1] + diferenca + 1;
+        if (!p || proximo > INT_MAX)
+            return -1;
+        saida[i] = (int)proximo;
+    }
+    return (int)quantidade;
+}
+
+int persistencia_decodificar(ARQUIVO_CONJUNTO *arquivo, int *saida)
+{
+    const CABECALHO *c = arquivo->cabecalho;
+    if (c->formato == FORMATO_VETOR)
+    {
+        memcpy(saida, arquivo->vetor, c->quantidade * sizeof(int));
+        return (int)c->quantidade;
+    }
+    int n = 0;
+    for (uint32_t b = 0; b < c->blocos; b++)
+    {
+        int k = decodificar_bloco(arquivo, b, saida + n);
+        if (k < 0 || (b > 0 && saida[n] <= saida[n - 1]))
+            return -1;
+        n += k;
+    }
+    return n;
+}
+
+bool persistencia_pertence(ARQUIVO_CONJUNTO *arquivo, int chave)
+{
+    const CABECALHO *c = arquivo->cabecalho;
+    if (c->formato == FORMATO_VETOR)
+    {
+        int inf = 0, sup = (int)c->quantidade;
+        while (inf < sup)
+        {
+            int meio = inf + (sup - inf) / 2;
+            if (arquivo->vetor[meio] < chave)
+                inf = meio + 1;
+            else
+                sup = meio;
+        }
+        return inf < (int)c->quantidade && arquivo->vetor[inf] == chave;
+    }
+    // último bloco cujo primeiro elemento é <= chave
+    int inf = 0, sup = (int)c->blocos;
+    while (inf < sup)
+    {
+        int meio = inf + (sup - inf) / 2;
+        if (arquivo->indice[meio].primeiro <= chave)
+            inf = meio + 1;
+        else
+            sup = meio;
+    }
+    if (inf == 0)
+        return false;
+    int bloco[ELEMENTOS_POR_BLOCO];
+    int k = decodificar_bloco(arquivo, (uint32_t)(inf - 1), bloco);
+    for (int i = 0; i < k && bloco[i] <= chave; i++)
+    {
+        if (bloco[i] == chave)
+            return true;
+    }
+    return false;
+}
+
+bool persistencia_soltar_vetor(ARQUIVO_CONJUNTO *arquivo, void **mapa, size_t *tamanho_mapa, int **vetor)
+{
+    if (!arquivo || arquivo->cabecalho->formato != FORMATO_VETOR || !arquivo->mapa)
+        return false;
+    *mapa = arquivo->mapa;
+    *tamanho_mapa = arquivo->tamanho;
+    *vetor = arquivo->vetor;
+    arquivo->mapa = NULL;
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef PERSISTENCIA_H
+#define PERSISTENCIA_H
+#include <stddef.h>
+#include <stdbool.h>
+
+// Formatos do arquivo: blocos de diferenças em varint (compacto) ou o vetor de int puro (mapeável direto como lista)
+#define FORMATO_COMPRIMIDO 0
+#define FORMATO_VETOR 1
+
+// Elementos por bloco do formato comprimido: cada bloco guarda o primeiro elemento no índice e os demais como diferenças
+#define ELEMENTOS_POR_BLOCO 128
+// Tamanho do cabeçalho; também alinha o vetor do formato FORMATO_VETOR a uma linha de cache
+#define TAMANHO_CABECALHO 64
+
+typedef struct ArquivoConjunto ARQUIVO_CONJUNTO;
+
+// Grava um vetor ordenado e sem repetidos no formato escolhido, junto com o tipo da estrutura de origem
+bool persistencia_salvar(const char *caminho, const int *ordenado, int n, int tipo, int formato);
+
+// Mapeia o arquivo e confere o cabeçalho e o índice; NULL se não existir ou não for um arquivo válido
+ARQUIVO_CONJUNTO *persistencia_abrir(const char *caminho);
+void persistencia_fechar(ARQUIVO_CONJUNTO **arquivo);
+
+int persistencia_quantidade(ARQUIVO_CONJUNTO *arquivo);
+int persistencia_tipo(ARQUIVO_CONJUNTO *arquivo);
+int persistencia_formato(ARQUIVO_CONJUNTO *arquivo);
+
+// Escreve os elementos, em ordem, no vetor de saída (com espaço para persistencia_quantidade); -1 se os dados estiverem corrompidos
+int persistencia_decodificar(ARQUIVO_CONJUNTO *arquivo, int *saida);
+
+// Verifica se a chave está no arquivo sem decodificá-lo inteiro (busca binária no índice e um só bloco)
+bool persistencia_pertence(ARQUIVO_CONJUNTO *arquivo, int chave);
+
+// FORMATO_VETOR: entrega o mapeamento e o vetor dentro dele (o arquivo deixa de ser dono do mapeamento e, depois disso,
+// só pode ser fechado); false nos demais formatos
+bool persistencia_soltar_vetor(ARQUIVO_CONJUNTO *arquivo, void **mapa, size_t *tamanho_mapa, int **vetor);
+#endif
@@ -0,0 +1,141 @@
+#include <stdio.h>
+#include <stdlib.h>
+#include <stdbool.h>
+#include <string.h>
+#include <errno.h>
+#include <unistd.h>
+#include "saida.h"
+
+// Pares de dígitos de 00 a 99: cada divisão por 100 produz dois caracteres de uma vez
+static const char PARES_DIGITOS[201] =
+    "0001020304050607080910111213141516171819"
+    "2021222324252627282930313233343536373839"
+    "4041424344454647484950515253545556575859"
+    "6061626364656667686970717273747576777879"
+    "8081828384858687888990919293949596979899";
+
+static void iniciar(SAIDA *saida, FILE *arquivo, int fd, char *memoria, size_t capacidade)
+{
+    saida->usados = 0;
+    saida->arquivo = arquivo;
+    saida->fd = fd;
+    saida->memoria = memoria;
+    saida->capacidade = capacidade;
+    saida->total = 0;
+    saida->erro = false;
+}
+
+void saida_iniciar_arquivo(SAIDA *saida, FILE *arquivo)
+{
+    iniciar(saida, arquivo, -1, NULL, 0);
+}
+
+void saida_iniciar_fd(SAIDA *saida, int fd)
+{
+    iniciar(saida, NULL, fd, NULL, 0);
+}
+
+void saida_iniciar_memoria(SAIDA *saida, char *memoria, size_t capacidade)
+{
+    iniciar(saida, NULL, -1, memoria, capacidade);
+}
+
+/*
+    Formatar inteiro
+    Ideia: trabalha com o módulo sem sinal (para INT_MIN não transbordar), gerando os dígitos de trás para frente,
+    dois por divisão, em um vetor temporário que depois é copiado para o destino
+*/
+int formatar_inteiro(int valor, char *destino)
+{
+    char temporario[MAX_DIGITOS_INTEIRO];
+    char *p = temporario + MAX_DIGITOS_INTEIRO;
+    unsigned modulo = valor < 0 ? 0u - (unsigned)valor : (unsigned)valor;
+    while (modulo >= 100)
+    {
+        unsigned par = (modulo % 100) * 2;
+        modulo /= 100;
+        *--p = PARES_DIGITOS[par + 1];
+        *--p = PARES_DIGITOS[par];
+    }
+    if (modulo >= 10)
+    {
+        *--p = PARES_DIGITOS[modulo * 2 + 1];
+        *--p = PARES_DIGITOS[modulo * 2];
+    }
+    else
+    {
+        *--p = (char)('0' + modulo);
+    }
+    if (valor < 0)
+        *--p = '-';
+    int tamanho = (int)(temporario + MAX_DIGITOS_INTEIRO - p);
+    memcpy(destino, p, tamanho);
+    return tamanho;
+}
+
+bool saida_descarregar(SAIDA *saida)
+{
+    size_t n = saida->usados;
+    if (n == 0)
+        return !saida->erro;
+    if (saida->arquivo)
+    {
+        if (fwrite(saida->buffer, 1, n, saida->arquivo) != n)
+            saida->erro = true;
+    }
+    else if (saida->fd >= 0)
+    {
+        size_t escritos = 0;
+        while (escritos < n)
+        {
+            ssize_t r = write(saida->fd, saida->buffer + escritos, n - escritos);
+            if (r < 0 && errno == EINTR)
+                continue;
+            if (r <= 0)
+            {
+                saida->erro = true;
+                break;
+            }
+            escritos += (size_t)r;
+        }
+    }
+    else if (saida->memoria && saida->total < saida->capacidade)
+    {
+        size_t cabe = saida->capacidade - saida->total;
+        memcpy(saida->memoria + saida->total, saida->buffer, n < cabe ? n : cabe);
+    }
+    saida->total += n;
+    saida->usados = 0;
+    return !saida->erro;
+}
+
+void saida_texto(SAIDA *saida, const char *texto, size_t tamanho)
+{
+    while (tamanho > 0)
+    {
+        if (saida->usados == TAMANHO_BUFFER_SAIDA)
+            saida_descarregar(saida);
+        size_t livre = TAMANHO_BUFFER_SAIDA - saida->usados;
+        size_t parte = tamanho < livre ? tamanho : livre;
+        memcpy(saida->buffer + saida->usados, texto, parte);
+        saida->usados += parte;
+        texto += parte;
+        tamanho -= parte;
+    }
+}
+
+/*
+    Escrever inteiros
+    Ideia: cada inteiro ocupa no máximo MAX_DIGITOS_INTEIRO + 1 bytes, então basta conferir o espaço uma vez por elemento
+    e formatar direto no buffer, sem passar por printf
+*/
+void saida_inteiros(SAIDA *saida, const int *valores, int n, char separador)
+{
+    for (int i = 0; i < n; i++)
+    {
+        if (TAMANHO_BUFFER_SAIDA - saida->usados < MAX_DIGITOS_INTEIRO + 1)
+            saida_descarregar(saida);
+        saida->usados += formatar_inteiro(valores[i], saida->buffer + saida->usados);
+        saida->buffer[saida->usados++] = separador;
+    }
+}
@@ -0,0 +1,44 @@
+#ifndef SAIDA_H
+#define SAIDA_H
+#include <stdio.h>
+#include <stddef.h>
+#include <stdbool.h>
+
+// Tamanho do buffer de escrita (bytes acumulados antes de cada escrita no destino)
+#define TAMANHO_BUFFER_SAIDA 65536
+// Maior quantidade de caracteres de um int em decimal ("-2147483648")
+#define MAX_DIGITOS_INTEIRO 11
+
+/*
+Saída: buffer de escrita com um de três destinos
+    - arquivo: um FILE* (stdout, por exemplo), mantendo a ordem com os printf do programa
+    - fd: um descritor, escrito com write(2)
+    - memória: um vetor do chamador com "capacidade" bytes; o que não couber é só contado
+"total" é a quantidade de bytes produzidos até agora (mesmo os que não couberam na memória)
+*/
+typedef struct Saida
+{
+    char buffer[TAMANHO_BUFFER_SAIDA];
+    size_t usados;
+    FILE *arquivo;
+    int fd;
+    char *memoria;
+    size_t capacidade;
+    size_t total;
+    bool erro;
+} SAIDA;
+
+void saida_iniciar_arquivo(SAIDA *saida, FILE *arquivo);
+void saida_iniciar_fd(SAIDA *saida, int fd);
+void saida_iniciar_memoria(SAIDA *saida, char *memoria, size_t capacidade);
+
+// Escreve o texto do inteiro em "destino" (sem '\0'), retornando a quantidade de caracteres
+int formatar_inteiro(int valor, char *destino);
+
+void saida_texto(SAIDA *saida, const char *texto, size_t tamanho);
+// Escreve os inteiros de um vetor, cada um seguido de "separador"
+void saida_inteiros(SAIDA *saida, const int *valores, int n, char separador);
+
+// Envia o que está no buffer para o destino; retorna false se alguma escrita falhou
+bool saida_descarregar(SAIDA *saida);
+#endif
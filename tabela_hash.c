@@ -0,0 +1,465 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <stdint.h>
+#include <string.h>
+#include "tabela_hash.h"
+#include "ordenacao.h"
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+/*
+Tabela Hash com endereçamento aberto
+As chaves ficam direto no vetor "chaves"; para cada posição há um byte de controle no vetor "controle":
+    - VAZIO: posição nunca usada (encerra a busca)
+    - APAGADO: posição de uma chave removida (a busca continua, mas a posição pode ser reaproveitada)
+    - 0 a 127: posição ocupada; o byte guarda 7 bits do hash da chave (a "etiqueta")
+As posições são agrupadas de TAMANHO_GRUPO em TAMANHO_GRUPO. A sondagem é linear por grupos, e dentro de um grupo
+as 16 etiquetas são comparadas com a procurada de uma só vez (SSE2); só as posições com etiqueta igual têm a chave comparada.
+*/
+#define VAZIO 0x80
+#define APAGADO 0xFE
+
+struct TabelaHash
+{
+    uint8_t *controle;
+    int *chaves;
+    int capacidade; // potência de 2, múltipla de TAMANHO_GRUPO
+    int ocupados;   // chaves presentes
+    int apagados;   // posições marcadas como APAGADO
+    float fator_carga;
+};
+
+/////// HASH E GRUPOS ///////
+/*
+    Espalhamento
+    Ideia: mistura os bits da chave (xor e multiplicações) para que chaves próximas caiam em grupos distantes.
+    Os 7 bits baixos viram a etiqueta e os demais escolhem o grupo inicial
+*/
+static uint32_t espalhar(int chave)
+{
+    uint32_t x = (uint32_t)chave;
+    x ^= x >> 16;
+    x *= 0x7feb352du;
+    x ^= x >> 15;
+    x *= 0x846ca68bu;
+    x ^= x >> 16;
+    return x;
+}
+
+/*
+    Comparação de grupo
+    Ideia: retorna uma máscara de 16 bits com as posições do grupo cujo byte de controle é igual a "valor".
+    Com SSE2, são uma comparação e um movemask; sem SSE2, um laço sobre os 16 bytes
+*/
+static unsigned int grupo_iguais(const uint8_t *controle, uint8_t valor)
+{
+#if defined(__SSE2__)
+    __m128i grupo = _mm_loadu_si128((const __m128i *)controle);
+    return (unsigned int)_mm_movemask_epi8(_mm_cmpeq_epi8(grupo, _mm_set1_epi8((char)valor)));
+#else
+    unsigned int mascara = 0;
+    for (int i = 0; i < TAMANHO_GRUPO; i++)
+    {
+        if (controle[i] == valor)
+        {
+            mascara |= 1u << i;
+        }
+    }
+    return mascara;
+#endif
+}
+
+// Posições livres (VAZIO ou APAGADO) são exatamente as que têm o bit mais alto ligado
+static unsigned int grupo_livres(const uint8_t *controle)
+{
+#if defined(__SSE2__)
+    return (unsigned int)_mm_movemask_epi8(_mm_loadu_si128((const __m128i *)controle));
+#else
+    unsigned int mascara = 0;
+    for (int i = 0; i < TAMANHO_GRUPO; i++)
+    {
+        if (controle[i] & 0x80)
+        {
+            mascara |= 1u << i;
+        }
+    }
+    return mascara;
+#endif
+}
+
+/////// CRIAÇÃO ///////
+/*
+    Capacidade para n chaves
+    Ideia: a menor potência de 2 (e de pelo menos um grupo) em que n chaves ficam abaixo do fator de carga
+*/
+static int capacidade_para(int n, float fator)
+{
+    int capacidade = TAMANHO_GRUPO;
+    while (capacidade * fator < n + 1)
+    {
+        capacidade *= 2;
+    }
+    return capacidade;
+}
+
+static bool tabela_hash_alocar(TABELA_HASH *tabela, int capacidade)
+{
+    tabela->controle = (uint8_t *)malloc(capacidade);
+    tabela->chaves = (int *)malloc(capacidade * sizeof(int));
+    if (tabela->controle == NULL || tabela->chaves == NULL)
+    {
+        free(tabela->controle);
+        free(tabela->chaves);
+        return false;
+    }
+    memset(tabela->controle, VAZIO, capacidade);
+    tabela->capacidade = capacidade;
+    tabela->ocupados = 0;
+    tabela->apagados = 0;
+    return true;
+}
+
+/*
+    Criação da tabela
+    Parâmetro: quantidade de chaves esperada
+    Ideia: já aloca posições suficientes para não precisar crescer até essa quantidade
+*/
+TABELA_HASH *tabela_hash_criar(int capacidade)
+{
+    TABELA_HASH *tabela = (TABELA_HASH *)malloc(sizeof(TABELA_HASH));
+    if (tabela == NULL)
+    {
+        return NULL;
+    }
+    tabela->fator_carga = FATOR_CARGA;
+    if (!tabela_hash_alocar(tabela, capacidade_para(capacidade, tabela->fator_carga)))
+    {
+        free(tabela);
+        return NULL;
+    }
+    return tabela;
+}
+
+bool tabela_hash_apagar(TABELA_HASH **tabela)
+{
+    if (tabela == NULL || *tabela == NULL)
+    {
+        return false;
+    }
+    free((*tabela)->controle);
+    free((*tabela)->chaves);
+    free(*tabela);
+    *tabela = NULL;
+    return true;
+}
+
+/////// BUSCA ///////
+/*
+    Busca
+    Ideia: a partir do grupo inicial, compara as etiquetas de cada grupo com a da chave; as posições com etiqueta igual têm a chave conferida.
+    Um grupo com alguma posição VAZIO encerra a busca, pois a chave teria sido colocada ali.
+    Retorna a posição da chave ou -1
+*/
+static int tabela_hash_busca(TABELA_HASH *tabela, int chave)
+{
+    uint32_t h = espalhar(chave);
+    uint8_t etiqueta = (uint8_t)(h & 0x7F);
+    int grupos = tabela->capacidade / TAMANHO_GRUPO;
+    int grupo = (int)((h >> 7) & (uint32_t)(grupos - 1));
+
+    for (int sondagem = 0; sondagem < grupos; sondagem++)
+    {
+        int base = grupo * TAMANHO_GRUPO;
+        for (unsigned int m = grupo_iguais(tabela->controle + base, etiqueta); m; m &= m - 1)
+        {
+            int pos = base + __builtin_ctz(m);
+            if (tabela->chaves[pos] == chave)
+            {
+                return pos;
+            }
+        }
+        if (grupo_iguais(tabela->controle + base, VAZIO))
+        {
+            return -1;
+        }
+        grupo = (grupo + 1) & (grupos - 1);
+    }
+    return -1;
+}
+
+bool tabela_hash_pertence(TABELA_HASH *tabela, int chave)
+{
+    return tabela != NULL && tabela_hash_busca(tabela, chave) >= 0;
+}
+
+/////// INSERÇÃO ///////
+/*
+    Colocar chave, função auxiliar da Inserção
+    Ideia: a chave (que sabidamente não está na tabela) vai para a primeira posição livre da sequência de sondagem
+*/
+static void tabela_hash_colocar(TABELA_HASH *tabela, int chave)
+{
+    uint32_t h = espalhar(chave);
+    int grupos = tabela->capacidade / TAMANHO_GRUPO;
+    int grupo = (int)((h >> 7) & (uint32_t)(grupos - 1));
+
+    while (true)
+    {
+        int base = grupo * TAMANHO_GRUPO;
+        unsigned int livres = grupo_livres(tabela->controle + base);
+        if (livres)
+        {
+            int pos = base + __builtin_ctz(livres);
+            if (tabela->controle[pos] == APAGADO)
+            {
+                tabela->apagados--;
+            }
+            tabela->controle[pos] = (uint8_t)(h & 0x7F);
+            tabela->chaves[pos] = chave;
+            tabela->ocupados++;
+            return;
+        }
+        grupo = (grupo + 1) & (grupos - 1);
+    }
+}
+
+/*
+    Redimensionar
+    Ideia: realoca os vetores e recoloca todas as chaves presentes, descartando as posições APAGADO
+*/
+static bool tabela_hash_redimensionar(TABELA_HASH *tabela, int capacidade)
+{
+    TABELA_HASH antiga = *tabela;
+    if (!tabela_hash_alocar(tabela, capacidade))
+    {
+        *tabela = antiga;
+        return false;
+    }
+    for (int i = 0; i < antiga.capacidade; i++)
+    {
+        if (antiga.controle[i] < VAZIO)
+        {
+            tabela_hash_colocar(tabela, antiga.chaves[i]);
+        }
+    }
+    free(antiga.controle);
+    free(antiga.chaves);
+    return true;
+}
+
+/*
+    Inserir
+    Ideia: se a chave não existe e as posições usadas (ocupadas + apagadas) passariam do fator de carga, a tabela é refeita:
+    com o dobro do tamanho se as chaves presentes já ocupam mais da metade do limite, ou com o mesmo tamanho se o excesso é de posições apagadas
+*/
+bool tabela_hash_inserir(TABELA_HASH *tabela, int chave)
+{
+    if (tabela == NULL || tabela_hash_busca(tabela, chave) >= 0)
+    {
+        return false;
+    }
+    if (tabela->ocupados + tabela->apagados + 1 > tabela->capacidade * tabela->fator_carga)
+    {
+        int capacidade = tabela->capacidade;
+        if (tabela->ocupados + 1 > capacidade * tabela->fator_carga / 2)
+        {
+            capacidade *= 2;
+        }
+        if (!tabela_hash_redimensionar(tabela, capacidade))
+        {
+            return false;
+        }
+    }
+    tabela_hash_colocar(tabela, chave);
+    return true;
+}
+
+/*
+    Definir fator de carga
+    Ideia: fatores menores deixam as sondagens mais curtas à custa de memória; precisa estar entre 0.1 e 0.97.
+    Se o novo fator já estiver excedido, a tabela cresce na hora
+*/
+bool tabela_hash_definir_fator_carga(TABELA_HASH *tabela, float fator)
+{
+    if (tabela == NULL || fator < 0.1f || fator > 0.97f)
+    {
+        return false;
+    }
+    tabela->fator_carga = fator;
+    int capacidade = capacidade_para(tabela->ocupados, fator);
+    if (capacidade > tabela->capacidade)
+    {
+        return tabela_hash_redimensionar(tabela, capacidade);
+    }
+    return true;
+}
+
+/*
+    Criação a partir de vetor
+    Ideia: a tabela já nasce com a capacidade final, então não há nenhum redimensionamento durante a carga
+*/
+TABELA_HASH *tabela_hash_criar_de_vetor(const int *vetor, int n)
+{
+    TABELA_HASH *tabela = tabela_hash_criar(n);
+    for (int i = 0; tabela != NULL && i < n; i++)
+    {
+        tabela_hash_inserir(tabela, vetor[i]);
+    }
+    return tabela;
+}
+
+/////// REMOÇÃO ///////
+/*
+    Remover
+    Ideia: a posição é marcada como APAGADO (e não VAZIO), para não interromper a busca de chaves que passaram por ela
+*/
+bool tabela_hash_remover(TABELA_HASH *tabela, int chave)
+{
+    if (tabela == NULL)
+    {
+        return false;
+    }
+    int pos = tabela_hash_busca(tabela, chave);
+    if (pos < 0)
+    {
+        return false;
+    }
+    tabela->controle[pos] = APAGADO;
+    tabela->ocupados--;
+    tabela->apagados++;
+    return true;
+}
+
+/*
+    Inserir e remover em lote
+    Ideia: se o lote não cabe no fator de carga atual, a tabela cresce uma única vez antes das inserções
+*/
+int tabela_hash_inserir_lote(TABELA_HASH *tabela, const int *vetor, int k)
+{
+    if (tabela == NULL)
+    {
+        return -1;
+    }
+    int capacidade = capacidade_para(tabela->ocupados + k, tabela->fator_carga);
+    if (capacidade > tabela->capacidade)
+    {
+        tabela_hash_redimensionar(tabela, capacidade);
+    }
+    int inseridos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        inseridos += tabela_hash_inserir(tabela, vetor[i]);
+    }
+    return inseridos;
+}
+
+int tabela_hash_remover_lote(TABELA_HASH *tabela, const int *vetor, int k)
+{
+    int removidos = 0;
+    for (int i = 0; i < k; i++)
+    {
+        removidos += tabela_hash_remover(tabela, vetor[i]);
+    }
+    return removidos;
+}
+
+/////// EXPORTAR ///////
+int tabela_hash_tamanho(TABELA_HASH *tabela)
+{
+    return tabela != NULL ? tabela->ocupados : 0;
+}
+
+int tabela_hash_capacidade(TABELA_HASH *tabela)
+{
+    return tabela != NULL ? tabela->capacidade : 0;
+}
+
+/*
+    Exportar
+    Parâmetros: tabela e vetor de saída (com espaço para tabela_hash_tamanho elementos)
+    Ideia: copia as chaves das posições ocupadas e as ordena (radix sort), já que a tabela não guarda ordem.
+    Retorna a quantidade de chaves
+*/
+int tabela_hash_exportar(TABELA_HASH *tabela, int *saida)
+{
+    if (tabela == NULL)
+    {
+        return 0;
+    }
+    int n = 0;
+    for (int i = 0; i < tabela->capacidade; i++)
+    {
+        if (tabela->controle[i] < VAZIO)
+        {
+            saida[n++] = tabela->chaves[i];
+        }
+    }
+    ordenar_vetor(saida, n);
+    return n;
+}
+
+/////// UNIÃO E INTERSECÇÃO ///////
+/*
+    União
+    Ideia: copia a tabela maior de uma vez (mesmos vetores, sem recalcular hash) e insere nela as chaves da menor
+*/
+TABELA_HASH *tabela_hash_uniao(TABELA_HASH *tabela1, TABELA_HASH *tabela2)
+{
+    if (tabela1 == NULL || tabela2 == NULL)
+    {
+        return NULL;
+    }
+    TABELA_HASH *maior = tabela1->ocupados >= tabela2->ocupados ? tabela1 : tabela2;
+    TABELA_HASH *menor = maior == tabela1 ? tabela2 : tabela1;
+
+    TABELA_HASH *resultado = (TABELA_HASH *)malloc(sizeof(TABELA_HASH));
+    if (resultado == NULL)
+    {
+        return NULL;
+    }
+    resultado->fator_carga = maior->fator_carga;
+    if (!tabela_hash_alocar(resultado, maior->capacidade))
+    {
+        free(resultado);
+        return NULL;
+    }
+    memcpy(resultado->controle, maior->controle, maior->capacidade);
+    memcpy(resultado->chaves, maior->chaves, maior->capacidade * sizeof(int));
+    resultado->ocupados = maior->ocupados;
+    resultado->apagados = maior->apagados;
+
+    for (int i = 0; i < menor->capacidade; i++)
+    {
+        if (menor->controle[i] < VAZIO)
+        {
+            tabela_hash_inserir(resultado, menor->chaves[i]);
+        }
+    }
+    return resultado;
+}
+
+/*
+    Intersecção
+    Ideia: cada chave da tabela menor é procurada na maior (O(1) esperado por busca), então o custo é O(menor)
+*/
+TABELA_HASH *tabela_hash_intersecao(TABELA_HASH *tabela1, TABELA_HASH *tabela2)
+{
+    if (tabela1 == NULL || tabela2 == NULL)
+    {
+        return NULL;
+    }
+    TABELA_HASH *menor = tabela1->ocupados <= tabela2->ocupados ? tabela1 : tabela2;
+    TABELA_HASH *maior = menor == tabela1 ? tabela2 : tabela1;
+
+    TABELA_HASH *resultado = tabela_hash_criar(menor->ocupados);
+    for (int i = 0; resultado != NULL && i < menor->capacidade; i++)
+    {
+        if (menor->controle[i] < VAZIO && tabela_hash_busca(maior, menor->chaves[i]) >= 0)
+        {
+            tabela_hash_colocar(resultado, menor->chaves[i]);
+        }
+    }
+    return resultado;
+}
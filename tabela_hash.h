@@ -0,0 +1,25 @@
+#ifndef TABELA_HASH_H
+#define TABELA_HASH_H
+
+// Quantidade de posições de cada grupo comparado de uma só vez (16 bytes de controle = um registrador SSE2)
+#define TAMANHO_GRUPO 16
+// Fração máxima padrão das posições ocupadas (incluindo as apagadas) antes de a tabela dobrar
+#define FATOR_CARGA 0.875f
+
+typedef struct TabelaHash TABELA_HASH;
+
+TABELA_HASH *tabela_hash_criar(int capacidade);
+TABELA_HASH *tabela_hash_criar_de_vetor(const int *vetor, int n);
+bool tabela_hash_apagar(TABELA_HASH **tabela);
+bool tabela_hash_definir_fator_carga(TABELA_HASH *tabela, float fator);
+bool tabela_hash_inserir(TABELA_HASH *tabela, int chave);
+bool tabela_hash_remover(TABELA_HASH *tabela, int chave);
+int tabela_hash_inserir_lote(TABELA_HASH *tabela, const int *vetor, int k);
+int tabela_hash_remover_lote(TABELA_HASH *tabela, const int *vetor, int k);
+bool tabela_hash_pertence(TABELA_HASH *tabela, int chave);
+int tabela_hash_tamanho(TABELA_HASH *tabela);
+int tabela_hash_capacidade(TABELA_HASH *tabela);
+int tabela_hash_exportar(TABELA_HASH *tabela, int *saida);
+TABELA_HASH *tabela_hash_uniao(TABELA_HASH *tabela1, TABELA_HASH *tabela2);
+TABELA_HASH *tabela_hash_intersecao(TABELA_HASH *tabela1, TABELA_HASH *tabela2);
+#endif
@@ -0,0 +1,250 @@
+#include <stdlib.h>
+#include <stdbool.h>
+#include <sched.h>
+#include <pthread.h>
+#include "tarefas.h"
+
+/*
+Trabalhador: uma thread do pool e a sua fila de tarefas
+A fila é uma pilha do ponto de vista do dono (empilha e desempilha na base, a tarefa mais recente e menor)
+e uma fila para as outras threads, que roubam do topo (a tarefa mais antiga, normalmente a maior subdivisão pendente)
+*/
+typedef struct Trabalhador
+{
+    pthread_mutex_t trava;
+    TAREFA *fila[CAPACIDADE_FILA_TAREFAS];
+    int topo; // próxima tarefa a ser roubada
+    int base; // próxima posição livre
+    unsigned semente;
+    pthread_t thread;
+    bool thread_criada;
+    struct PoolTarefas *pool;
+} TRABALHADOR;
+
+struct PoolTarefas
+{
+    int quantidade;
+    TRABALHADOR *trabalhadores; // o trabalhador 0 é a thread que chama tarefas_executar
+    pthread_mutex_t trava;
+    pthread_cond_t sinal;
+    bool ativo;    // há um tarefas_executar em andamento
+    bool encerrar; // as threads devem terminar
+};
+
+// Trabalhador da thread atual (NULL fora de um pool)
+static __thread TRABALHADOR *trabalhador_atual = NULL;
+
+static void executar_tarefa(TAREFA *tarefa)
+{
+    tarefa->funcao(tarefa->argumento);
+    __atomic_store_n(&tarefa->concluida, true, __ATOMIC_RELEASE);
+}
+
+/*
+    Roubar
+    Parâmetros: trabalhador vítima
+    Ideia: retira a tarefa do topo da fila da vítima; quando a fila esvazia, volta ao início do vetor
+*/
+static TAREFA *roubar(TRABALHADOR *vitima)
+{
+    TAREFA *tarefa = NULL;
+    pthread_mutex_lock(&vitima->trava);
+    if (vitima->topo < vitima->base)
+    {
+        tarefa = vitima->fila[vitima->topo++];
+        if (vitima->topo == vitima->base)
+            vitima->topo = vitima->base = 0;
+    }
+    pthread_mutex_unlock(&vitima->trava);
+    return tarefa;
+}
+
+/*
+    Roubar e executar
+    Ideia: tenta roubar de cada outro trabalhador, começando por um sorteado (para as threads ociosas não disputarem
+    sempre a mesma vítima), e executa a primeira tarefa obtida. Retorna false se todas as filas estavam vazias
+*/
+static bool roubar_e_executar(POOL_TAREFAS *pool, TRABALHADOR *eu)
+{
+    eu->semente = eu->semente * 1103515245u + 12345u;
+    int inicio = (int)((eu->semente >> 16) % (unsigned)pool->quantidade);
+    for (int i = 0; i < pool->quantidade; i++)
+    {
+        TRABALHADOR *vitima = &pool->trabalhadores[(inicio + i) % pool->quantidade];
+        if (vitima == eu)
+            continue;
+        TAREFA *tarefa = roubar(vitima);
+        if (tarefa)
+        {
+            executar_tarefa(tarefa);
+            return true;
+        }
+    }
+    return false;
+}
+
+/*
+    Laço das threads do pool
+    Ideia: enquanto há um tarefas_executar em andamento, rouba tarefas (cedendo a CPU quando não acha nenhuma);
+    fora disso, dorme na variável de condição até o próximo tarefas_executar ou o encerramento
+*/
+static void *laco_trabalhador(void *argumento)
+{
+    TRABALHADOR *eu = (TRABALHADOR *)argumento;
+    POOL_TAREFAS *pool = eu->pool;
+    trabalhador_atual = eu;
+    while (true)
+    {
+        if (!__atomic_load_n(&pool->ativo, __ATOMIC_ACQUIRE))
+        {
+            pthread_mutex_lock(&pool->trava);
+            while (!pool->ativo && !pool->encerrar)
+                pthread_cond_wait(&pool->sinal, &pool->trava);
+            bool sair = pool->encerrar;
+            pthread_mutex_unlock(&pool->trava);
+            if (sair)
+                break;
+        }
+        if (!roubar_e_executar(pool, eu))
+            sched_yield();
+    }
+    return NULL;
+}
+
+POOL_TAREFAS *tarefas_criar_pool(int threads)
+{
+    if (threads < 1)
+        threads = 1;
+    POOL_TAREFAS *pool = (POOL_TAREFAS *)malloc(sizeof(POOL_TAREFAS));
+    if (!pool)
+        return NULL;
+    pool->trabalhadores = (TRABALHADOR *)calloc(threads, sizeof(TRABALHADOR));
+    if (!pool->trabalhadores)
+    {
+        free(pool);
+        return NULL;
+    }
+    pool->quantidade = threads;
+    pool->ativo = pool->encerrar = false;
+    pthread_mutex_init(&pool->trava, NULL);
+    pthread_cond_init(&pool->sinal, NULL);
+    for (int i = 0; i < threads; i++)
+    {
+        TRABALHADOR *t = &pool->trabalhadores[i];
+        pthread_mutex_init(&t->trava, NULL);
+        t->semente = 2654435761u * (unsigned)(i + 1);
+        t->pool = pool;
+    }
+    // se alguma thread não puder ser criada, o pool só fica com menos threads roubando
+    for (int i = 1; i < threads; i++)
+    {
+        TRABALHADOR *t = &pool->trabalhadores[i];
+        t->thread_criada = pthread_create(&t->thread, NULL, laco_trabalhador, t) == 0;
+    }
+    return pool;
+}
+
+void tarefas_apagar_pool(POOL_TAREFAS **pool)
+{
+    if (!pool || !*pool)
+        return;
+    POOL_TAREFAS *p = *pool;
+    pthread_mutex_lock(&p->trava);
+    p->encerrar = true;
+    pthread_cond_broadcast(&p->sinal);
+    pthread_mutex_unlock(&p->trava);
+    for (int i = 0; i < p->quantidade; i++)
+    {
+        if (p->trabalhadores[i].thread_criada)
+            pthread_join(p->trabalhadores[i].thread, NULL);
+    }
+    for (int i = 0; i < p->quantidade; i++)
+    {
+        pthread_mutex_destroy(&p->trabalhadores[i].trava);
+    }
+    pthread_mutex_destroy(&p->trava);
+    pthread_cond_destroy(&p->sinal);
+    free(p->trabalhadores);
+    free(p);
+    *pool = NULL;
+}
+
+/*
+    Executar no pool
+    Ideia: a thread chamadora assume o papel do trabalhador 0 e acorda as demais, que passam a roubar as tarefas
+    que ela (e, recursivamente, as próprias tarefas roubadas) bifurcar. Como toda tarefa bifurcada é aguardada
+    antes de a função retornar, as filas estão vazias no fim. Não deve ser chamada de dentro de uma tarefa
+*/
+void tarefas_executar(POOL_TAREFAS *pool, void (*funcao)(void *), void *argumento)
+{
+    if (!pool)
+    {
+        funcao(argumento);
+        return;
+    }
+    TRABALHADOR *anterior = trabalhador_atual;
+    trabalhador_atual = &pool->trabalhadores[0];
+
+    pthread_mutex_lock(&pool->trava);
+    __atomic_store_n(&pool->ativo, true, __ATOMIC_RELEASE);
+    pthread_cond_broadcast(&pool->sinal);
+    pthread_mutex_unlock(&pool->trava);
+
+    funcao(argumento);
+
+    pthread_mutex_lock(&pool->trava);
+    __atomic_store_n(&pool->ativo, false, __ATOMIC_RELEASE);
+    pthread_mutex_unlock(&pool->trava);
+    trabalhador_atual = anterior;
+}
+
+void tarefas_bifurcar(TAREFA *tarefa)
+{
+    TRABALHADOR *eu = trabalhador_atual;
+    tarefa->concluida = false;
+    if (eu)
+    {
+        pthread_mutex_lock(&eu->trava);
+        if (eu->base < CAPACIDADE_FILA_TAREFAS)
+        {
+            eu->fila[eu->base++] = tarefa;
+            pthread_mutex_unlock(&eu->trava);
+            return;
+        }
+        pthread_mutex_unlock(&eu->trava);
+    }
+    executar_tarefa(tarefa);
+}
+
+/*
+    Aguardar
+    Ideia: no modelo bifurcação-junção, quando a tarefa é aguardada ela ou está na base da fila da própria thread
+    (ninguém a roubou: é desempilhada e executada aqui mesmo) ou já foi roubada. Nesse caso, em vez de ficar parada,
+    a thread rouba e executa outras tarefas até a roubada terminar
+*/
+void tarefas_aguardar(TAREFA *tarefa)
+{
+    TRABALHADOR *eu = trabalhador_atual;
+    if (eu)
+    {
+        bool minha = false;
+        pthread_mutex_lock(&eu->trava);
+        if (eu->base > eu->topo && eu->fila[eu->base - 1] == tarefa)
+        {
+            minha = true;
+            if (--eu->base == eu->topo)
+                eu->topo = eu->base = 0;
+        }
+        pthread_mutex_unlock(&eu->trava);
+        if (minha)
+        {
+            executar_tarefa(tarefa);
+            return;
+        }
+    }
+    while (!__atomic_load_n(&tarefa->concluida, __ATOMIC_ACQUIRE))
+    {
+        if (!eu || !roubar_e_executar(eu->pool, eu))
+            sched_yield();
+    }
+}
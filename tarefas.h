@@ -0,0 +1,35 @@
+#ifndef TAREFAS_H
+#define TAREFAS_H
+#include <stdbool.h>
+
+// Quantidade máxima de tarefas pendentes na fila de cada thread (acima disso, a tarefa roda na hora)
+#define CAPACIDADE_FILA_TAREFAS 256
+
+/*
+Tarefa: função a ser executada por alguma thread do pool, com seu argumento
+"concluida" é escrita por quem executar a tarefa e lida por quem aguarda por ela
+*/
+typedef struct Tarefa
+{
+    void (*funcao)(void *argumento);
+    void *argumento;
+    bool concluida;
+} TAREFA;
+
+typedef struct PoolTarefas POOL_TAREFAS;
+
+// Cria um pool com "threads" threads (a que chama tarefas_executar é uma delas)
+POOL_TAREFAS *tarefas_criar_pool(int threads);
+
+// Encerra as threads e apaga o pool
+void tarefas_apagar_pool(POOL_TAREFAS **pool);
+
+// Executa funcao(argumento) na thread chamadora, com as demais threads do pool roubando as tarefas bifurcadas por ela
+void tarefas_executar(POOL_TAREFAS *pool, void (*funcao)(void *), void *argumento);
+
+// Deixa a tarefa disponível para outra thread (fora de um pool, executa-a na hora)
+void tarefas_bifurcar(TAREFA *tarefa);
+
+// Espera a tarefa terminar, executando-a se ninguém a roubou ou ajudando com outras tarefas enquanto isso
+void tarefas_aguardar(TAREFA *tarefa);
+#endif